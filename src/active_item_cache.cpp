@@ -1,64 +1,153 @@
 #include "active_item_cache.h"
 
+#include "calendar.h"
+
 #include <algorithm>
 
-void active_item_cache::remove( std::list<item>::iterator it, point location )
+constexpr int active_item_cache::WHEEL_BITS;
+constexpr int active_item_cache::WHEEL_SIZE;
+constexpr int active_item_cache::CONTINUOUS;
+
+std::list<item_reference> &active_item_cache::slot_for( int due )
+{
+    if( due <= wheel_turn ) {
+        return pending;
+    }
+    const int block = due >> WHEEL_BITS;
+    const int current_block = wheel_turn >> WHEEL_BITS;
+    if( block == current_block ) {
+        return wheel[due & ( WHEEL_SIZE - 1 )];
+    }
+    if( block - current_block < WHEEL_SIZE ) {
+        return wheel[WHEEL_SIZE + ( block & ( WHEEL_SIZE - 1 ) )];
+    }
+    return wheel.back();
+}
+
+void active_item_cache::remove( std::list<item>::iterator it, point )
 {
+    const auto found = due_turns.find( &*it );
+    if( found == due_turns.end() ) {
+        return;
+    }
     const auto predicate = [&]( const item_reference & active_item ) {
-        return location == active_item.location && active_item.item_iterator == it;
+        return active_item.item_iterator == it;
     };
-    // The iterator is expected to be in this list, as it was added that way in `add`.
-    // But the processing_speed may have changed, so if it's not in the expected container,
-    // remove it from all containers to ensure no stale iterator remains.
-    auto &expected = active_items[it->processing_speed()];
+    // The item is expected to be in the list matching its wake-up turn, but check
+    // everywhere if it's not, to ensure no stale iterator remains.
+    auto &expected = found->second == CONTINUOUS ? continuous : slot_for( found->second );
     const auto iter = std::find_if( expected.begin(), expected.end(), predicate );
     if( iter != expected.end() ) {
         expected.erase( iter );
     } else {
-        for( auto &e : active_items ) {
-            e.second.remove_if( predicate );
+        continuous.remove_if( predicate );
+        pending.remove_if( predicate );
+        for( auto &slot : wheel ) {
+            slot.remove_if( predicate );
         }
     }
-    active_item_set.erase( &*it );
+    due_turns.erase( found );
 }
 
 void active_item_cache::add( std::list<item>::iterator it, point location )
 {
-    active_items[it->processing_speed()].push_back( item_reference{ location, it, &*it } );
-    active_item_set.insert( &*it );
+    if( due_turns.count( &*it ) != 0 ) {
+        remove( it, location );
+    }
+    const item_reference ref{ location, it, &*it };
+    if( it->needs_continuous_processing() ) {
+        continuous.push_back( ref );
+        due_turns[&*it] = CONTINUOUS;
+        return;
+    }
+
+    const int now = calendar::turn;
+    if( wheel.empty() ) {
+        wheel.resize( 2 * WHEEL_SIZE + 1 );
+        wheel_turn = now;
+    }
+    // The phase spreads the items over the period, so items added on the same turn don't
+    // all wake up together. It doesn't change while the item stays in place, which makes
+    // an item that is added again after being processed wake up exactly speed turns later.
+    const int speed = it->processing_speed();
+    const int phase = location.x * 31 + location.y * 17 + it->bday;
+    const int due = std::max( now + 1 + ( ( phase - now - 1 ) % speed + speed ) % speed,
+                              wheel_turn + 1 );
+    slot_for( due ).push_back( ref );
+    due_turns[&*it] = due;
 }
 
 bool active_item_cache::has( std::list<item>::iterator it, point ) const
 {
-    return active_item_set.count( &*it ) != 0;
+    return due_turns.count( &*it ) != 0;
 }
 
 bool active_item_cache::has( item_reference const &itm ) const
 {
-    return active_item_set.count( itm.item_id ) != 0;
+    return due_turns.count( itm.item_id ) != 0;
 }
 
 bool active_item_cache::empty() const
 {
-    return active_items.empty();
+    return due_turns.empty();
 }
 
-// get() only returns the first size() / processing_speed() elements of each list, rounded up.
-// It relies on the processing logic to remove and reinsert the items to they
-// move to the back of their respective lists (or to new lists).
-// Otherwise only the first n items will ever be processed.
-std::list<item_reference> active_item_cache::get()
+void active_item_cache::advance( arena_vector<item_reference> &items_to_process )
 {
-    std::list<item_reference> items_to_process;
-    for( auto &tuple : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = tuple.second.size() / tuple.first;
-        for( auto &an_iter : tuple.second ) {
-            items_to_process.push_back( an_iter );
-            if( --num_to_process < 0 ) {
-                break;
+    wheel_turn++;
+    if( ( wheel_turn & ( WHEEL_SIZE - 1 ) ) == 0 ) {
+        // A new block starts: spread its second level slot over the first level and
+        // move whatever comes into reach from the overflow list to the second level.
+        std::list<item_reference> cascade;
+        cascade.swap( wheel[WHEEL_SIZE + ( ( wheel_turn >> WHEEL_BITS ) & ( WHEEL_SIZE - 1 ) )] );
+        cascade.splice( cascade.end(), wheel.back() );
+        while( !cascade.empty() ) {
+            const auto due = due_turns.find( cascade.front().item_id );
+            if( due == due_turns.end() ) {
+                cascade.pop_front();
+                continue;
             }
+            auto &dest = slot_for( due->second );
+            dest.splice( dest.end(), cascade, cascade.begin() );
+        }
+    }
+    auto &due_now = wheel[wheel_turn & ( WHEEL_SIZE - 1 )];
+    items_to_process.insert( items_to_process.end(), due_now.begin(), due_now.end() );
+    pending.splice( pending.end(), due_now );
+}
+
+arena_vector<item_reference> active_item_cache::get( int turn )
+{
+    arena_vector<item_reference> items_to_process( continuous.begin(), continuous.end() );
+    items_to_process.insert( items_to_process.end(), pending.begin(), pending.end() );
+    if( wheel.empty() || turn <= wheel_turn ) {
+        return items_to_process;
+    }
+
+    if( turn - wheel_turn <= WHEEL_SIZE * WHEEL_SIZE ) {
+        while( wheel_turn < turn ) {
+            advance( items_to_process );
+        }
+        return items_to_process;
+    }
+    // Not processed for a long time (the submap was outside of the reality bubble),
+    // stepping through every turn would take longer than sorting all items again.
+    std::list<item_reference> all;
+    for( auto &slot : wheel ) {
+        all.splice( all.end(), slot );
+    }
+    wheel_turn = turn;
+    while( !all.empty() ) {
+        const auto due = due_turns.find( all.front().item_id );
+        if( due == due_turns.end() ) {
+            all.pop_front();
+            continue;
+        }
+        auto &dest = slot_for( due->second );
+        if( &dest == &pending ) {
+            items_to_process.push_back( all.front() );
         }
+        dest.splice( dest.end(), all, all.begin() );
     }
     return items_to_process;
 }
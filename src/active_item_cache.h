@@ -3,24 +3,58 @@
 
 #include "enums.h"
 #include "item.h"
+#include "turn_arena.h"
 #include <list>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 // A struct used to uniquely identify an item within a submap or vehicle.
 struct item_reference {
     point location;
     std::list<item>::iterator item_iterator;
-    // Do not access this from outside this module, it is only used as an ID for active_item_set.
+    // Do not access this from outside this module, it is only used as an ID for due_turns.
     item *item_id;
 };
 
+/**
+ * Keeps track of the items of a submap or vehicle that need processing.
+ *
+ * Items that need continuous processing are returned every turn. All others are
+ * scheduled for their next wake-up turn in a two level timing wheel: the first
+ * level has a slot for each turn of the current block of @ref WHEEL_SIZE turns, the
+ * second level a slot for each of the following blocks. Items scheduled even further
+ * ahead wait in an overflow list. Slots of the second level are moved into the first
+ * one when their block starts, so every item is touched only a few times between
+ * being scheduled and being due.
+ */
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
-        // Cache for fast lookup when we're iterating over the active items to verify the item is present.
-        std::unordered_set<item *> active_item_set;
+        static constexpr int WHEEL_BITS = 6;
+        static constexpr int WHEEL_SIZE = 1 << WHEEL_BITS;
+        /** Marks continuously processed items in @ref due_turns */
+        static constexpr int CONTINUOUS = -1;
+
+        std::list<item_reference> continuous;
+        /**
+         * Slots of the first level, then of the second level and finally the overflow list.
+         * Empty until the first scheduled item is added.
+         */
+        std::vector<std::list<item_reference>> wheel;
+        /**
+         * Items that were due and have been returned by @ref get, but have not been
+         * removed (processed) yet. They are returned again until they are.
+         */
+        std::list<item_reference> pending;
+        /** The last turn @ref get moved due items into @ref pending for */
+        int wheel_turn = 0;
+        /** Wake-up turn (or @ref CONTINUOUS) of every item in the cache */
+        std::unordered_map<item *, int> due_turns;
+
+        /** The list the item that is due at the given turn belongs into */
+        std::list<item_reference> &slot_for( int due );
+        /** Moves the items that are due at the given turn (the one after @ref wheel_turn) to @ref pending */
+        void advance( arena_vector<item_reference> &items_to_process );
 
     public:
         void remove( std::list<item>::iterator it, point location );
@@ -29,7 +63,11 @@ class active_item_cache
         // Use this one if there's a chance that the item being referenced has been invalidated.
         bool has( item_reference const &itm ) const;
         bool empty() const;
-        std::list<item_reference> get();
+        /**
+         * The items that should be processed on the given turn. The items are expected to
+         * be removed and added again when processed, that schedules their next wake-up.
+         */
+        arena_vector<item_reference> get( int turn );
 };
 
 #endif
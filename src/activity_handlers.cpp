@@ -1409,7 +1409,7 @@ void activity_handlers::start_engines_finish( player_activity *act, player *p )
     int not_muscle = 0;
     const bool take_control = act->values[0];
 
-    for( size_t e = 0; e < veh->engines.size(); ++e ) {
+    for( size_t e = 0; e < veh->parts_with_flag( VPFLAG_ENGINE ).size(); ++e ) {
         if( veh->is_engine_on( e ) ) {
             attempted++;
             if( veh->start_engine( e ) ) { started++; }
@@ -0,0 +1,293 @@
+#include "game.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+
+#include "debug.h"
+#include "explosion.h"
+#include "field.h"
+#include "line.h"
+#include "map.h"
+#include "monster.h"
+#include "mtype.h"
+#include "npc.h"
+#include "player.h"
+#include "profiler.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "sounds.h"
+#include "turn_arena.h"
+#include "vehicle.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+/** What to spawn around the player before the timed turns start */
+struct benchmark_scenario {
+    int monsters;
+    int npcs;
+    int fires;
+    int vehicles;
+    /** Blasts set off every turn */
+    int explosions;
+};
+
+const std::map<std::string, benchmark_scenario> benchmark_scenarios = {
+    { "idle",       {   0,  0,   0,  0, 0 } },
+    { "horde",      { 200,  0,   0,  0, 0 } },
+    { "npcs",       {   0, 20,   0,  0, 0 } },
+    { "fire",       {   0,  0, 100,  0, 0 } },
+    { "vehicles",   {   0,  0,   0, 20, 0 } },
+    { "explosions", {   0,  0,   0,  0, 2 } },
+    { "mixed",      { 100, 10,  50, 10, 0 } }
+};
+
+/** Accumulated wall clock time of one phase of the turn */
+class benchmark_phase
+{
+    public:
+        benchmark_phase( const char *name ) : name( name ) {}
+
+        template<typename F>
+        void run( F func ) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            const auto end = std::chrono::steady_clock::now();
+            const double us = std::chrono::duration<double, std::micro>( end - start ).count();
+            total_us += us;
+            max_us = std::max( max_us, us );
+        }
+
+        const char *name;
+        double total_us = 0.0;
+        double max_us = 0.0;
+};
+
+/** Random tile in the reality bubble at the players z-level that a monster could stand on */
+bool random_spawn_point( const tripoint &center, int min_dist, tripoint &p )
+{
+    const int max_coord = SEEX * MAPSIZE - 1;
+    for( int attempt = 0; attempt < 100; attempt++ ) {
+        p = tripoint( rng( 0, max_coord ), rng( 0, max_coord ), center.z );
+        if( rl_dist( p, center ) >= min_dist && g->m.passable( p ) && g->is_empty( p ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool game::run_benchmark( const std::string &scenario, int turns, const std::string &world,
+                          const std::vector<std::string> &opts )
+{
+    const auto preset = benchmark_scenarios.find( scenario );
+    if( preset == benchmark_scenarios.end() ) {
+        std::cerr << "Unknown benchmark scenario: " << scenario << std::endl;
+        return false;
+    }
+    benchmark_scenario spawns = preset->second;
+    std::string mon_type = "mon_zombie";
+    int vehicle_speed = 0;
+    explosion_data blast;
+    blast.power = 450; // A mininuke
+
+    for( const auto &opt : opts ) {
+        const size_t sep = opt.find( '=' );
+        if( sep == std::string::npos ) {
+            std::cerr << "Benchmark options must be of the form key=value: " << opt << std::endl;
+            return false;
+        }
+        const std::string key = opt.substr( 0, sep );
+        const std::string val = opt.substr( sep + 1 );
+        if( key == "monsters" ) {
+            spawns.monsters = std::stoi( val );
+        } else if( key == "npcs" ) {
+            spawns.npcs = std::stoi( val );
+        } else if( key == "fires" ) {
+            spawns.fires = std::stoi( val );
+        } else if( key == "vehicles" ) {
+            spawns.vehicles = std::stoi( val );
+        } else if( key == "monster" ) {
+            mon_type = val;
+        } else if( key == "vehicle_speed" ) {
+            vehicle_speed = std::stoi( val );
+        } else if( key == "explosions" ) {
+            spawns.explosions = std::stoi( val );
+        } else if( key == "explosion_power" ) {
+            blast.power = std::stof( val );
+        } else {
+            std::cerr << "Unknown benchmark option: " << key << std::endl;
+            return false;
+        }
+    }
+
+    if( !world.empty() ) {
+        if( !load( world ) ) {
+            return false;
+        }
+    } else {
+        try {
+            world_generator->set_active_world( nullptr );
+            world_generator->get_all_worlds();
+            WORLDPTR bench_world = world_generator->make_new_world( std::vector<std::string> { "dda" } );
+            if( bench_world == nullptr ) {
+                std::cerr << "Unable to create benchmark world" << std::endl;
+                return false;
+            }
+            world_generator->set_active_world( bench_world );
+            setup();
+            if( !u.create( PLTYPE_NOW ) || !start_game( bench_world->world_name ) ) {
+                std::cerr << "Unable to start benchmark game" << std::endl;
+                return false;
+            }
+        } catch( const std::exception &err ) {
+            std::cerr << "Error setting up benchmark: " << err.what() << std::endl;
+            return false;
+        }
+    }
+
+    const mtype_id mon_id( mon_type );
+    if( !mon_id.is_valid() ) {
+        std::cerr << "Unknown monster type: " << mon_type << std::endl;
+        return false;
+    }
+
+    tripoint p;
+    for( int i = 0; i < spawns.monsters; i++ ) {
+        if( random_spawn_point( u.pos(), 5, p ) ) {
+            monster critter( mon_id, p );
+            add_zombie( critter );
+        }
+    }
+    for( int i = 0; i < spawns.npcs; i++ ) {
+        if( random_spawn_point( u.pos(), 3, p ) ) {
+            npc *tmp = new npc();
+            tmp->normalize();
+            tmp->randomize();
+            tmp->spawn_at( get_levx(), get_levy(), get_levz() );
+            tmp->setpos( p );
+            tmp->form_opinion( u );
+            tmp->mission = NPC_MISSION_NULL;
+        }
+    }
+    load_npcs();
+    for( int i = 0; i < spawns.fires; i++ ) {
+        if( random_spawn_point( u.pos(), 5, p ) ) {
+            m.spawn_item( p, "2x4", 4 );
+            m.add_field( p, fd_fire, 3, 0 );
+        }
+    }
+    for( int i = 0; i < spawns.vehicles; i++ ) {
+        if( random_spawn_point( u.pos(), 10, p ) ) {
+            vehicle *veh = m.add_vehicle( vproto_id( "car" ), p, 90 * rng( 0, 3 ), 100, 0 );
+            if( veh != nullptr && vehicle_speed > 0 ) {
+                veh->engine_on = true;
+                veh->velocity = vehicle_speed;
+                veh->cruise_velocity = vehicle_speed;
+            }
+        }
+    }
+
+    // Blasts are kept out of reach of the player, who would not survive many turns otherwise.
+    const int blast_min_dist = blast.expected_range( 1.0f / std::max( blast.power, 1.0f ) ) + 2;
+
+    std::vector<benchmark_phase> phases = {
+        "scent", "vehmove", "process_fields", "process_active_items", "process_sounds",
+        "build_map_cache", "monmove", "npcmove", "player", "lightmap", "explosions"
+    };
+    enum {
+        PH_SCENT, PH_VEHMOVE, PH_FIELDS, PH_ITEMS, PH_SOUNDS,
+        PH_MAP_CACHE, PH_MONMOVE, PH_NPCMOVE, PH_PLAYER, PH_LIGHTMAP, PH_EXPLOSIONS
+    };
+
+    printf( "Benchmark scenario '%s': %d turns, %d monsters, %d npcs, %d fires, %d vehicles, "
+            "%d explosions per turn\n", scenario.c_str(), turns, static_cast<int>( num_zombies() ),
+            static_cast<int>( active_npc.size() ), spawns.fires, spawns.vehicles, spawns.explosions );
+
+    profiler::reset();
+    profiler::enabled = true;
+
+    const auto bench_start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < turns && !u.is_dead_state(); turn++ ) {
+        calendar::turn.increment();
+        process_events();
+        u.update_body();
+        update_weather();
+        reset_light_level();
+
+        // Player input is stubbed as waiting out the turn.
+        if( u.moves > 0 ) {
+            u.pause();
+        }
+
+        phases[PH_EXPLOSIONS].run( [&]() {
+            tripoint center;
+            for( int i = 0; i < spawns.explosions; i++ ) {
+                if( random_spawn_point( u.pos(), blast_min_dist, center ) ) {
+                    explosion( center, blast );
+                }
+            }
+        } );
+        phases[PH_SCENT].run( [this]() {
+            scent.set( u.pos(), u.scent );
+            scent.update( u.pos(), m );
+        } );
+        m.build_floor_caches();
+        m.process_falling();
+        phases[PH_VEHMOVE].run( [this]() {
+            m.vehmove();
+        } );
+        phases[PH_FIELDS].run( [this]() {
+            m.process_fields();
+        } );
+        phases[PH_ITEMS].run( [this]() {
+            m.process_active_items();
+        } );
+        m.creature_in_field( u );
+        phases[PH_SOUNDS].run( []() {
+            sounds::process_sounds();
+        } );
+        phases[PH_MAP_CACHE].run( [this]() {
+            m.build_map_cache( get_levz(), true );
+        } );
+        phases[PH_MONMOVE].run( [this]() {
+            monmove();
+        } );
+        phases[PH_NPCMOVE].run( [this]() {
+            npcmove();
+        } );
+        update_stair_monsters();
+        phases[PH_PLAYER].run( [this]() {
+            u.process_turn();
+            u.process_active_items();
+            u.update_bodytemp();
+        } );
+        // The lightmap is rebuilt when drawing, which is skipped in headless mode.
+        phases[PH_LIGHTMAP].run( [this]() {
+            m.build_map_cache( get_levz() );
+        } );
+        sounds::reset_markers();
+        profiler::end_turn();
+        turn_arena::end_turn();
+    }
+    const auto bench_end = std::chrono::steady_clock::now();
+    const double total_ms = std::chrono::duration<double, std::milli>( bench_end - bench_start ).count();
+
+    printf( "%-22s %12s %14s %12s\n", "Phase", "Total (ms)", "Mean (us/turn)", "Max (us)" );
+    for( const auto &ph : phases ) {
+        printf( "%-22s %12.2f %14.1f %12.1f\n", ph.name, ph.total_us / 1000.0,
+                turns > 0 ? ph.total_us / turns : 0.0, ph.max_us );
+    }
+    printf( "%-22s %12.2f %14.1f\n\n", "(all)", total_ms, turns > 0 ? total_ms * 1000.0 / turns : 0.0 );
+    printf( "%s", profiler::summary().c_str() );
+
+    if( world.empty() ) {
+        delete_world( world_generator->active_world->world_name, true );
+    }
+    return true;
+}
@@ -31,6 +31,7 @@
 #include "cata_utility.h"
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <stdlib.h>     /* srand, rand */
 #include <sstream>
@@ -51,6 +52,9 @@ static minimap_shared_texture_pool tex_pool;
 SDL_Color cursesColorToSDL(int color);
 
 static const std::string empty_string;
+static const std::string season_suffix[4] = {
+    "_season_spring", "_season_summer", "_season_autumn", "_season_winter"
+};
 static const std::string TILE_CATEGORY_IDS[] = {
     "", // C_NONE,
     "vehicle_part", // C_VEHICLE_PART,
@@ -123,6 +127,7 @@ void cata_tiles::clear()
     night_tile_values.clear();
     overexposed_tile_values.clear();
     tile_ids.clear();
+    clear_tile_cache();
     // release minimap
     minimap_cache.clear();
     tex_pool.texture_pool.clear();
@@ -448,6 +453,7 @@ void cata_tiles::load_tilejson(std::string tileset_root, std::string json_conf,
     }
 
     load_tilejson_from_file(tileset_root, config_file, img_path);
+    clear_tile_cache();
     if (tile_ids.count("unknown") == 0) {
         dbg( D_ERROR ) << "The tileset you're using has no 'unknown' tile defined!";
     }
@@ -477,6 +483,9 @@ void cata_tiles::load_tilejson_from_file(const std::string &tileset_dir, std::if
         default_tile_width = tile_width;
         default_tile_height = tile_height;
     }
+    // Static layers can be cached as long as the sprites of a tile stay inside of it,
+    // rotated ones included
+    static_chunks_usable = tile_width == tile_height;
 
     // Load tile information if available.
     int offset = 0;
@@ -505,6 +514,10 @@ void cata_tiles::load_tilejson_from_file(const std::string &tileset_dir, std::if
             // Now load the tile definitions for the loaded tileset image.
             int sprite_offset_x = tile_part_def.get_int("sprite_offset_x",0);
             int sprite_offset_y = tile_part_def.get_int("sprite_offset_y",0);
+            if( sprite_width != tile_width || sprite_height != tile_height ||
+                sprite_offset_x != 0 || sprite_offset_y != 0 ) {
+                static_chunks_usable = false;
+            }
             load_tilejson_from_file(tile_part_def, offset, newsize, sprite_offset_x, sprite_offset_y);
             if (tile_part_def.has_member("ascii")) {
                 load_ascii_tilejson_from_file(tile_part_def, offset, newsize, sprite_offset_x, sprite_offset_y);
@@ -542,6 +555,9 @@ void cata_tiles::load_tilejson_from_file(const std::string &tileset_dir, std::if
             dbg( D_ERROR ) << "tile " << it->first << " has no (valid) foreground nor background";
             tile_ids.erase( it++ );
         } else {
+            if( td.height_3d != 0 || td.offset.x != 0 || td.offset.y != 0 ) {
+                static_chunks_usable = false;
+            }
             ++it;
         }
     }
@@ -856,16 +872,7 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
     if (!g) {
         return;
     }
-
-    {
-        //set clipping to prevent drawing over stuff we shouldn't
-        SDL_Rect clipRect = {destx, desty, width, height};
-        SDL_RenderSetClipRect(renderer, &clipRect);
-
-        //fill render area with black to prevent artifacts where no new pixels are drawn
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderFillRect(renderer, &clipRect);
-    }
+    const auto frame_start = std::chrono::steady_clock::now();
 
     int posx = center.x;
     int posy = center.y;
@@ -874,6 +881,10 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
     get_window_tile_counts(width, height, sx, sy);
 
     init_light();
+    if( calendar::turn.get_season() != tile_cache_season ) {
+        clear_tile_cache();
+        tile_cache_season = calendar::turn.get_season();
+    }
     g->m.update_visibility_cache( center.z );
     const visibility_variables &cache = g->m.get_visibility_variables_cache();
 
@@ -915,6 +926,29 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
     auto vision_cache = g->u.get_vision_modes();
     nv_goggles_activated = vision_cache[NV_GOGGLES];
 
+    // Terrain and furniture come from textures that are only redrawn when they changed
+    bool use_static_chunks = static_chunks_usable && !iso_mode;
+    if( use_static_chunks ) {
+        update_static_chunks( center.z, point( min_visible_x, min_visible_y ),
+                              point( max_visible_x, max_visible_y ), cache );
+        // Falls back to drawing everything if the textures could not be created
+        use_static_chunks = static_chunks_usable;
+    }
+
+    {
+        //set clipping to prevent drawing over stuff we shouldn't
+        SDL_Rect clipRect = {destx, desty, width, height};
+        SDL_RenderSetClipRect(renderer, &clipRect);
+
+        //fill render area with black to prevent artifacts where no new pixels are drawn
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderFillRect(renderer, &clipRect);
+    }
+
+    if( use_static_chunks ) {
+        draw_static_chunks( center.z );
+    }
+
     for( int row = min_row; row < max_row; row ++) {
         std::vector<tile_render_info> draw_points;
         draw_points.reserve(max_col);
@@ -943,7 +977,8 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
                 continue;
             }
 
-            if( apply_vision_effects( temp, g->m.get_visibility( ch.visibility_cache[x][y], cache ) ) ) {
+            const visibility_type visibility = g->m.get_visibility( ch.visibility_cache[x][y], cache );
+            if( use_static_chunks ? visibility != VIS_CLEAR : apply_vision_effects( temp, visibility ) ) {
                 const auto critter = g->critter_at( tripoint(x,y,center.z), true );
                 if( critter != nullptr && g->u.sees_with_infrared( *critter ) ) {
                     //TODO defer drawing this until later when we know how tall
@@ -957,7 +992,12 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
 
             // light level is now used for choosing between grayscale filter and normal lit tiles.
             // Draw Terrain if possible. If not possible then we need to continue on to the next part of loop
-            if( !draw_terrain( tripoint(x,y,center.z), ch.visibility_cache[x][y], height_3d ) ) {
+            if( use_static_chunks ) {
+                // Terrain and furniture are already on screen, the other layers go on top
+                if( g->m.ter( temp ) == t_null ) {
+                    continue;
+                }
+            } else if( !draw_terrain( tripoint(x,y,center.z), ch.visibility_cache[x][y], height_3d ) ) {
                 continue;
             }
 
@@ -970,6 +1010,9 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
                         &cata_tiles::draw_critter_at };
         // for each of the drawing layers in order, back to front ...
         for( auto f : drawing_layers ) {
+            if( use_static_chunks && f == &cata_tiles::draw_furniture ) {
+                continue;
+            }
             // ... draw all the points we drew terrain for, in the same order
             for( auto &p : draw_points ) {
                 (this->*f)( p.pos, ch.visibility_cache[p.pos.x][p.pos.y], p.height_3d );
@@ -1030,6 +1073,10 @@ void cata_tiles::draw( int destx, int desty, const tripoint &center, int width,
     }
 
     SDL_RenderSetClipRect(renderer, NULL);
+
+    const std::chrono::duration<float, std::milli> frame_time = std::chrono::steady_clock::now() -
+            frame_start;
+    frame_time_ms = frame_time_ms * 0.9f + frame_time.count() * 0.1f;
 }
 
 void cata_tiles::draw_rhombus(int destx, int desty, int size, SDL_Color color, int widthLimit, int heightLimit) {
@@ -1448,11 +1495,6 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
         return false;
     }
 
-
-    constexpr size_t suffix_len = 15;
-    constexpr char season_suffix[4][suffix_len] = {
-        "_season_spring", "_season_summer", "_season_autumn", "_season_winter"};
-
     std::string seasonal_id = id + season_suffix[calendar::turn.get_season()];
 
     auto it = tile_ids.find(seasonal_id);
@@ -1599,6 +1641,14 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
         }
     }
 
+    return draw_tile_type( display_tile, id, category, pos, rota, ll, apply_night_vision_goggles,
+                           height_3d );
+}
+
+bool cata_tiles::draw_tile_type( const tile_type &display_tile, const std::string &id,
+                                 TILE_CATEGORY category, tripoint pos, int rota, lit_level ll,
+                                 bool apply_night_vision_goggles, int &height_3d )
+{
     // make sure we aren't going to rotate the tile if it shouldn't be rotated
     if (!display_tile.rotates) {
         rota = 0;
@@ -1695,6 +1745,84 @@ bool cata_tiles::draw_from_id_string(std::string id, TILE_CATEGORY category,
     return true;
 }
 
+void cata_tiles::clear_tile_cache()
+{
+    for( auto &category : tile_cache ) {
+        category.clear();
+    }
+    static_chunks.clear();
+}
+
+const tile_type *cata_tiles::find_seasonal_tile( std::string &id ) const
+{
+    const std::string seasonal_id = id + season_suffix[calendar::turn.get_season()];
+    auto it = tile_ids.find( seasonal_id );
+    if( it != tile_ids.end() ) {
+        id = seasonal_id;
+        return &it->second;
+    }
+    it = tile_ids.find( id );
+    return it != tile_ids.end() ? &it->second : nullptr;
+}
+
+void cata_tiles::resolve_cached_tile( cached_tile &cached, const std::string &id )
+{
+    cached.resolved = true;
+    cached.id = id;
+    cached.tile = find_seasonal_tile( cached.id );
+    cached.subtiles.fill( nullptr );
+    if( cached.tile == nullptr || !cached.tile->multitile ) {
+        return;
+    }
+    const auto &available = cached.tile->available_subtiles;
+    for( size_t i = 0; i < cached.subtiles.size(); i++ ) {
+        if( std::find( available.begin(), available.end(), multitile_keys[i] ) == available.end() ) {
+            continue;
+        }
+        cached.subtile_ids[i] = cached.id + "_" + multitile_keys[i];
+        cached.subtiles[i] = find_seasonal_tile( cached.subtile_ids[i] );
+    }
+}
+
+template<typename IdFunc>
+bool cata_tiles::draw_from_cached_id( TILE_CATEGORY category, size_t index, IdFunc get_id,
+                                      const std::string &subcategory, tripoint pos, int subtile,
+                                      int rota, lit_level ll, bool apply_night_vision_goggles,
+                                      int &height_3d )
+{
+    if( !( tile_iso && use_tiles ) &&
+        ( pos.x - o_x < 0 || pos.x - o_x >= screentile_width ||
+          pos.y - o_y < 0 || pos.y - o_y >= screentile_height ) ) {
+        return false;
+    }
+
+    std::vector<cached_tile> &cache = tile_cache[category];
+    if( index >= cache.size() ) {
+        cache.resize( index + 1 );
+    }
+    cached_tile &cached = cache[index];
+    if( !cached.resolved ) {
+        resolve_cached_tile( cached, get_id() );
+    }
+    if( cached.tile == nullptr ) {
+        // The fallbacks depend on more than the id
+        return draw_from_id_string( cached.id, category, subcategory, pos, subtile, rota, ll,
+                                    apply_night_vision_goggles, height_3d );
+    }
+
+    if( subtile != -1 && !cached.subtile_ids[subtile].empty() ) {
+        // Subtiles are drawn as if their id was given without a category
+        if( cached.subtiles[subtile] == nullptr ) {
+            return draw_from_id_string( cached.subtile_ids[subtile], pos, -1, rota, ll,
+                                        apply_night_vision_goggles, height_3d );
+        }
+        return draw_tile_type( *cached.subtiles[subtile], cached.subtile_ids[subtile], C_NONE, pos,
+                               rota, ll, apply_night_vision_goggles, height_3d );
+    }
+    return draw_tile_type( *cached.tile, cached.id, category, pos, rota, ll,
+                           apply_night_vision_goggles, height_3d );
+}
+
 bool cata_tiles::draw_sprite_at( const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
                                  int x, int y, unsigned int loc_rand, int rota_fg, int rota, lit_level ll,
                                  bool apply_night_vision_goggles )
@@ -1913,17 +2041,148 @@ bool cata_tiles::draw_terrain_below( const tripoint &p, lit_level /*ll*/, int &/
     return true;
 }
 
-bool cata_tiles::draw_terrain( const tripoint &p, lit_level ll, int &height_3d )
+static_tile_key cata_tiles::get_static_tile_key( const tripoint &p,
+        const visibility_variables &cache )
+{
+    static_tile_key key;
+    key.shown = true;
+    const lit_level ll = g->m.access_cache( p.z ).visibility_cache[p.x][p.y];
+    key.visibility = g->m.get_visibility( ll, cache );
+    if( key.visibility != VIS_CLEAR ) {
+        return key;
+    }
+    key.light = ll;
+    const ter_id t = g->m.ter( p );
+    if( t == t_null ) {
+        return key;
+    }
+    key.ter = t.to_i();
+    get_terrain_values( p, key.ter_subtile, key.ter_rotation );
+    if( g->m.has_furn( p ) ) {
+        key.furn = g->m.furn( p ).to_i();
+        get_furniture_values( p, key.furn_subtile, key.furn_rotation );
+        key.item_highlight = g->m.sees_some_items( p, g->u );
+    }
+    return key;
+}
+
+void cata_tiles::update_static_chunks( int z, const point &min_visible, const point &max_visible,
+                                       const visibility_variables &cache )
+{
+    if( static_chunks_tile_size != point( tile_width, tile_height ) ||
+        static_chunks_nv_goggles != nv_goggles_activated ) {
+        static_chunks.clear();
+        static_chunks_tile_size = point( tile_width, tile_height );
+        static_chunks_nv_goggles = nv_goggles_activated;
+    }
+
+    const tripoint abs_sub = g->m.get_abs_sub();
+    for( int smx = min_visible.x / SEEX; smx <= max_visible.x / SEEX; smx++ ) {
+        for( int smy = min_visible.y / SEEY; smy <= max_visible.y / SEEY; smy++ ) {
+            static_chunk &chunk = static_chunks[tripoint( abs_sub.x + smx, abs_sub.y + smy, z )];
+            chunk.drawn = true;
+            const tripoint origin( smx * SEEX, smy * SEEY, z );
+            for( int y = 0; y < SEEY; y++ ) {
+                for( int x = 0; x < SEEX; x++ ) {
+                    const tripoint p = origin + tripoint( x, y, 0 );
+                    static_tile_key key;
+                    if( p.x >= min_visible.x && p.x <= max_visible.x &&
+                        p.y >= min_visible.y && p.y <= max_visible.y ) {
+                        key = get_static_tile_key( p, cache );
+                    }
+                    static_tile_key &old_key = chunk.keys[y * SEEX + x];
+                    if( old_key != key ) {
+                        old_key = key;
+                        chunk.valid = false;
+                    }
+                }
+            }
+            if( !chunk.valid ) {
+                draw_static_chunk( chunk, origin );
+            }
+        }
+    }
+
+    for( auto it = static_chunks.begin(); it != static_chunks.end(); ) {
+        if( it->second.drawn ) {
+            it->second.drawn = false;
+            ++it;
+        } else {
+            it = static_chunks.erase( it );
+        }
+    }
+}
+
+void cata_tiles::draw_static_chunk( static_chunk &chunk, const tripoint &origin )
 {
-    const ter_id t = g->m.ter( p ); // get the ter_id value at this point
-    // check for null, if null return false
-    if (t == t_null) {
-        return false;
+    if( !chunk.texture ) {
+        SDL_Surface_Ptr temp = create_tile_surface();
+        chunk.texture.reset( SDL_CreateTexture( renderer, temp->format->format,
+                                                SDL_TEXTUREACCESS_TARGET, SEEX * tile_width, SEEY * tile_height ) );
+        if( !chunk.texture ) {
+            dbg( D_ERROR ) << "Failed to create static chunk texture: " << SDL_GetError();
+            static_chunks_usable = false;
+            return;
+        }
+    }
+    SDL_SetRenderTarget( renderer, chunk.texture.get() );
+    SDL_SetRenderDrawColor( renderer, 0, 0, 0, 255 );
+    SDL_RenderClear( renderer );
+
+    // Draw as if the chunk was all there is on screen
+    const int prev_o_x = o_x;
+    const int prev_o_y = o_y;
+    const int prev_op_x = op_x;
+    const int prev_op_y = op_y;
+    const int prev_screentile_width = screentile_width;
+    const int prev_screentile_height = screentile_height;
+    o_x = origin.x;
+    o_y = origin.y;
+    op_x = 0;
+    op_y = 0;
+    screentile_width = SEEX;
+    screentile_height = SEEY;
+
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            const static_tile_key &key = chunk.keys[y * SEEX + x];
+            const tripoint p = origin + tripoint( x, y, 0 );
+            int height_3d = 0;
+            if( key.shown && !apply_vision_effects( p, static_cast<visibility_type>( key.visibility ) ) &&
+                draw_terrain( p, static_cast<lit_level>( key.light ), height_3d ) ) {
+                draw_furniture( p, static_cast<lit_level>( key.light ), height_3d );
+            }
+        }
     }
 
-    //char alteration = 0;
-    int subtile = 0, rotation = 0;
+    o_x = prev_o_x;
+    o_y = prev_o_y;
+    op_x = prev_op_x;
+    op_y = prev_op_y;
+    screentile_width = prev_screentile_width;
+    screentile_height = prev_screentile_height;
+    set_displaybuffer_rendertarget();
+    chunk.valid = true;
+}
 
+void cata_tiles::draw_static_chunks( int z )
+{
+    const tripoint abs_sub = g->m.get_abs_sub();
+    for( const auto &elem : static_chunks ) {
+        if( elem.first.z != z || !elem.second.valid ) {
+            continue;
+        }
+        const SDL_Rect destination = {
+            ( ( elem.first.x - abs_sub.x ) * SEEX - o_x ) * tile_width + op_x,
+            ( ( elem.first.y - abs_sub.y ) * SEEY - o_y ) * tile_height + op_y,
+            SEEX * tile_width, SEEY * tile_height
+        };
+        SDL_RenderCopy( renderer, elem.second.texture.get(), NULL, &destination );
+    }
+}
+
+void cata_tiles::get_terrain_values( const tripoint &p, int &subtile, int &rotation )
+{
     int connect_group;
     if( g->m.ter( p ).obj().connects( connect_group ) ) {
         get_connect_values( p, subtile, rotation, connect_group );
@@ -1931,11 +2190,36 @@ bool cata_tiles::draw_terrain( const tripoint &p, lit_level ll, int &height_3d )
         get_terrain_orientation( p, rotation, subtile );
         // do something to get other terrain orientation values
     }
+}
 
-    const std::string& tname = t.obj().id.str();
+void cata_tiles::get_furniture_values( const tripoint &p, int &subtile, int &rotation )
+{
+    // for rotation information
+    const int neighborhood[4] = {
+        static_cast<int> (g->m.furn( tripoint( p.x, p.y + 1, p.z ))), // south
+        static_cast<int> (g->m.furn( tripoint( p.x + 1, p.y, p.z ))), // east
+        static_cast<int> (g->m.furn( tripoint( p.x - 1, p.y, p.z ))), // west
+        static_cast<int> (g->m.furn( tripoint( p.x, p.y - 1, p.z ))) // north
+    };
 
-    return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                nv_goggles_activated, height_3d );
+    get_tile_values( g->m.furn( p ), neighborhood, subtile, rotation );
+}
+
+bool cata_tiles::draw_terrain( const tripoint &p, lit_level ll, int &height_3d )
+{
+    const ter_id t = g->m.ter( p ); // get the ter_id value at this point
+    // check for null, if null return false
+    if (t == t_null) {
+        return false;
+    }
+
+    //char alteration = 0;
+    int subtile = 0, rotation = 0;
+    get_terrain_values( p, subtile, rotation );
+
+    return draw_from_cached_id( C_TERRAIN, t.to_i(), [&t]() {
+        return t.obj().id.str();
+    }, empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
 }
 
 bool cata_tiles::draw_furniture( const tripoint &p, lit_level ll, int &height_3d )
@@ -1948,21 +2232,12 @@ bool cata_tiles::draw_furniture( const tripoint &p, lit_level ll, int &height_3d
 
     const furn_id f_id = g->m.furn( p );
 
-    // for rotation information
-    const int neighborhood[4] = {
-        static_cast<int> (g->m.furn( tripoint( p.x, p.y + 1, p.z ))), // south
-        static_cast<int> (g->m.furn( tripoint( p.x + 1, p.y, p.z ))), // east
-        static_cast<int> (g->m.furn( tripoint( p.x - 1, p.y, p.z ))), // west
-        static_cast<int> (g->m.furn( tripoint( p.x, p.y - 1, p.z ))) // north
-    };
-
     int subtile = 0, rotation = 0;
-    get_tile_values(f_id, neighborhood, subtile, rotation);
+    get_furniture_values( p, subtile, rotation );
 
-    // get the name of this furniture piece
-    const std::string& f_name = f_id.obj().id.str();
-    bool ret = draw_from_id_string( f_name, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                    nv_goggles_activated, height_3d );
+    bool ret = draw_from_cached_id( C_FURNITURE, f_id.to_i(), [&f_id]() {
+        return f_id.obj().id.str();
+    }, empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
     if( ret && g->m.sees_some_items( p, g->u ) ) {
         draw_item_highlight( p );
     }
@@ -1986,8 +2261,9 @@ bool cata_tiles::draw_trap( const tripoint &p, lit_level ll, int &height_3d )
     int subtile = 0, rotation = 0;
     get_tile_values(tr.loadid, neighborhood, subtile, rotation);
 
-    return draw_from_id_string( tr.id.str(), C_TRAP, empty_string, p, subtile, rotation, ll,
-                               nv_goggles_activated, height_3d );
+    return draw_from_cached_id( C_TRAP, tr.loadid.to_i(), [&tr]() {
+        return tr.id.str();
+    }, empty_string, p, subtile, rotation, ll, nv_goggles_activated, height_3d );
 }
 
 bool cata_tiles::draw_field_or_item( const tripoint &p, lit_level ll, int &height_3d )
@@ -2038,7 +2314,6 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, lit_level ll, int &heigh
     bool ret_draw_field = true;
     bool ret_draw_item = true;
     if (is_draw_field) {
-        const std::string fd_name = fieldlist[f.fieldSymbol()].id;
 
         // for rotation inforomation
         const int neighborhood[4] = {
@@ -2051,8 +2326,10 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, lit_level ll, int &heigh
         int subtile = 0, rotation = 0;
         get_tile_values(f.fieldSymbol(), neighborhood, subtile, rotation);
 
-        ret_draw_field = draw_from_id_string( fd_name, C_FIELD, empty_string, p, subtile, rotation,
-                                              ll, nv_goggles_activated );
+        int nullint = 0;
+        ret_draw_field = draw_from_cached_id( C_FIELD, f_id, [f_id]() {
+            return fieldlist[f_id].id;
+        }, empty_string, p, subtile, rotation, ll, nv_goggles_activated, nullint );
     }
     if(do_item) {
         if( !g->m.sees_some_items( p, g->u ) ) {
@@ -2104,9 +2381,6 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d )
     const vpart_id &vp_id = veh->part_id_string(veh_part, part_mod);
     const char sym = veh->face.dir_symbol(veh->part_sym(veh_part));
     std::string subcategory(1, sym);
-
-    // prefix with vp_ ident
-    const std::string vpid = "vp_" + vp_id.str();
     int subtile = 0;
     if (part_mod > 0) {
         switch (part_mod) {
@@ -2120,8 +2394,15 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d )
     }
     int cargopart = veh->part_with_feature(veh_part, "CARGO");
     bool draw_highlight = (cargopart > 0) && (!veh->get_items(cargopart).empty());
-    bool ret = draw_from_id_string( vpid, C_VEHICLE_PART, subcategory, p, subtile, veh_dir,
-                                   ll, nv_goggles_activated, height_3d );
+    // prefix with vp_ ident
+    const auto vpid = [&vp_id]() {
+        return "vp_" + vp_id.str();
+    };
+    bool ret = vp_id.is_null() ?
+               draw_from_id_string( vpid(), C_VEHICLE_PART, subcategory, p, subtile, veh_dir,
+                                    ll, nv_goggles_activated, height_3d ) :
+               draw_from_cached_id( C_VEHICLE_PART, vp_id.obj().index, vpid, subcategory, p, subtile,
+                                    veh_dir, ll, nv_goggles_activated, height_3d );
     if ( ret && draw_highlight ) {
         draw_item_highlight( p );
     }
@@ -2148,15 +2429,13 @@ bool cata_tiles::draw_entity( const Creature &critter, const tripoint &p, lit_le
     }
     const monster *m = dynamic_cast<const monster*>( &critter );
     if( m != nullptr ) {
-        const auto ent_name = m->type->id;
-        const auto ent_category = C_MONSTER;
-        std::string ent_subcategory = empty_string;
-        if( !m->type->species.empty() ) {
-            ent_subcategory = m->type->species.begin()->str();
-        }
+        const mtype_id &ent_name = m->type->id;
+        const std::string &ent_subcategory = m->type->species.empty() ? empty_string :
+                                             m->type->species.begin()->str();
         const int subtile = corner;
-        return draw_from_id_string(ent_name.str(), ent_category, ent_subcategory, p, subtile,
-                                   0, ll, false, height_3d );
+        return draw_from_cached_id( C_MONSTER, ent_name.id().to_i(), [&ent_name]() {
+            return ent_name.str();
+        }, ent_subcategory, p, subtile, 0, ll, false, height_3d );
     }
     const player *pl = dynamic_cast<const player*>( &critter );
     if( pl != nullptr ) {
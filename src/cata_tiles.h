@@ -11,6 +11,7 @@
 #include "enums.h"
 #include "weighted_list.h"
 
+#include <array>
 #include <list>
 #include <map>
 #include <vector>
@@ -81,6 +82,48 @@ enum TILE_CATEGORY {
     C_WEATHER,
 };
 
+/**
+ * Tile of an object with an integer id, found in @ref cata_tiles::tile_ids once instead of
+ * every frame. The cache is cleared when another tileset is loaded or the season changes.
+ */
+struct cached_tile {
+    bool resolved = false;
+    /** Null if the tileset has no tile for the id */
+    const tile_type *tile = nullptr;
+    /** Id the tile was found under, including the season suffix of seasonal tiles */
+    std::string id;
+    /** Ids of the subtiles of a multitile, empty for subtiles the tile doesn't have */
+    std::array<std::string, num_multitile_types> subtile_ids;
+    std::array<const tile_type *, num_multitile_types> subtiles;
+};
+
+/** What the terrain and furniture of a tile were drawn from, see @ref static_chunk */
+struct static_tile_key {
+    /** Tiles that are not part of the map view are not drawn at all */
+    bool shown = false;
+    /** Only the visibility effect is drawn if the tile can't be seen clearly */
+    int visibility = 0;
+    int light = 0;
+    int ter = 0;
+    int ter_subtile = 0;
+    int ter_rotation = 0;
+    int furn = 0;
+    int furn_subtile = 0;
+    int furn_rotation = 0;
+    bool item_highlight = false;
+
+    bool operator==( const static_tile_key &other ) const {
+        return shown == other.shown && visibility == other.visibility && light == other.light &&
+               ter == other.ter && ter_subtile == other.ter_subtile &&
+               ter_rotation == other.ter_rotation && furn == other.furn &&
+               furn_subtile == other.furn_subtile && furn_rotation == other.furn_rotation &&
+               item_highlight == other.item_highlight;
+    }
+    bool operator!=( const static_tile_key &other ) const {
+        return !operator==( other );
+    }
+};
+
 /** Typedefs */
 struct SDL_Texture_deleter {
     // Operator overload required to leverage unique_ptr API.
@@ -241,6 +284,19 @@ struct minimap_submap_cache {
 
 using minimap_cache_ptr = std::unique_ptr< minimap_submap_cache >;
 
+/**
+ * The terrain and furniture of one submap, drawn once to a texture that is copied to the
+ * screen every frame. The texture is only drawn again when the key of one of its tiles changed.
+ */
+struct static_chunk {
+    SDL_Texture_Ptr texture;
+    /** Whether the texture shows what the keys describe */
+    bool valid = false;
+    /** Whether the chunk was part of the current frame, the others are dropped after it */
+    bool drawn = false;
+    std::array<static_tile_key, SEEX * SEEY> keys;
+};
+
 class cata_tiles
 {
     public:
@@ -340,6 +396,23 @@ class cata_tiles
         bool draw_from_id_string( std::string id, TILE_CATEGORY category,
                                   const std::string &subcategory, tripoint pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /**
+         * Like @ref draw_from_id_string, for an object that has the integer id @p index in @p category.
+         * @p get_id returns the string id, it's only called when the tile is not cached yet.
+         */
+        template<typename IdFunc>
+        bool draw_from_cached_id( TILE_CATEGORY category, size_t index, IdFunc get_id,
+                                  const std::string &subcategory, tripoint pos, int subtile, int rota,
+                                  lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /** Looks up the tile and the subtiles for @p id */
+        void resolve_cached_tile( cached_tile &cached, const std::string &id );
+        void clear_tile_cache();
+        /** Finds the tile for @p id, preferring the one for the current season whose id is then stored in @p id */
+        const tile_type *find_seasonal_tile( std::string &id ) const;
+        /** Draws a tile that was found for @p id at @p pos */
+        bool draw_tile_type( const tile_type &display_tile, const std::string &id, TILE_CATEGORY category,
+                             tripoint pos, int rota, lit_level ll, bool apply_night_vision_goggles,
+                             int &height_3d );
         bool draw_sprite_at( const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
                              int x, int y, unsigned int loc_rand, int rota_fg, int rota, lit_level ll,
                              bool apply_night_vision_goggles );
@@ -367,6 +440,21 @@ class cata_tiles
         void draw_single_tile( const tripoint &p, const lit_level ll,
                                const visibility_variables &cache, int &height_3d );
         bool apply_vision_effects( const tripoint &pos, const visibility_type visibility );
+        /**
+         * Finds the chunks of static layers in view and draws those with changed tiles.
+         * Only used for tilesets whose sprites stay inside their tile, and not in iso mode.
+         * @param min_visible,max_visible Local map area that can be shown at all.
+         * @param cache Visibility variables of the frame.
+         */
+        void update_static_chunks( int z, const point &min_visible, const point &max_visible,
+                                   const visibility_variables &cache );
+        static_tile_key get_static_tile_key( const tripoint &p, const visibility_variables &cache );
+        void draw_static_chunk( static_chunk &chunk, const tripoint &origin );
+        /** Copies the chunks in view to the screen */
+        void draw_static_chunks( int z );
+        /** Subtile and rotation for the terrain or furniture at p, which depend on its neighbors */
+        void get_terrain_values( const tripoint &p, int &subtile, int &rotation );
+        void get_furniture_values( const tripoint &p, int &subtile, int &rotation );
         bool draw_terrain( const tripoint &p, lit_level ll, int &height_3d );
         bool draw_terrain_below( const tripoint &p, lit_level ll, int &height_3d );
         bool draw_furniture( const tripoint &p, lit_level ll, int &height_3d );
@@ -455,6 +543,10 @@ class cata_tiles
             return tile_ratioy;
         }
         void do_tile_loading_report();
+        /** How long drawing the map view took, averaged over the last few frames */
+        float get_frame_time_ms() const {
+            return frame_time_ms;
+        }
     protected:
         void get_tile_information( std::string dir_path, std::string &json_path,
                                    std::string &tileset_path );
@@ -480,6 +572,17 @@ class cata_tiles
         SDL_Renderer *renderer;
         std::vector<SDL_Texture_Ptr> tile_values;
         std::unordered_map<std::string, tile_type> tile_ids;
+        /** Tiles of ter_id, furn_id, trap_id, field_id, mtype and vpart_info by integer id */
+        std::array<std::vector<cached_tile>, C_WEATHER + 1> tile_cache;
+        /** Season the cached tiles were looked up for */
+        int tile_cache_season = -1;
+        /** Static layers by absolute submap position */
+        std::map<tripoint, static_chunk> static_chunks;
+        /** False if the tileset has sprites that reach into other tiles or add height */
+        bool static_chunks_usable = true;
+        /** Night vision goggles change the sprites of the whole view */
+        bool static_chunks_nv_goggles = false;
+        point static_chunks_tile_size;
 
         int tile_height = 0, tile_width = 0, default_tile_width, default_tile_height;
         // The width and height of the area we can draw in,
@@ -523,6 +626,8 @@ class cata_tiles
         tripoint zone_end;
         tripoint zone_offset;
 
+        float frame_time_ms = 0.0f;
+
         // offset values, in tile coordinates, not pixels
         int o_x, o_y;
         // offset for drawing, in pixels.
@@ -21,20 +21,50 @@ typedef struct {
     int BG;
 } pairs;
 
-//Individual lines, so that we can track changed lines
+/**
+ * A single cell of a window. Plain data, so lines can be filled and compared without
+ * allocating. A character that is two cells wide takes this cell and the next one,
+ * which is marked as continuation.
+ */
 struct cursecell {
-    std::string ch;
+    enum : uint8_t {
+        /** Second cell of a wide character, nothing is drawn for it */
+        CONTINUATION = 1,
+        /** ch is one of the LINE_*_C codes (or another byte that is not valid UTF-8) */
+        LINE_DRAWING = 2,
+        /** Matches no cell that can be printed, used to force redrawing */
+        INVALID = 4,
+    };
+
+    /** Unicode code point of the glyph, see flags */
+    uint32_t ch = ' ';
+    /** Zero width code point drawn on top of ch (e.g. a combining accent), 0 for none */
+    uint32_t mark = 0;
     char FG = 0;
     char BG = 0;
+    uint8_t flags = 0;
+
+    cursecell() = default;
+    explicit cursecell( uint32_t ch, uint8_t flags = 0 ) : ch( ch ), flags( flags ) { }
 
-    cursecell( std::string ch ) : ch( std::move( ch ) ) { }
-    cursecell() : cursecell( std::string( 1, ' ' ) ) { }
+    bool is_continuation() const {
+        return ( flags & CONTINUATION ) != 0;
+    }
+    bool is_line_drawing() const {
+        return ( flags & LINE_DRAWING ) != 0;
+    }
+    /** The glyph as UTF-8, empty for continuation cells */
+    std::string to_string() const;
 
     bool operator==( const cursecell &b ) const {
-        return FG == b.FG && BG == b.BG && ch == b.ch;
+        return ch == b.ch && mark == b.mark && FG == b.FG && BG == b.BG && flags == b.flags;
+    }
+    bool operator!=( const cursecell &b ) const {
+        return !operator==( b );
     }
 };
 
+//Individual lines, so that we can track changed lines
 struct curseline {
     bool touched;
     std::vector<cursecell> chars;
@@ -39,6 +39,63 @@ const efftype_id effect_in_pit( "in_pit" );
 const efftype_id effect_lightsnare( "lightsnare" );
 const efftype_id effect_webbed( "webbed" );
 
+const trait_id trait_ACIDBLOOD( "ACIDBLOOD" );
+const trait_id trait_ACIDPROOF( "ACIDPROOF" );
+const trait_id trait_ARACHNID_ARMS( "ARACHNID_ARMS" );
+const trait_id trait_ARM_TENTACLES( "ARM_TENTACLES" );
+const trait_id trait_ARM_TENTACLES_4( "ARM_TENTACLES_4" );
+const trait_id trait_ARM_TENTACLES_8( "ARM_TENTACLES_8" );
+const trait_id trait_BADBACK( "BADBACK" );
+const trait_id trait_BENDY2( "BENDY2" );
+const trait_id trait_BENDY3( "BENDY3" );
+const trait_id trait_BIRD_EYE( "BIRD_EYE" );
+const trait_id trait_CEPH_EYES( "CEPH_EYES" );
+const trait_id trait_CHITIN2( "CHITIN2" );
+const trait_id trait_CHITIN3( "CHITIN3" );
+const trait_id trait_CHITIN_FUR3( "CHITIN_FUR3" );
+const trait_id trait_DEBUG_NIGHTVISION( "DEBUG_NIGHTVISION" );
+const trait_id trait_DISORGANIZED( "DISORGANIZED" );
+const trait_id trait_FLIMSY( "FLIMSY" );
+const trait_id trait_FLIMSY2( "FLIMSY2" );
+const trait_id trait_FLIMSY3( "FLIMSY3" );
+const trait_id trait_GLASSJAW( "GLASSJAW" );
+const trait_id trait_HOLLOW_BONES( "HOLLOW_BONES" );
+const trait_id trait_HUGE( "HUGE" );
+const trait_id trait_INFRARED( "INFRARED" );
+const trait_id trait_INSECT_ARMS( "INSECT_ARMS" );
+const trait_id trait_LIGHT_BONES( "LIGHT_BONES" );
+const trait_id trait_LIZ_IR( "LIZ_IR" );
+const trait_id trait_MEMBRANE( "MEMBRANE" );
+const trait_id trait_MUT_TOUGH( "MUT_TOUGH" );
+const trait_id trait_MUT_TOUGH2( "MUT_TOUGH2" );
+const trait_id trait_MUT_TOUGH3( "MUT_TOUGH3" );
+const trait_id trait_MYOPIC( "MYOPIC" );
+const trait_id trait_M_IMMUNE( "M_IMMUNE" );
+const trait_id trait_PACKMULE( "PACKMULE" );
+const trait_id trait_PER_SLIME( "PER_SLIME" );
+const trait_id trait_PER_SLIME_OK( "PER_SLIME_OK" );
+const trait_id trait_SHELL( "SHELL" );
+const trait_id trait_SHELL2( "SHELL2" );
+const trait_id trait_STRONGBACK( "STRONGBACK" );
+const trait_id trait_TAIL_CATTLE( "TAIL_CATTLE" );
+const trait_id trait_TAIL_FLUFFY( "TAIL_FLUFFY" );
+const trait_id trait_TAIL_LONG( "TAIL_LONG" );
+const trait_id trait_TAIL_RAPTOR( "TAIL_RAPTOR" );
+const trait_id trait_TAIL_RAT( "TAIL_RAT" );
+const trait_id trait_TAIL_THICK( "TAIL_THICK" );
+const trait_id trait_THICK_SCALES( "THICK_SCALES" );
+const trait_id trait_THRESH_CEPHALOPOD( "THRESH_CEPHALOPOD" );
+const trait_id trait_THRESH_INSECT( "THRESH_INSECT" );
+const trait_id trait_THRESH_PLANT( "THRESH_PLANT" );
+const trait_id trait_THRESH_SPIDER( "THRESH_SPIDER" );
+const trait_id trait_TOUGH( "TOUGH" );
+const trait_id trait_TOUGH2( "TOUGH2" );
+const trait_id trait_TOUGH3( "TOUGH3" );
+const trait_id trait_URSINE_EYE( "URSINE_EYE" );
+const trait_id trait_WEBBED( "WEBBED" );
+const trait_id trait_WINGS_BAT( "WINGS_BAT" );
+const trait_id trait_WINGS_BUTTERFLY( "WINGS_BUTTERFLY" );
+
 const skill_id skill_dodge( "dodge" );
 const skill_id skill_throw( "throw" );
 
@@ -73,13 +130,13 @@ Character::Character() : Creature(), visitable<Character>()
 
 field_id Character::bloodType() const
 {
-    if (has_trait("ACIDBLOOD"))
+    if (has_trait( trait_ACIDBLOOD ))
         return fd_acid;
-    if (has_trait("THRESH_PLANT"))
+    if (has_trait( trait_THRESH_PLANT ))
         return fd_blood_veggy;
-    if (has_trait("THRESH_INSECT") || has_trait("THRESH_SPIDER"))
+    if (has_trait( trait_THRESH_INSECT ) || has_trait( trait_THRESH_SPIDER ))
         return fd_blood_insect;
-    if (has_trait("THRESH_CEPHALOPOD"))
+    if (has_trait( trait_THRESH_CEPHALOPOD ))
         return fd_blood_invertebrate;
     return fd_blood;
 }
@@ -342,43 +399,43 @@ void Character::recalc_hp()
     for( auto &elem : new_max_hp ) {
         ///\EFFECT_STR_MAX increases base hp
         elem = 60 + str_max * 3;
-        if (has_trait("HUGE")) {
+        if (has_trait( trait_HUGE )) {
             // Bad-Huge doesn't quite have the cardio/skeletal/etc to support the mass,
             // so no HP bonus from the ST above/beyond that from Large
             elem -= 6;
         }
         // You lose half the HP you'd expect from BENDY mutations.  Your gelatinous
         // structure can help with that, a bit.
-        if (has_trait("BENDY2")) {
+        if (has_trait( trait_BENDY2 )) {
             elem += 3;
         }
-        if (has_trait("BENDY3")) {
+        if (has_trait( trait_BENDY3 )) {
             elem += 6;
         }
         // Only the most extreme applies.
-        if (has_trait("TOUGH")) {
+        if (has_trait( trait_TOUGH )) {
             elem *= 1.2;
-        } else if (has_trait("TOUGH2")) {
+        } else if (has_trait( trait_TOUGH2 )) {
             elem *= 1.3;
-        } else if (has_trait("TOUGH3")) {
+        } else if (has_trait( trait_TOUGH3 )) {
             elem *= 1.4;
-        } else if (has_trait("FLIMSY")) {
+        } else if (has_trait( trait_FLIMSY )) {
             elem *= .75;
-        } else if (has_trait("FLIMSY2")) {
+        } else if (has_trait( trait_FLIMSY2 )) {
             elem *= .5;
-        } else if (has_trait("FLIMSY3")) {
+        } else if (has_trait( trait_FLIMSY3 )) {
             elem *= .25;
         }
         // Mutated toughness stacks with starting, by design.
-        if (has_trait("MUT_TOUGH")) {
+        if (has_trait( trait_MUT_TOUGH )) {
             elem *= 1.2;
-        } else if (has_trait("MUT_TOUGH2")) {
+        } else if (has_trait( trait_MUT_TOUGH2 )) {
             elem *= 1.3;
-        } else if (has_trait("MUT_TOUGH3")) {
+        } else if (has_trait( trait_MUT_TOUGH3 )) {
             elem *= 1.4;
         }
     }
-    if( has_trait( "GLASSJAW" ) ) {
+    if( has_trait( trait_GLASSJAW ) ) {
         new_max_hp[hp_head] *= 0.8;
     }
     for( int i = 0; i < num_hp_parts; i++ ) {
@@ -406,22 +463,22 @@ void Character::recalc_sight_limits()
     // Set sight_max.
     if( is_blind() ) {
         sight_max = 0;
-    } else if( has_effect( effect_boomered ) && (!(has_trait("PER_SLIME_OK"))) ) {
+    } else if( has_effect( effect_boomered ) && (!(has_trait( trait_PER_SLIME_OK ))) ) {
         sight_max = 1;
         vision_mode_cache.set( BOOMERED );
     } else if (has_effect( effect_in_pit ) ||
             (underwater && !has_bionic("bio_membrane") &&
-                !has_trait("MEMBRANE") && !worn_with_flag("SWIM_GOGGLES") &&
-                !has_trait("CEPH_EYES") && !has_trait("PER_SLIME_OK") ) ) {
+                !has_trait( trait_MEMBRANE ) && !worn_with_flag("SWIM_GOGGLES") &&
+                !has_trait( trait_CEPH_EYES ) && !has_trait( trait_PER_SLIME_OK ) ) ) {
         sight_max = 1;
     } else if (has_active_mutation("SHELL2")) {
         // You can kinda see out a bit.
         sight_max = 2;
-    } else if ( (has_trait("MYOPIC") || has_trait("URSINE_EYE")) &&
+    } else if ( (has_trait( trait_MYOPIC ) || has_trait( trait_URSINE_EYE )) &&
             !is_wearing("glasses_eye") && !is_wearing("glasses_monocle") &&
             !is_wearing("glasses_bifocal") && !has_effect( effect_contacts )) {
         sight_max = 4;
-    } else if (has_trait("PER_SLIME")) {
+    } else if (has_trait( trait_PER_SLIME )) {
         sight_max = 6;
     } else if( has_effect( effect_darkness ) ) {
         vision_mode_cache.set( DARKNESS );
@@ -429,7 +486,7 @@ void Character::recalc_sight_limits()
     }
 
     // Debug-only NV, by vache's request
-    if( has_trait("DEBUG_NIGHTVISION") ) {
+    if( has_trait( trait_DEBUG_NIGHTVISION ) ) {
         vision_mode_cache.set( DEBUG_NIGHTVISION );
     }
     if( has_nv() ) {
@@ -459,14 +516,14 @@ void Character::recalc_sight_limits()
     if (has_active_mutation("NIGHTVISION")) {
         vision_mode_cache.set(NIGHTVISION_1);
     }
-    if( has_trait("BIRD_EYE") ) {
+    if( has_trait( trait_BIRD_EYE ) ) {
         vision_mode_cache.set( BIRD_EYE);
     }
 
     // Not exactly a sight limit thing, but related enough
     if( has_active_bionic( "bio_infrared" ) ||
-        has_trait( "INFRARED" ) ||
-        has_trait( "LIZ_IR" ) ||
+        has_trait( trait_INFRARED ) ||
+        has_trait( trait_LIZ_IR ) ||
         worn_with_flag( "IR_EFFECT" ) ) {
         vision_mode_cache.set( IR_VISION );
     }
@@ -589,6 +646,10 @@ item& Character::i_add(item it)
     }
 
     auto &item_in_inv = inv.add_item(it, keep_invlet);
+    if( item_in_inv.is_bucket_nonempty() ) {
+        // Picking up spills the content.
+        inv.invalidate_aggregates();
+    }
     item_in_inv.on_pickup( *this );
     return item_in_inv;
 }
@@ -831,16 +892,16 @@ int Character::weight_capacity() const
     int ret = Creature::weight_capacity();
     ///\EFFECT_STR increases carrying capacity
     ret += get_str() * 4000;
-    if (has_trait("BADBACK")) {
+    if (has_trait( trait_BADBACK )) {
         ret = int(ret * .65);
     }
-    if (has_trait("STRONGBACK")) {
+    if (has_trait( trait_STRONGBACK )) {
         ret = int(ret * 1.35);
     }
-    if (has_trait("LIGHT_BONES")) {
+    if (has_trait( trait_LIGHT_BONES )) {
         ret = int(ret * .80);
     }
-    if (has_trait("HOLLOW_BONES")) {
+    if (has_trait( trait_HOLLOW_BONES )) {
         ret = int(ret * .60);
     }
     if (has_artifact_with(AEP_CARRY_MORE)) {
@@ -866,16 +927,16 @@ units::volume Character::volume_capacity_reduced_by( units::volume mod ) const
     if (has_bionic("bio_storage")) {
         ret += 2000_ml;
     }
-    if (has_trait("SHELL")) {
+    if (has_trait( trait_SHELL )) {
         ret += 4000_ml;
     }
-    if (has_trait("SHELL2") && !has_active_mutation("SHELL2")) {
+    if (has_trait( trait_SHELL2 ) && !has_active_mutation("SHELL2")) {
         ret += 6000_ml;
     }
-    if (has_trait("PACKMULE")) {
+    if (has_trait( trait_PACKMULE )) {
         ret = ret * 1.4;
     }
-    if (has_trait("DISORGANIZED")) {
+    if (has_trait( trait_DISORGANIZED )) {
         ret = ret * 0.6;
     }
     return std::max( ret, 0_ml );
@@ -1132,52 +1193,52 @@ void Character::reset_stats()
         mod_dex_bonus(2);
 
     // Trait / mutation buffs
-    if (has_trait("THICK_SCALES")) {
+    if (has_trait( trait_THICK_SCALES )) {
         mod_dex_bonus(-2);
     }
-    if (has_trait("CHITIN2") || has_trait("CHITIN3") || has_trait("CHITIN_FUR3")) {
+    if (has_trait( trait_CHITIN2 ) || has_trait( trait_CHITIN3 ) || has_trait( trait_CHITIN_FUR3 )) {
         mod_dex_bonus(-1);
     }
-    if (has_trait("BIRD_EYE")) {
+    if (has_trait( trait_BIRD_EYE )) {
         mod_per_bonus(4);
     }
-    if (has_trait("INSECT_ARMS")) {
+    if (has_trait( trait_INSECT_ARMS )) {
         mod_dex_bonus(-2);
     }
-    if (has_trait("WEBBED")) {
+    if (has_trait( trait_WEBBED )) {
         mod_dex_bonus(-1);
     }
-    if (has_trait("ARACHNID_ARMS")) {
+    if (has_trait( trait_ARACHNID_ARMS )) {
         mod_dex_bonus(-4);
     }
-    if (has_trait("ARM_TENTACLES") || has_trait("ARM_TENTACLES_4") ||
-            has_trait("ARM_TENTACLES_8")) {
+    if (has_trait( trait_ARM_TENTACLES ) || has_trait( trait_ARM_TENTACLES_4 ) ||
+            has_trait( trait_ARM_TENTACLES_8 )) {
         mod_dex_bonus(1);
     }
 
     // Dodge-related effects
-    if (has_trait("TAIL_LONG")) {
+    if (has_trait( trait_TAIL_LONG )) {
         mod_dodge_bonus(2);
     }
-    if (has_trait("TAIL_CATTLE")) {
+    if (has_trait( trait_TAIL_CATTLE )) {
         mod_dodge_bonus(1);
     }
-    if (has_trait("TAIL_RAT")) {
+    if (has_trait( trait_TAIL_RAT )) {
         mod_dodge_bonus(2);
     }
-    if (has_trait("TAIL_THICK") && !(has_active_mutation("TAIL_THICK")) ) {
+    if (has_trait( trait_TAIL_THICK ) && !(has_active_mutation("TAIL_THICK")) ) {
         mod_dodge_bonus(1);
     }
-    if (has_trait("TAIL_RAPTOR")) {
+    if (has_trait( trait_TAIL_RAPTOR )) {
         mod_dodge_bonus(3);
     }
-    if (has_trait("TAIL_FLUFFY")) {
+    if (has_trait( trait_TAIL_FLUFFY )) {
         mod_dodge_bonus(4);
     }
-    if (has_trait("WINGS_BAT")) {
+    if (has_trait( trait_WINGS_BAT )) {
         mod_dodge_bonus(-3);
     }
-    if (has_trait("WINGS_BUTTERFLY")) {
+    if (has_trait( trait_WINGS_BUTTERFLY )) {
         mod_dodge_bonus(-4);
     }
 
@@ -1959,12 +2020,12 @@ bool Character::is_immune_field( const field_id fid ) const
         case fd_relax_gas:
             return get_env_resist( bp_mouth ) >= 15;
         case fd_fungal_haze:
-            return has_trait("M_IMMUNE") || (get_env_resist( bp_mouth ) >= 15 &&
+            return has_trait( trait_M_IMMUNE ) || (get_env_resist( bp_mouth ) >= 15 &&
                    get_env_resist( bp_eyes ) >= 15);
         case fd_electricity:
             return is_elec_immune();
         case fd_acid:
-            return has_trait("ACIDPROOF") ||
+            return has_trait( trait_ACIDPROOF ) ||
                    (!is_on_ground() && get_env_resist( bp_foot_l ) >= 15 &&
                    get_env_resist( bp_foot_r ) >= 15 &&
                    get_env_resist( bp_leg_l ) >= 15 &&
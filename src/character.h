@@ -12,6 +12,8 @@
 #include <map>
 
 using skill_id = string_id<Skill>;
+struct mutation_branch;
+using trait_id = string_id<mutation_branch>;
 enum field_id : int;
 class field;
 class field_entry;
@@ -223,8 +225,11 @@ class Character : public Creature, public visitable<Character>
         // In mutation.cpp
         /** Returns true if the player has the entered trait */
         bool has_trait(const std::string &flag) const override;
+        /** As above, but only tests a bit once the id has been interned */
+        bool has_trait( const trait_id &flag ) const;
         /** Returns true if the player has the entered starting trait */
         bool has_base_trait(const std::string &flag) const;
+        bool has_base_trait( const trait_id &flag ) const;
         /** Returns true if player has a trait with a flag */
         bool has_trait_flag( const std::string &flag ) const;
         /** Returns true if player has a bionic with a flag */
@@ -582,6 +587,15 @@ class Character : public Creature, public visitable<Character>
          * Contains mutation ids of the base traits.
          */
         std::unordered_set<std::string> my_traits;
+        /**
+         * Membership bitsets of the two above, indexed by @ref mutation_branch::intern.
+         * Every change to my_mutations or my_traits must be mirrored here, see
+         * @ref rebuild_trait_bits.
+         */
+        std::vector<bool> mutation_bits;
+        std::vector<bool> trait_bits;
+        /** Recomputes @ref mutation_bits and @ref trait_bits from the string containers */
+        void rebuild_trait_bits();
 
         void store(JsonOut &jsout) const;
         void load(JsonObject &jsin);
@@ -817,42 +817,38 @@ void Creature::add_effect( const efftype_id &eff_id, int dur, body_part bp,
 
     bool found = false;
     // Check if we already have it
-    auto matching_map = effects.find(eff_id);
-    if (matching_map != effects.end()) {
-        auto &bodyparts = matching_map->second;
-        auto found_effect = bodyparts.find(bp);
-        if (found_effect != bodyparts.end()) {
-            found = true;
-            effect &e = found_effect->second;
-            const int prev_int = e.get_intensity();
-            // If we do, mod the duration, factoring in the mod value
-            e.mod_duration(dur * e.get_dur_add_perc() / 100);
-            // Limit to max duration
-            if (e.get_max_duration() > 0 && e.get_duration() > e.get_max_duration()) {
-                e.set_duration(e.get_max_duration());
-            }
-            // Adding a permanent effect makes it permanent
-            if( e.is_permanent() ) {
-                e.pause_effect();
-            }
-            // Set intensity if value is given
-            if (intensity > 0) {
-                e.set_intensity(intensity);
-            // Else intensity uses the type'd step size if it already exists
-            } else if (e.get_int_add_val() != 0) {
-                e.mod_intensity(e.get_int_add_val());
-            }
+    effect *found_effect = effects.find( eff_id, bp );
+    if( found_effect != nullptr ) {
+        found = true;
+        effect &e = *found_effect;
+        const int prev_int = e.get_intensity();
+        // If we do, mod the duration, factoring in the mod value
+        e.mod_duration(dur * e.get_dur_add_perc() / 100);
+        // Limit to max duration
+        if (e.get_max_duration() > 0 && e.get_duration() > e.get_max_duration()) {
+            e.set_duration(e.get_max_duration());
+        }
+        // Adding a permanent effect makes it permanent
+        if( e.is_permanent() ) {
+            e.pause_effect();
+        }
+        // Set intensity if value is given
+        if (intensity > 0) {
+            e.set_intensity(intensity);
+        // Else intensity uses the type'd step size if it already exists
+        } else if (e.get_int_add_val() != 0) {
+            e.mod_intensity(e.get_int_add_val());
+        }
 
-            // Bound intensity by [1, max intensity]
-            if (e.get_intensity() < 1) {
-                add_msg( m_debug, "Bad intensity, ID: %s", e.get_id().c_str() );
-                e.set_intensity(1);
-            } else if (e.get_intensity() > e.get_max_intensity()) {
-                e.set_intensity(e.get_max_intensity());
-            }
-            if( e.get_intensity() != prev_int ) {
-                on_effect_int_change( eff_id, e.get_intensity(), bp );
-            }
+        // Bound intensity by [1, max intensity]
+        if (e.get_intensity() < 1) {
+            add_msg( m_debug, "Bad intensity, ID: %s", e.get_id().c_str() );
+            e.set_intensity(1);
+        } else if (e.get_intensity() > e.get_max_intensity()) {
+            e.set_intensity(e.get_max_intensity());
+        }
+        if( e.get_intensity() != prev_int ) {
+            on_effect_int_change( eff_id, e.get_intensity(), bp );
         }
     }
 
@@ -860,13 +856,11 @@ void Creature::add_effect( const efftype_id &eff_id, int dur, body_part bp,
         // If we don't already have it then add a new one
 
         // Then check if the effect is blocked by another
-        for( auto &elem : effects ) {
-            for( auto &_effect_it : elem.second ) {
-                for( const auto blocked_effect : _effect_it.second.get_blocks_effects() ) {
-                    if (blocked_effect == eff_id) {
-                        // The effect is blocked by another, return
-                        return;
-                    }
+        for( const effect &other : effects ) {
+            for( const auto blocked_effect : other.get_blocks_effects() ) {
+                if (blocked_effect == eff_id) {
+                    // The effect is blocked by another, return
+                    return;
                 }
             }
         }
@@ -890,7 +884,7 @@ void Creature::add_effect( const efftype_id &eff_id, int dur, body_part bp,
         } else if (e.get_intensity() > e.get_max_intensity()) {
             e.set_intensity(e.get_max_intensity());
         }
-        effects[eff_id][bp] = e;
+        effects.set( e );
         if (is_player()) {
             // Only print the message if we didn't already have it
             if(type.get_apply_message() != "") {
@@ -926,11 +920,8 @@ bool Creature::add_env_effect( const efftype_id &eff_id, body_part vector, int s
 }
 void Creature::clear_effects()
 {
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            const effect &e = _effect_it.second;
-            on_effect_int_change( e.get_id(), 0, e.get_bp() );
-        }
+    for( const effect &e : effects ) {
+        on_effect_int_change( e.get_id(), 0, e.get_bp() );
     }
     effects.clear();
 }
@@ -956,17 +947,15 @@ bool Creature::remove_effect( const efftype_id &eff_id, body_part bp )
 
     // num_bp means remove all of a given effect id
     if (bp == num_bp) {
-        for( auto &it : effects[eff_id] ) {
-            on_effect_int_change( eff_id, 0, it.first );
+        for( const effect &e : effects ) {
+            if( e.get_id() == eff_id ) {
+                on_effect_int_change( eff_id, 0, e.get_bp() );
+            }
         }
-        effects.erase(eff_id);
+        effects.erase( eff_id );
     } else {
-        effects[eff_id].erase(bp);
+        effects.erase( eff_id, bp );
         on_effect_int_change( eff_id, 0, bp );
-        // If there are no more effects of a given type remove the type map
-        if (effects[eff_id].empty()) {
-            effects.erase(eff_id);
-        }
     }
     return true;
 }
@@ -974,16 +963,9 @@ bool Creature::has_effect( const efftype_id &eff_id, body_part bp ) const
 {
     // num_bp means anything targeted or not
     if (bp == num_bp) {
-        return effects.find( eff_id ) != effects.end();
+        return effects.has( eff_id );
     } else {
-        auto got_outer = effects.find(eff_id);
-        if(got_outer != effects.end()) {
-            auto got_inner = got_outer->second.find(bp);
-            if (got_inner != got_outer->second.end()) {
-                return true;
-            }
-        }
-        return false;
+        return effects.find( eff_id, bp ) != nullptr;
     }
 }
 
@@ -994,14 +976,8 @@ effect &Creature::get_effect( const efftype_id &eff_id, body_part bp )
 
 const effect &Creature::get_effect( const efftype_id &eff_id, body_part bp ) const
 {
-    auto got_outer = effects.find(eff_id);
-    if(got_outer != effects.end()) {
-        auto got_inner = got_outer->second.find(bp);
-        if (got_inner != got_outer->second.end()) {
-            return got_inner->second;
-        }
-    }
-    return effect::null_effect;
+    const effect *eff = effects.find( eff_id, bp );
+    return eff != nullptr ? *eff : effect::null_effect;
 }
 int Creature::get_effect_dur( const efftype_id &eff_id, body_part bp ) const
 {
@@ -1030,21 +1006,18 @@ void Creature::process_effects()
     std::vector<body_part> rem_bps;
 
     // Decay/removal of effects
-    for( auto &elem : effects ) {
-        for( auto &_it : elem.second ) {
-            // Add any effects that others remove to the removal list
-            for( const auto removed_effect : _it.second.get_removes_effects() ) {
-                rem_ids.push_back( removed_effect );
-                rem_bps.push_back(num_bp);
-            }
-            effect &e = _it.second;
-            const int prev_int = e.get_intensity();
-            // Run decay effects, marking effects for removal as necessary.
-            e.decay( rem_ids, rem_bps, calendar::turn, is_player() );
+    for( effect &e : effects ) {
+        // Add any effects that others remove to the removal list
+        for( const auto removed_effect : e.get_removes_effects() ) {
+            rem_ids.push_back( removed_effect );
+            rem_bps.push_back(num_bp);
+        }
+        const int prev_int = e.get_intensity();
+        // Run decay effects, marking effects for removal as necessary.
+        e.decay( rem_ids, rem_bps, calendar::turn, is_player() );
 
-            if( e.get_intensity() != prev_int && e.get_duration() > 0 ) {
-                on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
-            }
+        if( e.get_intensity() != prev_int && e.get_duration() > 0 ) {
+            on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
         }
     }
 
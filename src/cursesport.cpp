@@ -19,10 +19,10 @@
  * and the actual text.
  * The text is split into lines (curseline), which contains cells (cursecell).
  * Each cell has individual foreground and background, and a character. The
- * character is an UTF-8 encoded string. It should be one or two console cells
- * width. If it's two cells width, the next cell in the line must be completely
- * empty (the string must not contain anything). Also the last cell of a line
- * must not contain a two cell width string.
+ * character is a Unicode code point. It should be one or two console cells
+ * width. If it's two cells width, the next cell in the line must be marked as
+ * continuation. Also the last cell of a line must not contain a two cell width
+ * character.
  */
 
 //***********************************
@@ -348,15 +348,48 @@ int getnstr(char *str, int size)
     return count;
 }
 
-// Get a sequence of Unicode code points, store them in target
-// return the display width of the extracted string.
-inline int fill(const char *&fmt, int &len, std::string &target)
+std::string cursecell::to_string() const
+{
+    if( is_continuation() ) {
+        return std::string();
+    }
+    if( is_line_drawing() ) {
+        return std::string( 1, static_cast<char>( ch ) );
+    }
+    std::string result = utf32_to_utf8( ch );
+    if( mark != 0 ) {
+        result += utf32_to_utf8( mark );
+    }
+    return result;
+}
+
+inline void set_blank( cursecell &cell )
+{
+    cell.ch = ' ';
+    cell.mark = 0;
+    cell.flags = 0;
+}
+
+inline void set_continuation( cursecell &cell )
+{
+    cell.ch = 0;
+    cell.mark = 0;
+    cell.flags = cursecell::CONTINUATION;
+}
+
+// Get a sequence of Unicode code points (a character and the zero-width code points
+// behind it), store them in target, return the display width of the sequence.
+inline int fill( const char *&fmt, int &len, cursecell &target )
 {
     const char *const start = fmt;
     int dlen = 0; // display width
     const char *tmpptr = fmt; // pointer for UTF8_getch, which increments it
     int tmplen = len;
+    target.ch = 0;
+    target.mark = 0;
+    target.flags = 0;
     while( tmplen > 0 ) {
+        const char *const current = tmpptr;
         const uint32_t ch = UTF8_getch(&tmpptr, &tmplen);
         // UNKNOWN_UNICODE is most likely a (vertical/horizontal) line or similar
         const int cw = (ch == UNKNOWN_UNICODE) ? 1 : mk_wcwidth(ch);
@@ -367,7 +400,7 @@ inline int fill(const char *&fmt, int &len, std::string &target)
             // First char is a control character: they only disturb the screen,
             // so replace it with a single space (e.g. instead of a '\t').
             // Newlines at the begin of a sequence are handled in printstring
-            target.assign( " ", 1 );
+            set_blank( target );
             len = tmplen;
             fmt = tmpptr;
             return 1; // the space
@@ -379,9 +412,17 @@ inline int fill(const char *&fmt, int &len, std::string &target)
         }
         fmt = tmpptr;
         dlen += cw;
+        if( ch == UNKNOWN_UNICODE ) {
+            target.ch = static_cast<unsigned char>( *current );
+            target.flags = cursecell::LINE_DRAWING;
+        } else if( cw > 0 ) {
+            target.ch = ch;
+        } else if( target.mark == 0 ) {
+            // Only one combining character per cell is kept
+            target.mark = ch;
+        }
     }
-    target.assign(start, fmt - start);
-    len -= target.length();
+    len -= fmt - start;
     return dlen;
 }
 
@@ -415,9 +456,9 @@ inline int printstring(WINDOW *win, const std::string &text)
     if( win->cursory >= win->height || win->cursorx >= win->width ) {
         return 0;
     }
-    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].ch.empty() ) {
+    if( win->cursorx > 0 && win->line[win->cursory].chars[win->cursorx].is_continuation() ) {
         // start inside a wide character, erase it for good
-        win->line[win->cursory].chars[win->cursorx - 1].ch.assign(" ");
+        set_blank( win->line[win->cursory].chars[win->cursorx - 1] );
     }
     while( len > 0 ) {
         if( *fmt == '\n' ) {
@@ -432,45 +473,47 @@ inline int printstring(WINDOW *win, const std::string &text)
         if( curcell == nullptr ) {
             return 0;
         }
-        const int dlen = fill(fmt, len, curcell->ch);
+        cursecell glyph;
+        const int dlen = fill( fmt, len, glyph );
         if( dlen >= 1 ) {
-            curcell->FG = win->FG;
-            curcell->BG = win->BG;
+            glyph.FG = win->FG;
+            glyph.BG = win->BG;
+            *curcell = glyph;
             addedchar( win );
         }
         if( dlen == 1 ) {
-            // a wide character was converted to a narrow character leaving a null in the
-            // following cell ~> clear it
+            // a wide character was converted to a narrow character leaving a continuation
+            // in the following cell ~> clear it
             cursecell *seccell = cur_cell( win );
-            if (seccell && seccell->ch.empty()) {
-                seccell->ch.assign(' ', 1);
+            if( seccell && seccell->is_continuation() ) {
+                set_blank( *seccell );
             }
         } else if( dlen == 2 ) {
-            // the second cell, per definition must be empty
+            // the second cell, per definition is a continuation
             cursecell *seccell = cur_cell( win );
             if( seccell == nullptr ) {
                 // the previous cell was valid, this one is outside of the window
                 // --> the previous was the last cell of the last line
                 // --> there should not be a two-cell width character in the last cell
-                curcell->ch.assign(' ', 1);
+                set_blank( *curcell );
                 return 0;
             }
             seccell->FG = win->FG;
             seccell->BG = win->BG;
-            seccell->ch.erase();
+            set_continuation( *seccell );
             addedchar( win );
             // Have just written a wide-character into the last cell, it would not
             // display correctly if it was the last *cell* of a line
             if( win->cursorx == 1 ) {
                 // So make that last cell a space, move the width
                 // character in the first cell of the line
-                seccell->ch = curcell->ch;
-                curcell->ch.assign(1, ' ');
-                // and make the second cell on the new line empty.
+                *seccell = *curcell;
+                set_blank( *curcell );
+                // and make the second cell on the new line a continuation.
                 addedchar( win );
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
-                    thicell->ch.erase();
+                    set_continuation( *thicell );
                 }
             }
         }
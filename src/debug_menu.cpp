@@ -4,8 +4,12 @@
 #include "coordinate_conversions.h"
 #include "game.h"
 #include "messages.h"
+#include "output.h"
 #include "overmap.h"
+#include "path_info.h"
 #include "player.h"
+#include "profiler.h"
+#include "ui.h"
 
 void debug_menu::teleport_short()
 {
@@ -44,3 +48,32 @@ void debug_menu::teleport_overmap()
     const tripoint new_pos( omt_to_om_copy( g->u.global_omt_location() ) );
     add_msg( _( "You teleport to overmap (%d,%d,%d)." ), new_pos.x, new_pos.y, new_pos.z );
 }
+
+void debug_menu::turn_profiler()
+{
+    while( true ) {
+        uimenu pmenu;
+        pmenu.return_invalid = true;
+        pmenu.text = string_format( _( "Turn profiler is %s, %ld turns recorded." ),
+                                    profiler::enabled ? _( "enabled" ) : _( "disabled" ),
+                                    profiler::turns() ) + "\n\n" + profiler::summary();
+        pmenu.addentry( 0, true, 'e', profiler::enabled ? _( "Disable" ) : _( "Enable" ) );
+        pmenu.addentry( 1, true, 'r', _( "Reset" ) );
+        pmenu.addentry( 2, true, 'w', _( "Write to %s" ), FILENAMES["profile"].c_str() );
+        pmenu.query();
+
+        switch( pmenu.ret ) {
+            case 0:
+                profiler::enabled = !profiler::enabled;
+                break;
+            case 1:
+                profiler::reset();
+                break;
+            case 2:
+                profiler::write();
+                break;
+            default:
+                return;
+        }
+    }
+}
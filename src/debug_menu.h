@@ -6,6 +6,7 @@ namespace debug_menu
 void teleport_short();
 void teleport_long();
 void teleport_overmap();
+void turn_profiler();
 
 }
 
@@ -1769,6 +1769,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                             submap *srcsm = tmpmap.get_submap_at_grid( x, y, target.z );
                             destsm->is_uniform = false;
                             srcsm->is_uniform = false;
+                            destsm->dirty = true;
 
                             for( auto &v : destsm->vehicles ) {
                                 auto &ch = g->m.access_cache( v->smz );
@@ -1796,24 +1797,17 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                                 spawns_todo++;
                             }
 
-                            for( int sx = 0; sx < 12; sx++ ) {  // copy fields
-                                for( int sy = 0; sy < 12; sy++ ) {
-                                    destsm->fld[sx][sy] = srcsm->fld[sx][sy];
-                                }
-                            }
+                            destsm->fld.swap( srcsm->fld ); // fields
                             destsm->field_count = srcsm->field_count; // and count
 
                             std::memcpy( destsm->ter, srcsm->ter, sizeof( srcsm->ter ) ); // terrain
                             std::memcpy( destsm->frn, srcsm->frn, sizeof( srcsm->frn ) ); // furniture
-                            std::memcpy( destsm->trp, srcsm->trp, sizeof( srcsm->trp ) ); // traps
-                            std::memcpy( destsm->rad, srcsm->rad, sizeof( srcsm->rad ) ); // radiation
+                            destsm->trp.swap( srcsm->trp ); // traps
+                            destsm->rad.swap( srcsm->rad ); // radiation
                             std::memcpy( destsm->lum, srcsm->lum, sizeof( srcsm->lum ) ); // emissive items
-                            for( int x = 0; x < SEEX; ++x ) {
-                                for( int y = 0; y < SEEY; ++y ) {
-                                    destsm->itm[x][y].swap( srcsm->itm[x][y] );
-                                    destsm->cosmetics[x][y].swap( srcsm->cosmetics[x][y] );
-                                }
-                            }
+                            std::swap( destsm->item_slots, srcsm->item_slots ); // items
+                            destsm->item_lists.swap( srcsm->item_lists );
+                            destsm->cosmetics.swap( srcsm->cosmetics );
 
                             // various misc variables
                             destsm->active_items = srcsm->active_items;
@@ -5,11 +5,30 @@
 #include "player.h"
 #include "translations.h"
 #include "messages.h"
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <sstream>
 
 namespace {
 std::map<efftype_id, effect_type> effect_types;
+/** Pointers into effect_types, indexed by effect_type::loadid */
+std::vector<const effect_type *> effect_types_by_loadid;
+
+void register_effect_type( const effect_type &eff )
+{
+    const auto iter = effect_types.find( eff.id );
+    if( iter != effect_types.end() ) {
+        // Keep the old loadid, it may already be cached in ids and stored in effect lists.
+        const efftype_int_id loadid = iter->second.loadid;
+        iter->second = eff;
+        iter->second.loadid = loadid;
+        return;
+    }
+    effect_type &added = effect_types.insert( std::make_pair( eff.id, eff ) ).first->second;
+    added.loadid = efftype_int_id( effect_types_by_loadid.size() );
+    effect_types_by_loadid.push_back( &added );
+}
 }
 
 template<>
@@ -30,6 +49,23 @@ bool string_id<effect_type>::is_valid() const
     return effect_types.count( *this ) > 0;
 }
 
+/** Unlike for most other types, this returns -1 for invalid ids without a debug message. */
+template<>
+efftype_int_id string_id<effect_type>::id() const
+{
+    const int cid = get_cid().to_i();
+    if( cid >= 0 && cid < static_cast<int>( effect_types_by_loadid.size() ) &&
+        effect_types_by_loadid[cid]->id == *this ) {
+        return get_cid();
+    }
+    const auto iter = effect_types.find( *this );
+    if( iter == effect_types.end() ) {
+        return efftype_int_id( -1 );
+    }
+    set_cid( iter->second.loadid );
+    return iter->second.loadid;
+}
+
 template<>
 const efftype_id string_id<effect_type>::NULL_ID( "null" );
 
@@ -321,7 +357,7 @@ bool effect_type::load_mod_data(JsonObject &jsobj, std::string member) {
     }
 }
 
-effect_type::effect_type() {}
+effect_type::effect_type() : loadid( -1 ) {}
 
 effect_rating effect_type::get_rating() const
 {
@@ -1190,13 +1226,13 @@ void load_effect_type(JsonObject &jo)
     new_etype.load_mod_data(jo, "base_mods");
     new_etype.load_mod_data(jo, "scaling_mods");
 
-    effect_types[new_etype.id] = new_etype;
-
+    register_effect_type( new_etype );
 }
 
 void reset_effect_types()
 {
     effect_types.clear();
+    effect_types_by_loadid.clear();
 }
 
 void effect_type::register_ma_buff_effect( const effect_type &eff )
@@ -1205,7 +1241,7 @@ void effect_type::register_ma_buff_effect( const effect_type &eff )
         debugmsg( "effect id %s of a martial art buff is already used as id for an effect" );
         return;
     }
-    effect_types.insert( std::make_pair( eff.id, eff ) );
+    register_effect_type( eff );
 }
 
 void effect::serialize(JsonOut &json) const
@@ -1230,3 +1266,135 @@ void effect::deserialize(JsonIn &jsin)
     intensity = jo.get_int("intensity");
     start_turn = jo.get_int("start_turn", 0);
 }
+
+effect_list::effect_list( const effect_list &other ) : type_mask( other.type_mask )
+{
+    entries.reserve( other.entries.size() );
+    for( const auto &e : other.entries ) {
+        entries.push_back( entry{ e.type, e.bp, std::unique_ptr<effect>( new effect( *e.eff ) ) } );
+    }
+}
+
+effect_list &effect_list::operator=( const effect_list &other )
+{
+    if( this != &other ) {
+        effect_list tmp( other );
+        clear();
+        entries = std::move( tmp.entries );
+        type_mask = tmp.type_mask;
+    }
+    return *this;
+}
+
+effect_list::entry_vector::iterator effect_list::lower_bound( int type, body_part bp )
+{
+    return std::lower_bound( entries.begin(), entries.end(), std::make_pair( type, bp ),
+    []( const entry & e, const std::pair<int, body_part> &key ) {
+        return e.type < key.first || ( e.type == key.first && e.bp < key.second );
+    } );
+}
+
+effect_list::entry_vector::const_iterator effect_list::lower_bound( int type, body_part bp ) const
+{
+    return const_cast<effect_list *>( this )->lower_bound( type, bp );
+}
+
+bool effect_list::has( const efftype_id &id ) const
+{
+    const int type = id.id().to_i();
+    if( type < 0 || !( type_mask & ( uint64_t( 1 ) << ( type & 63 ) ) ) ) {
+        return false;
+    }
+    // body_part values start at 0, so this is the first entry of the type if there is one.
+    const auto iter = lower_bound( type, body_part( 0 ) );
+    return iter != entries.end() && iter->type == type;
+}
+
+const effect *effect_list::find( const efftype_id &id, body_part bp ) const
+{
+    const int type = id.id().to_i();
+    if( type < 0 || !( type_mask & ( uint64_t( 1 ) << ( type & 63 ) ) ) ) {
+        return nullptr;
+    }
+    const auto iter = lower_bound( type, bp );
+    if( iter == entries.end() || iter->type != type || iter->bp != bp ) {
+        return nullptr;
+    }
+    return iter->eff.get();
+}
+
+effect *effect_list::find( const efftype_id &id, body_part bp )
+{
+    return const_cast<effect *>( const_cast<const effect_list *>( this )->find( id, bp ) );
+}
+
+effect &effect_list::set( const effect &eff )
+{
+    const effect_type *type_ptr = eff.get_effect_type();
+    const int type = type_ptr != nullptr ? type_ptr->loadid.to_i() : -1;
+    const body_part bp = eff.get_bp();
+    auto iter = lower_bound( type, bp );
+    if( iter != entries.end() && iter->type == type && iter->bp == bp ) {
+        *iter->eff = eff;
+    } else {
+        iter = entries.insert( iter, entry{ type, bp, std::unique_ptr<effect>( new effect( eff ) ) } );
+        type_mask |= uint64_t( 1 ) << ( type & 63 );
+    }
+    return *iter->eff;
+}
+
+void effect_list::erase_entries( entry_vector::iterator first, entry_vector::iterator last )
+{
+    if( iterating > 0 ) {
+        for( auto iter = first; iter != last; ++iter ) {
+            removed.push_back( std::move( iter->eff ) );
+        }
+    }
+    entries.erase( first, last );
+    update_mask();
+}
+
+bool effect_list::erase( const efftype_id &id, body_part bp )
+{
+    const int type = id.id().to_i();
+    if( type < 0 ) {
+        return false;
+    }
+    const auto iter = lower_bound( type, bp );
+    if( iter == entries.end() || iter->type != type || iter->bp != bp ) {
+        return false;
+    }
+    erase_entries( iter, std::next( iter ) );
+    return true;
+}
+
+bool effect_list::erase( const efftype_id &id )
+{
+    const int type = id.id().to_i();
+    if( type < 0 ) {
+        return false;
+    }
+    const auto first = lower_bound( type, body_part( 0 ) );
+    auto last = first;
+    while( last != entries.end() && last->type == type ) {
+        ++last;
+    }
+    if( first == last ) {
+        return false;
+    }
+    erase_entries( first, last );
+    return true;
+}
+
+void effect_list::clear()
+{
+    erase_entries( entries.begin(), entries.end() );
+}
+
+void effect_list::update_mask()
+{
+    type_mask = 0;
+    for( const auto &e : entries ) {
+        type_mask |= uint64_t( 1 ) << ( e.type & 63 );
+    }
+}
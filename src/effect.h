@@ -5,14 +5,20 @@
 #include "json.h"
 #include "enums.h"
 #include "string_id.h"
+#include "int_id.h"
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <unordered_map>
 #include <tuple>
+#include <vector>
 
 class effect_type;
 class Creature;
 class player;
 enum game_message_type : int;
 using efftype_id = string_id<effect_type>;
+using efftype_int_id = int_id<effect_type>;
 
 /** Handles the large variety of weed messages. */
 void weed_msg(player *p);
@@ -32,6 +38,8 @@ class effect_type
         effect_type();
 
         efftype_id id;
+        /** Position in the order the effect types were loaded, -1 if not loaded */
+        efftype_int_id loadid;
 
         /** Returns if an effect is good or bad for message display. */
         effect_rating get_rating() const;
@@ -262,6 +270,139 @@ class effect : public JsonSerializer, public JsonDeserializer
 
 };
 
+/**
+ * The effects on a creature, at most one per effect type and body part.
+ *
+ * Entries are kept in a flat vector sorted by the @ref effect_type::loadid of their type
+ * and their body part, so a lookup is a binary search over small integers instead of
+ * hashing the id string. A mask with one bit per type (modulo 64) answers most queries
+ * for effects the creature doesn't have without searching at all. An empty list doesn't
+ * allocate anything.
+ *
+ * The effects are allocated separately from the entries so that references to them stay
+ * valid when other effects are added or removed.
+ */
+class effect_list
+{
+    private:
+        struct entry {
+            int type;
+            body_part bp;
+            std::unique_ptr<effect> eff;
+        };
+        using entry_vector = std::vector<entry>;
+
+        template<typename It, typename V>
+        class iterator_base : public std::iterator<std::forward_iterator_tag, V>
+        {
+            public:
+                explicit iterator_base( It it ) : it( it ) {}
+                V &operator*() const {
+                    return *it->eff;
+                }
+                V *operator->() const {
+                    return it->eff.get();
+                }
+                iterator_base &operator++() {
+                    ++it;
+                    return *this;
+                }
+                bool operator==( const iterator_base &rhs ) const {
+                    return it == rhs.it;
+                }
+                bool operator!=( const iterator_base &rhs ) const {
+                    return it != rhs.it;
+                }
+            private:
+                It it;
+        };
+
+    public:
+        using iterator = iterator_base<entry_vector::iterator, effect>;
+        using const_iterator = iterator_base<entry_vector::const_iterator, const effect>;
+
+        effect_list() = default;
+        effect_list( const effect_list &other );
+        effect_list( effect_list && ) = default;
+        effect_list &operator=( const effect_list &other );
+        effect_list &operator=( effect_list && ) = default;
+
+        iterator begin() {
+            return iterator( entries.begin() );
+        }
+        iterator end() {
+            return iterator( entries.end() );
+        }
+        const_iterator begin() const {
+            return const_iterator( entries.begin() );
+        }
+        const_iterator end() const {
+            return const_iterator( entries.end() );
+        }
+        bool empty() const {
+            return entries.empty();
+        }
+        size_t size() const {
+            return entries.size();
+        }
+
+        /** Whether there is an effect of the given type on any (or no) body part. */
+        bool has( const efftype_id &id ) const;
+        /** Returns the effect of the given type on exactly that body part, or nullptr. */
+        effect *find( const efftype_id &id, body_part bp );
+        const effect *find( const efftype_id &id, body_part bp ) const;
+        /** Stores a copy of the effect, replacing the one with the same type and body part. */
+        effect &set( const effect &eff );
+        /** Removes the effect of the given type on exactly that body part. */
+        bool erase( const efftype_id &id, body_part bp );
+        /** Removes the effects of the given type on all body parts. */
+        bool erase( const efftype_id &id );
+        void clear();
+
+        /**
+         * Calls func for each effect that exists when this is called. func may add and remove
+         * effects: effects added are not visited, effects removed before being reached are
+         * skipped and an effect removed while func still uses it is kept alive until the
+         * iteration has finished.
+         */
+        template<typename F>
+        void for_each_safe( F func ) {
+            if( entries.empty() ) {
+                return;
+            }
+            std::vector<std::pair<int, body_part>> keys;
+            keys.reserve( entries.size() );
+            for( const auto &e : entries ) {
+                keys.emplace_back( e.type, e.bp );
+            }
+            iterating++;
+            for( const auto &k : keys ) {
+                const auto iter = lower_bound( k.first, k.second );
+                if( iter != entries.end() && iter->type == k.first && iter->bp == k.second ) {
+                    func( *iter->eff );
+                }
+            }
+            if( --iterating == 0 ) {
+                removed.clear();
+            }
+        }
+
+    private:
+        entry_vector::iterator lower_bound( int type, body_part bp );
+        entry_vector::const_iterator lower_bound( int type, body_part bp ) const;
+        /** Moves the effects of the entries out of the list and erases the entries */
+        void erase_entries( entry_vector::iterator first, entry_vector::iterator last );
+        void update_mask();
+
+        entry_vector entries;
+        /** Bit (type % 64) is set if there is any effect of that type */
+        uint64_t type_mask = 0;
+        /** Nesting depth of @ref for_each_safe */
+        int iterating = 0;
+        /** Effects removed during @ref for_each_safe, destroyed when it finishes */
+        std::vector<std::unique_ptr<effect>> removed;
+};
+
 void load_effect_type( JsonObject &jo );
 void reset_effect_types();
 
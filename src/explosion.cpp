@@ -14,9 +14,12 @@
 #include "sounds.h"
 #include "vehicle.h"
 #include "field.h"
-#include <queue>
+#include "turn_arena.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
 
 static const itype_id null_itype( "null" );
 
@@ -53,6 +56,98 @@ shrapnel_data load_shrapnel_data( JsonObject &jo )
     return ret;
 }
 
+namespace
+{
+
+/**
+ * The tiles a blast can reach, stored densely around its center.
+ *
+ * Force falls off by distance_factor per tile, so a blast can't get further than
+ * @ref blast_radius tiles from where it started. Cells are ordered by x, then y, then z
+ * like std::set<tripoint>, so walking them in index order visits tiles in the same order.
+ */
+class blast_area
+{
+    public:
+        static const float unreached;
+
+        blast_area( const map &m, const tripoint &center, int radius ) : m( m ) {
+            // One tile of margin around the map for the out of bounds tiles next to it.
+            const int map_end = SEEX * m.getmapsize();
+            min.x = std::min( center.x, std::max( center.x - radius, -1 ) );
+            min.y = std::min( center.y, std::max( center.y - radius, -1 ) );
+            max.x = std::max( center.x, std::min( center.x + radius, map_end ) );
+            max.y = std::max( center.y, std::min( center.y + radius, map_end ) );
+            // Blasts only get 1/3 as far vertically because of the z-level penalty.
+            const int z_radius = m.has_zlevels() ? radius / 3 + 2 : 0;
+            min.z = std::min( center.z, std::max( center.z - z_radius, -OVERMAP_DEPTH ) );
+            max.z = std::max( center.z, std::min( center.z + z_radius, OVERMAP_HEIGHT ) );
+
+            size_z = max.z - min.z + 1;
+            size_yz = ( max.y - min.y + 1 ) * size_z;
+            const size_t cells = ( max.x - min.x + 1 ) * size_yz;
+            dist.assign( cells, unreached );
+            closed.assign( cells, false );
+            passable_epoch.assign( cells, 0 );
+            passable_value.assign( cells, false );
+        }
+
+        bool contains( const tripoint &p ) const {
+            return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y &&
+                   p.z >= min.z && p.z <= max.z;
+        }
+        size_t index( const tripoint &p ) const {
+            return ( p.x - min.x ) * size_yz + ( p.y - min.y ) * size_z + ( p.z - min.z );
+        }
+        tripoint point( size_t index ) const {
+            return tripoint( min.x + index / size_yz, min.y + index % size_yz / size_z,
+                             min.z + index % size_z );
+        }
+        size_t size() const {
+            return dist.size();
+        }
+
+        /** Same as map::passable, remembered until something was destroyed */
+        bool passable( size_t index ) {
+            if( passable_epoch[index] != epoch ) {
+                passable_epoch[index] = epoch;
+                passable_value[index] = m.passable( point( index ) );
+            }
+            return passable_value[index];
+        }
+        /** Called after a bash broke something, which may have opened or blocked any tile */
+        void forget_passable() {
+            epoch++;
+        }
+
+        /** Distance from the center, or @ref unreached */
+        arena_vector<float> dist;
+        arena_vector<bool> closed;
+
+    private:
+        const map &m;
+        tripoint min;
+        tripoint max;
+        int size_z;
+        int size_yz;
+        int epoch = 1;
+        arena_vector<int> passable_epoch;
+        arena_vector<bool> passable_value;
+};
+
+const float blast_area::unreached = std::numeric_limits<float>::infinity();
+
+/** Furthest a blast of @p power can get before its force drops to 1 */
+int blast_radius( float power, float distance_factor )
+{
+    if( power <= 1.0f ) {
+        return 1;
+    }
+    return int( std::log( power ) / -std::log( distance_factor ) ) + 2;
+}
+
+} // namespace
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
 void game::do_blast( const tripoint &p, const float power,
                      const float distance_factor, const bool fire )
@@ -71,95 +166,119 @@ void game::do_blast( const tripoint &p, const float power,
 
     m.bash( p, fire ? power : ( 2 * power ), true, false, false );
 
-    std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp >
-    open;
-    std::set<tripoint> closed;
-    std::map<tripoint, float> dist_map;
-    open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
+    blast_area area( m, p, blast_radius( power, distance_factor ) );
+    // Tiles are visited by the whole number of tiles they are away from the center,
+    // steps are at least one tile long so new tiles always go into a later bucket.
+    arena_vector<arena_vector<size_t>> open( 1 );
+    open[0].push_back( area.index( p ) );
+    area.dist[area.index( p )] = 0.0f;
     // Find all points to blast
-    while( !open.empty() ) {
-        // Add some random factor to effective distance to make it look cooler
-        const float distance = open.top().first * rng_float( 1.0f, 1.2f );
-        const tripoint pt = open.top().second;
-        open.pop();
-
-        if( closed.count( pt ) != 0 ) {
-            continue;
-        }
-
-        closed.insert( pt );
-
-        const float force = power * std::pow( distance_factor, distance );
-        if( force <= 1.0f ) {
-            continue;
-        }
-
-        if( m.impassable( pt ) && pt != p ) {
-            // Don't propagate further
-            continue;
-        }
+    for( size_t bucket = 0; bucket < open.size(); bucket++ ) {
+        // Indices, as buckets are added while this one is processed
+        for( size_t entry = 0; entry < open[bucket].size(); entry++ ) {
+            const size_t pt_index = open[bucket][entry];
+            if( area.closed[pt_index] ) {
+                continue;
+            }
+            // Add some random factor to effective distance to make it look cooler
+            const float distance = area.dist[pt_index] * rng_float( 1.0f, 1.2f );
+            const tripoint pt = area.point( pt_index );
+            area.closed[pt_index] = true;
 
-        // Those will be used for making "shaped charges"
-        // Don't check up/down (for now) - this will make 2D/3D balancing easier
-        int empty_neighbors = 0;
-        for( size_t i = 0; i < 8; i++ ) {
-            tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
-            if( closed.count( dest ) == 0 && m.valid_move( pt, dest, false, true ) ) {
-                empty_neighbors++;
+            const float force = power * std::pow( distance_factor, distance );
+            if( force <= 1.0f ) {
+                continue;
             }
-        }
 
-        empty_neighbors = std::max( 1, empty_neighbors );
-        // Iterate over all neighbors. Bash all of them, propagate to some
-        for( size_t i = 0; i < max_index; i++ ) {
-            tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
-            if( closed.count( dest ) != 0 ) {
+            if( !area.passable( pt_index ) && pt != p ) {
+                // Don't propagate further
                 continue;
             }
 
-            // Up to 200% bonus for shaped charge
-            // But not if the explosion is fiery, then only half the force and no bonus
-            const float bash_force = !fire ?
-                                     force + ( 2 * force / empty_neighbors ) :
-                                     force / 2;
-            if( z_offset[i] == 0 ) {
-                // Horizontal - no floor bashing
-                m.bash( dest, bash_force, true, false, false );
-            } else if( z_offset[i] > 0 ) {
-                // Should actually bash through the floor first, but that's not really possible yet
-                m.bash( dest, bash_force, true, false, true );
-            } else if( !m.valid_move( pt, dest, false, true ) ) {
-                // Only bash through floor if it doesn't exist
-                // Bash the current tile's floor, not the one's below
-                m.bash( pt, bash_force, true, false, true );
+            // Those will be used for making "shaped charges"
+            // Don't check up/down (for now) - this will make 2D/3D balancing easier
+            // A horizontal valid_move, without the bashing and flying
+            const bool pt_inbounds = m.inbounds( pt );
+            int empty_neighbors = 0;
+            for( size_t i = 0; pt_inbounds && i < 8; i++ ) {
+                tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
+                if( !area.contains( dest ) ) {
+                    empty_neighbors += m.valid_move( pt, dest, false, true );
+                    continue;
+                }
+                const size_t dest_index = area.index( dest );
+                if( !area.closed[dest_index] && m.inbounds( dest ) && area.passable( dest_index ) ) {
+                    empty_neighbors++;
+                }
             }
 
-            float next_dist = distance;
-            next_dist += ( x_offset[i] == 0 || y_offset[i] == 0 ) ? tile_dist : diag_dist;
-            if( z_offset[i] != 0 ) {
-                if( !m.valid_move( pt, dest, false, true ) ) {
+            empty_neighbors = std::max( 1, empty_neighbors );
+            // Iterate over all neighbors. Bash all of them, propagate to some
+            for( size_t i = 0; i < max_index; i++ ) {
+                tripoint dest( pt.x + x_offset[i], pt.y + y_offset[i], pt.z + z_offset[i] );
+                const bool in_area = area.contains( dest );
+                const size_t dest_index = in_area ? area.index( dest ) : 0;
+                if( in_area && area.closed[dest_index] ) {
                     continue;
                 }
 
-                next_dist += zlev_dist;
-            }
+                // Up to 200% bonus for shaped charge
+                // But not if the explosion is fiery, then only half the force and no bonus
+                const float bash_force = !fire ?
+                                         force + ( 2 * force / empty_neighbors ) :
+                                         force / 2;
+                bash_params bashed;
+                bashed.success = false;
+                if( z_offset[i] == 0 ) {
+                    // Horizontal - no floor bashing
+                    bashed = m.bash( dest, bash_force, true, false, false );
+                } else if( z_offset[i] > 0 ) {
+                    // Should actually bash through the floor first, but that's not really possible yet
+                    bashed = m.bash( dest, bash_force, true, false, true );
+                } else if( !m.valid_move( pt, dest, false, true ) ) {
+                    // Only bash through floor if it doesn't exist
+                    // Bash the current tile's floor, not the one's below
+                    bashed = m.bash( pt, bash_force, true, false, true );
+                }
+                if( bashed.success ) {
+                    area.forget_passable();
+                }
+
+                if( !in_area ) {
+                    // Too far away for the blast to get there
+                    continue;
+                }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
-                open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                float next_dist = distance;
+                next_dist += ( x_offset[i] == 0 || y_offset[i] == 0 ) ? tile_dist : diag_dist;
+                if( z_offset[i] != 0 ) {
+                    if( !m.valid_move( pt, dest, false, true ) ) {
+                        continue;
+                    }
+
+                    next_dist += zlev_dist;
+                }
+
+                if( area.dist[dest_index] > next_dist ) {
+                    area.dist[dest_index] = next_dist;
+                    const size_t next_bucket = std::max( size_t( next_dist ), bucket + 1 );
+                    if( next_bucket >= open.size() ) {
+                        open.resize( next_bucket + 1 );
+                    }
+                    open[next_bucket].push_back( dest_index );
+                }
             }
         }
     }
 
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( auto &pt : closed ) {
-        if( m.impassable( pt ) ) {
+    for( size_t i = 0; i < area.size(); i++ ) {
+        if( !area.closed[i] || !area.passable( i ) ) {
             continue;
         }
 
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = power * std::pow( distance_factor, area.dist[i] );
         nc_color col = c_red;
         if( force < 10 ) {
             col = c_white;
@@ -167,13 +286,17 @@ void game::do_blast( const tripoint &p, const float power,
             col = c_yellow;
         }
 
-        explosion_colors[pt] = col;
+        explosion_colors.emplace_hint( explosion_colors.end(), area.point( i ), col );
     }
 
     draw_custom_explosion( u.pos(), explosion_colors );
 
-    for( const tripoint &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+    for( size_t i = 0; i < area.size(); i++ ) {
+        if( !area.closed[i] ) {
+            continue;
+        }
+        const tripoint pt = area.point( i );
+        const float force = power * std::pow( distance_factor, area.dist[i] );
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -325,7 +448,7 @@ std::unordered_map<tripoint, std::pair<int, int>> game::explosion( const tripoin
 
             // Truncate to a random selection
             int qty = shr.count * std::min( shr.recovery, 100 ) / 100;
-            std::random_shuffle( tiles.begin(), tiles.end() );
+            std::shuffle( tiles.begin(), tiles.end(), rng_get_engine() );
             tiles.resize( std::min( int( tiles.size() ), qty ) );
 
             for( const auto &e : tiles ) {
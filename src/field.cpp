@@ -17,6 +17,7 @@
 #include "submap.h"
 #include "mapdata.h"
 #include "mtype.h"
+#include "profiler.h"
 #include "scent_map.h"
 
 #include <queue>
@@ -466,6 +467,7 @@ field_id field_from_ident(const std::string &field_ident)
 
 bool map::process_fields()
 {
+    profiler::scoped_timer timer( profiler::PROF_FIELDS );
     bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
@@ -717,6 +719,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
     tripoint thep;
     thep.z = submap_z;
 
+    // Fields age (at least) every time they're processed
+    current_submap->dirty = true;
+
     // Initialize the map tile wrapper
     maptile map_tile( current_submap, 0, 0 );
     size_t &locx = map_tile.x;
@@ -732,7 +737,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
             const tripoint &p = thep;
             // Get a reference to the field variable from the submap;
             // contains all the pointers to the real field effects.
-            field &curfield = current_submap->fld[locx][locy];
+            field &curfield = current_submap->fld.get_mutable( locx, locy );
             for( auto it = curfield.begin(); it != curfield.end();) {
                 //Iterating through all field effects in the submap's field.
                 field_entry * cur = &it->second;
@@ -11,6 +11,7 @@
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <fstream>
 
 // FILE I/O
 #include <sys/stat.h>
@@ -275,6 +276,36 @@ std::vector<std::string> get_files_from_path(std::string const &pattern,
     });
 }
 
+//--------------------------------------------------------------------------------------------------
+bool copy_directory(std::string const &source_path, std::string const &dest_path)
+{
+    if (!assure_dir_exist(dest_path)) {
+        return false;
+    }
+    // Directories are listed before their contents.
+    auto const paths = find_file_if_bfs(source_path, true, [](dirent const &, bool) {
+        return true;
+    });
+    for (auto const &path : paths) {
+        auto const target = dest_path + path.substr(source_path.size());
+        if (is_directory_stat(path)) {
+            if (!assure_dir_exist(target)) {
+                return false;
+            }
+            continue;
+        }
+        std::ifstream src(path.c_str(), std::ios::binary);
+        std::ofstream dst(target.c_str(), std::ios::binary);
+        // Streaming an empty file counts as a failed write.
+        auto const empty = src && src.peek() == std::ifstream::traits_type::eof();
+        if (!src || !dst || (!empty && !(dst << src.rdbuf()))) {
+            DebugLog(D_WARNING, D_MAIN) << "copying [" << path << "] to [" << target << "] failed.";
+            return false;
+        }
+    }
+    return true;
+}
+
 /** Find directories which containing pattern.
   * @param pattern Search pattern.
   * @param root_path Search root.
@@ -11,6 +11,9 @@ bool file_exist( const std::string &path );
 bool remove_file( const std::string &path );
 // Rename a file, overriding the target!
 bool rename_file( const std::string &old_path, const std::string &new_path );
+// Copy all files and directories below source_path to dest_path, which is created if needed.
+// Returns true on success.
+bool copy_directory( const std::string &source_path, const std::string &dest_path );
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -89,6 +89,9 @@
 #include "scent_map.h"
 #include "safemode_ui.h"
 #include "game_constants.h"
+#include "profiler.h"
+#include "replay.h"
+#include "turn_arena.h"
 
 #include <map>
 #include <set>
@@ -166,6 +169,32 @@ const efftype_id effect_tied( "tied" );
 const efftype_id effect_visuals( "visuals" );
 const efftype_id effect_winded( "winded" );
 
+const trait_id trait_CANNIBAL( "CANNIBAL" );
+const trait_id trait_CLUMSY( "CLUMSY" );
+const trait_id trait_DEBUG_NIGHTVISION( "DEBUG_NIGHTVISION" );
+const trait_id trait_DEBUG_NOSCENT( "DEBUG_NOSCENT" );
+const trait_id trait_DEBUG_SILENT( "DEBUG_SILENT" );
+const trait_id trait_HYPEROPIC( "HYPEROPIC" );
+const trait_id trait_ILLITERATE( "ILLITERATE" );
+const trait_id trait_INCONSPICUOUS( "INCONSPICUOUS" );
+const trait_id trait_INFIMMUNE( "INFIMMUNE" );
+const trait_id trait_INFRESIST( "INFRESIST" );
+const trait_id trait_LEG_TENTACLES( "LEG_TENTACLES" );
+const trait_id trait_LEG_TENT_BRACE( "LEG_TENT_BRACE" );
+const trait_id trait_LIGHTSTEP( "LIGHTSTEP" );
+const trait_id trait_M_DEFENDER( "M_DEFENDER" );
+const trait_id trait_PARKOUR( "PARKOUR" );
+const trait_id trait_PER_SLIME( "PER_SLIME" );
+const trait_id trait_PER_SLIME_OK( "PER_SLIME_OK" );
+const trait_id trait_PRED2( "PRED2" );
+const trait_id trait_PRED3( "PRED3" );
+const trait_id trait_PRED4( "PRED4" );
+const trait_id trait_PSYCHOPATH( "PSYCHOPATH" );
+const trait_id trait_SELFAWARE( "SELFAWARE" );
+const trait_id trait_VINES2( "VINES2" );
+const trait_id trait_VINES3( "VINES3" );
+const trait_id trait_WEB_RAPPEL( "WEB_RAPPEL" );
+
 void advanced_inv(); // player_activity.cpp
 void intro();
 
@@ -780,7 +809,7 @@ bool game::start_game(std::string worldname)
         gamemode.reset( new special_game() );
     }
 
-    seed = rand();
+    seed = rng_bits();
     new_game = true;
     start_calendar();
     nextweather = calendar::turn;
@@ -1037,7 +1066,7 @@ bool game::cleanup_at_end()
 
         if (u.has_amount("holybook_bible1", 1) || u.has_amount("holybook_bible2", 1) ||
             u.has_amount("holybook_bible3", 1)) {
-            if (!(u.has_trait("CANNIBAL") || u.has_trait("PSYCHOPATH"))) {
+            if (!(u.has_trait( trait_CANNIBAL ) || u.has_trait( trait_PSYCHOPATH ))) {
                 vRip.push_back("               _______  ___");
                 vRip.push_back("              <       `/   |");
                 vRip.push_back("               >  _     _ (");
@@ -1435,13 +1464,17 @@ bool game::do_turn()
         !u.is_dead_state()) {
         autosave();
     }
+    MAPBUFFER.trim( get_option<int>( "MAP_BUFFER_SIZE" ) );
+    // The reality bubble reaches about 3 overmap terrains around the player, start a
+    // bit earlier so the next overmap is there before its submaps are needed.
+    overmap_buffer.prepare_adjacent( u.global_omt_location(), 8 );
 
     update_weather();
     reset_light_level();
 
     // The following happens when we stay still; 10/40 minutes overdue for spawn
-    if ((!u.has_trait("INCONSPICUOUS") && calendar::turn > nextspawn + 100) ||
-        (u.has_trait("INCONSPICUOUS") && calendar::turn > nextspawn + 400)) {
+    if ((!u.has_trait( trait_INCONSPICUOUS ) && calendar::turn > nextspawn + 100) ||
+        (u.has_trait( trait_INCONSPICUOUS ) && calendar::turn > nextspawn + 400)) {
         spawn_mon(-1 + 2 * rng(0, 1), -1 + 2 * rng(0, 1));
         nextspawn = calendar::turn;
     }
@@ -1500,7 +1533,7 @@ bool game::do_turn()
 
     // No-scent debug mutation has to be processed here or else it takes time to start working
     if( !u.has_active_bionic( "bio_scent_mask" ) &&
-        !u.has_trait( "DEBUG_NOSCENT" ) ) {
+        !u.has_trait( trait_DEBUG_NOSCENT ) ) {
         scent.set( u.pos(), u.scent );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
@@ -1537,6 +1570,7 @@ bool game::do_turn()
     // consider a stripped down cache just for monsters.
     m.build_map_cache( get_levz(), true );
     monmove();
+    npcmove();
     update_stair_monsters();
     u.process_turn();
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
@@ -1570,6 +1604,10 @@ bool game::do_turn()
     sfx::do_danger_music();
     sfx::do_fatigue();
 
+    replay::end_turn();
+    profiler::end_turn();
+    turn_arena::end_turn();
+
     return false;
 }
 
@@ -1593,9 +1631,9 @@ void game::rustCheck()
         }
 
         if (aSkill.is_combat_skill() &&
-            ((u.has_trait("PRED2") && one_in(4)) ||
-             (u.has_trait("PRED3") && one_in(2)) ||
-             (u.has_trait("PRED4") && x_in_y(2, 3)))) {
+            ((u.has_trait( trait_PRED2 ) && one_in(4)) ||
+             (u.has_trait( trait_PRED3 ) && one_in(2)) ||
+             (u.has_trait( trait_PRED4 ) && x_in_y(2, 3)))) {
             // Their brain is optimized to remember this
             if (one_in(15600)) {
                 // They've already passed the roll to avoid rust at
@@ -3699,6 +3737,7 @@ void game::load(std::string worldname, std::string name)
 
     u.reset();
     draw();
+    replay::begin_recording( worldname, name );
 }
 
 void game::load_world_modfiles(WORLDPTR world)
@@ -4039,6 +4078,7 @@ void game::debug()
                        _( "Overmap editor" ),         // 30
                        _( "Draw benchmark (5 seconds)" ),    // 31
                        _( "Teleport - Adjacent overmap" ),   // 32
+                       _( "Turn profiler" ),          // 33
                        _( "Cancel" ),
                        NULL );
     int veh_num;
@@ -4707,6 +4747,10 @@ void game::debug()
         case 32:
             debug_menu::teleport_overmap();
             break;
+
+        case 33:
+            debug_menu::turn_profiler();
+            break;
     }
     erase();
     refresh_all();
@@ -5449,7 +5493,7 @@ void game::draw_HP()
     int hpy = wide ? 0 : 1;
     int dy = wide ? 1 : 2;
 
-    bool const is_self_aware = u.has_trait("SELFAWARE");
+    bool const is_self_aware = u.has_trait( trait_SELFAWARE );
 
     for (int i = 0; i < num_hp_parts; i++) {
         auto const &hp = get_hp_bar(u.hp_cur[i], u.hp_max[i]);
@@ -5990,7 +6034,7 @@ int game::mon_info(WINDOW *w)
             if (!new_seen_mon.empty()) {
                 monster &critter = critter_tracker->find(new_seen_mon.back());
                 cancel_activity_query(_("%s spotted!"), critter.name().c_str());
-                if (u.has_trait("M_DEFENDER") && critter.type->in_species( PLANT )) {
+                if (u.has_trait( trait_M_DEFENDER ) && critter.type->in_species( PLANT )) {
                     add_msg(m_warning, _("We have detected a %s."), critter.name().c_str());
                     if (!u.has_effect( effect_adrenaline_mycus)){
                         u.add_effect( effect_adrenaline_mycus, 300 );
@@ -6190,6 +6234,7 @@ void game::cleanup_dead()
 
 void game::monmove()
 {
+    profiler::scoped_timer timer( profiler::PROF_MONMOVE );
     cleanup_dead();
 
     // Make sure these don't match the first time around.
@@ -6292,8 +6337,11 @@ void game::monmove()
             i++;
         }
     }
+}
 
-    // Now, do active NPCs.
+void game::npcmove()
+{
+    profiler::scoped_timer timer( profiler::PROF_NPCMOVE );
     for( auto np : active_npc ) {
         if( np->is_dead() ) {
             continue;
@@ -6344,11 +6392,11 @@ void game::flashbang( const tripoint &p, bool player_immune)
         }
         if( m.sees( u.pos(), p, 8 ) ) {
             int flash_mod = 0;
-            if( u.has_trait( "PER_SLIME" ) ) {
+            if( u.has_trait( trait_PER_SLIME ) ) {
                 if (one_in(2)) {
                     flash_mod = 3; // Yay, you weren't looking!
                 }
-            } else if( u.has_trait( "PER_SLIME_OK" ) ) {
+            } else if( u.has_trait( trait_PER_SLIME_OK ) ) {
                 flash_mod = 8; // Just retract those and extrude fresh eyes
             } else if( u.has_bionic( "bio_sunglasses" ) || u.is_wearing( "rm13_armor_on" ) ) {
                 flash_mod = 6;
@@ -6397,7 +6445,7 @@ void game::shockwave( const tripoint &p, int radius, int force, int stun, int da
         }
     }
     if( rl_dist(u.pos(), p ) <= radius && !ignore_player &&
-          (!u.has_trait( "LEG_TENT_BRACE" ) || u.footwear_factor() == 1 ||
+          (!u.has_trait( trait_LEG_TENT_BRACE ) || u.footwear_factor() == 1 ||
           (u.footwear_factor() == .5 && one_in( 2 ) ) ) ) {
         add_msg( m_bad, _("You're caught in the shockwave!") );
         knockback( p, u.pos(), force, stun, dam_mult);
@@ -6552,7 +6600,7 @@ void game::knockback( std::vector<tripoint> &traj, int force, int stun, int dam_
                                 targ->name.c_str());
                     }
                 } else if (u.posx() == traj.front().x && u.posy() == traj.front().y &&
-                           (u.has_trait("LEG_TENT_BRACE") && (!u.footwear_factor() ||
+                           (u.has_trait( trait_LEG_TENT_BRACE ) && (!u.footwear_factor() ||
                             (u.footwear_factor() == .5 && one_in(2))))) {
                     add_msg(_("%s collided with you, and barely dislodges your tentacles!"), targ->name.c_str());
                     force_remaining = 1;
@@ -6647,7 +6695,7 @@ void game::knockback( std::vector<tripoint> &traj, int force, int stun, int dam_
 
 void game::use_computer( const tripoint &p )
 {
-    if (u.has_trait("ILLITERATE")) {
+    if (u.has_trait( trait_ILLITERATE )) {
         add_msg(m_info, _("You can not read a computer screen!"));
         return;
     }
@@ -6656,7 +6704,7 @@ void game::use_computer( const tripoint &p )
         add_msg( m_info, _( "You can not see a computer screen!" ) );
         return;
     }
-    if (u.has_trait("HYPEROPIC") && !u.is_wearing("glasses_reading")
+    if (u.has_trait( trait_HYPEROPIC ) && !u.is_wearing("glasses_reading")
         && !u.is_wearing("glasses_bifocal") && !u.has_effect( effect_contacts)) {
         add_msg(m_info, _("You'll need to put on reading glasses before you can see the screen."));
         return;
@@ -8829,7 +8877,7 @@ tripoint game::look_around( WINDOW *w_info, const tripoint &start_point,
     bVMonsterLookFire = false;
     // TODO: Make this `true`
     const bool allow_zlev_move = m.has_zlevels() &&
-        ( debug_mode || fov_3d || u.has_trait( "DEBUG_NIGHTVISION" ) );
+        ( debug_mode || fov_3d || u.has_trait( trait_DEBUG_NIGHTVISION ) );
 
     temp_exit_fullscreen();
 
@@ -12020,7 +12068,7 @@ bool game::walk_move( const tripoint &dest_loc )
 
     // Print a message if movement is slow
     const int mcost_to = m.move_cost( dest_loc ); //calculate this _after_ calling grabbed_move
-    const bool slowed = ( !u.has_trait( "PARKOUR" ) && ( mcost_to > 2 || mcost_from > 2 ) ) ||
+    const bool slowed = ( !u.has_trait( trait_PARKOUR ) && ( mcost_to > 2 || mcost_from > 2 ) ) ||
                   mcost_to > 4 || mcost_from > 4;
     if( slowed ) {
         // Unless u.pos() has a higher movecost than dest_loc, state that dest_loc is the cause
@@ -12042,7 +12090,7 @@ bool game::walk_move( const tripoint &dest_loc )
         sfx::play_variant_sound( "plmove", "clear_obstacle", sfx::get_heard_volume(u.pos()) );
     }
 
-    if( u.has_trait( "LEG_TENT_BRACE" ) && ( !u.footwear_factor() ||
+    if( u.has_trait( trait_LEG_TENT_BRACE ) && ( !u.footwear_factor() ||
                                              ( u.footwear_factor() == .5 && one_in( 2 ) ) ) ) {
         // DX and IN are long suits for Cephalopods,
         // so this shouldn't cause too much hardship
@@ -12057,12 +12105,12 @@ bool game::walk_move( const tripoint &dest_loc )
         }
     }
 
-    if( !u.has_artifact_with( AEP_STEALTH ) && !u.has_trait( "DEBUG_SILENT" ) ) {
-        if( !u.has_trait( "LEG_TENTACLES" ) ) {
-            if( u.has_trait("LIGHTSTEP") || u.is_wearing( "rm13_armor_on" ) ) {
+    if( !u.has_artifact_with( AEP_STEALTH ) && !u.has_trait( trait_DEBUG_SILENT ) ) {
+        if( !u.has_trait( trait_LEG_TENTACLES ) ) {
+            if( u.has_trait( trait_LIGHTSTEP ) || u.is_wearing( "rm13_armor_on" ) ) {
                 sounds::sound( dest_loc, 2, "", true, "none", "none" );    // Sound of footsteps may awaken nearby monsters
                 sfx::do_footstep();
-            } else if( u.has_trait( "CLUMSY" ) ) {
+            } else if( u.has_trait( trait_CLUMSY ) ) {
                 sounds::sound( dest_loc, 10, "", true, "none", "none" );
                 sfx::do_footstep();
             } else if( u.has_bionic( "bio_ankles" ) ) {
@@ -12123,16 +12171,16 @@ void game::place_player( const tripoint &dest_loc )
     }
     ///\EFFECT_DEX increases chance of avoiding cuts on sharp terrain
     if( m.has_flag("SHARP", dest_loc) && !one_in(3) && !x_in_y(1+u.dex_cur/2, 40) &&
-        (!u.in_vehicle) && (!u.has_trait("PARKOUR") || one_in(4)) ) {
+        (!u.in_vehicle) && (!u.has_trait( trait_PARKOUR ) || one_in(4)) ) {
         body_part bp = random_body_part();
         if(u.deal_damage( nullptr, bp, damage_instance( DT_CUT, rng( 1, 10 ) ) ).total_damage() > 0) {
             //~ 1$s - bodypart name in accusative, 2$s is terrain name.
             add_msg(m_bad, _("You cut your %1$s on the %2$s!"),
                     body_part_name_accusative(bp).c_str(),
                     m.has_flag_ter( "SHARP", dest_loc ) ? m.tername(dest_loc).c_str() : m.furnname(dest_loc).c_str() );
-            if ((u.has_trait("INFRESIST")) && (one_in(1024))) {
+            if ((u.has_trait( trait_INFRESIST )) && (one_in(1024))) {
             u.add_effect( effect_tetanus, 1, num_bp, true);
-            } else if ((!u.has_trait("INFIMMUNE") || !u.has_trait("INFRESIST")) && (one_in(256))) {
+            } else if ((!u.has_trait( trait_INFIMMUNE ) || !u.has_trait( trait_INFRESIST )) && (one_in(256))) {
               u.add_effect( effect_tetanus, 1, num_bp, true);
              }
         }
@@ -12432,7 +12480,7 @@ bool game::grabbed_veh_move( const tripoint &dp )
         return true; // No shoving around an RV.
     }
 
-    const auto &wheel_indices = grabbed_vehicle->wheelcache;
+    const auto &wheel_indices = grabbed_vehicle->parts_with_flag( VPFLAG_WHEEL );
     // If vehicle weighs too much, wheels don't provide a bonus.
     if( grabbed_vehicle->valid_wheel_config( false ) && str_req <= 40 ) {
         //determine movecost for terrain touching wheels
@@ -13303,7 +13351,7 @@ tripoint game::find_or_make_stairs( map &mp, const int z_after, bool &rope_ladde
         return tripoint_min;
     }
 
-    if( u.has_trait( "WEB_RAPPEL" ) ) {
+    if( u.has_trait( trait_WEB_RAPPEL ) ) {
         if (query_yn(_("There is a sheer drop halfway down. Web-descend?"))) {
             rope_ladder = true;
             if ((rng(4, 8)) < u.get_skill_level( skill_dodge )) {
@@ -13314,9 +13362,9 @@ tripoint game::find_or_make_stairs( map &mp, const int z_after, bool &rope_ladde
         } else {
             return tripoint_min;
         }
-    } else if (u.has_trait("VINES2") || u.has_trait("VINES3")) {
+    } else if (u.has_trait( trait_VINES2 ) || u.has_trait( trait_VINES3 )) {
         if (query_yn(_("There is a sheer drop halfway down.  Use your vines to descend?"))) {
-            if (u.has_trait("VINES2")) {
+            if (u.has_trait( trait_VINES2 )) {
                 if (query_yn(_("Detach a vine?  It'll hurt, but you'll be able to climb back up..."))) {
                     rope_ladder = true;
                     add_msg(m_bad, _("You descend on your vines, though leaving a part of you behind stings."));
@@ -13694,7 +13742,7 @@ void game::update_stair_monsters()
                 if ((pushx != 0 || pushy != 0) && (mon_at(pos) == -1) &&
                     critter.can_move_to( pos )) {
                     bool resiststhrow = (u.is_throw_immune()) ||
-                                        (u.has_trait("LEG_TENT_BRACE"));
+                                        (u.has_trait( trait_LEG_TENT_BRACE ));
                     if (resiststhrow && one_in(player_throw_resist_chance)) {
                         u.moves -= 25; // small charge for avoiding the push altogether
                         add_msg(_("The %s fails to push you back!"),
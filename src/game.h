@@ -197,6 +197,25 @@ class game
         /** write statisics to stdout and @return true if sucessful */
         bool dump_stats( const std::string& what, dump_mode mode, const std::vector<std::string> &opts );
 
+        /**
+         *  Run turns headlessly with the player waiting and write per-phase timings to stdout
+         *  @param scenario preset describing what to spawn around the player
+         *  @param turns number of turns to simulate
+         *  @param world load first save of this world instead of generating a new one (optional)
+         *  @param opts overrides for the scenario preset in the form key=value
+         *  @return true if the benchmark ran to completion
+         */
+        bool run_benchmark( const std::string &scenario, int turns, const std::string &world,
+                            const std::vector<std::string> &opts );
+
+        /**
+         *  Replay a recording (see @ref replay) headlessly and write timings to stdout
+         *  @param path recording loaded with @ref replay::load, its world copy is next to it
+         *  @param verify_interval compare the game state with the recording every this many turns
+         *  @return true if the game state matched the recording on every compared turn
+         */
+        bool run_replay( const std::string &path, int verify_interval );
+
         /** Returns false if saving failed. */
         bool save();
         /** Deletes the given world. If delete_folder is true delete all the files and directories
@@ -883,6 +902,7 @@ private:
         // Routine loop functions, approximately in order of execution
         void cleanup_dead();     // Delete any dead NPCs/monsters
         void monmove();          // Monster movement
+        void npcmove();          // Active NPC movement
         void rustCheck();        // Degrades practice levels
         void process_events();   // Processes and enacts long-term events
         void process_activity(); // Processes and enacts the player's activity
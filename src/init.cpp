@@ -95,8 +95,7 @@ bool DynamicDataLoader::load_deferred( deferred_json& data )
         auto it = data.begin();
         for( size_t idx = 0; idx != n; ++idx ) {
             try {
-                std::istringstream str( it->first );
-                JsonIn jsin( str );
+                JsonIn jsin( it->first );
                 JsonObject jo = jsin.get_object();
                 load_object( jo, it->second );
             } catch( const std::exception &err ) {
@@ -265,15 +264,13 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
         // open the file as a stream
         std::ifstream infile(file.c_str(), std::ifstream::in | std::ifstream::binary);
         // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                (std::istreambuf_iterator<char>(infile)),
-                std::istreambuf_iterator<char>()
-            )
+        const std::string content(
+            (std::istreambuf_iterator<char>(infile)),
+            std::istreambuf_iterator<char>()
         );
         try {
-            // parse it
-            JsonIn jsin(iss);
+            // parse it in place
+            JsonIn jsin( content );
             load_all_from_json( jsin, src );
         } catch( const JsonError &err ) {
             throw std::runtime_error( file + ": " + err.what() );
@@ -11,6 +11,7 @@
 #include "catacharset.h"
 #include "cata_utility.h"
 #include "options.h"
+#include "replay.h"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -693,7 +694,10 @@ const std::string &input_context::handle_input()
 {
     next_action.type = CATA_INPUT_ERROR;
     while( 1 ) {
-        next_action = inp_mngr.get_input_event( NULL );
+        if( !replay::next_input_event( next_action, inp_mngr.previously_pressed_key ) ) {
+            next_action = inp_mngr.get_input_event( NULL );
+            replay::record_input_event( next_action, inp_mngr.previously_pressed_key );
+        }
         if( next_action.type == CATA_INPUT_TIMEOUT ) {
             return TIMEOUT;
         }
@@ -34,6 +34,7 @@ inventory::inventory()
 
 invslice inventory::slice()
 {
+    invalidate_aggregates();
     invslice stacks;
     for( auto &elem : items ) {
         stacks.push_back( &elem );
@@ -147,6 +148,9 @@ void inventory::sort()
 void inventory::clear()
 {
     items.clear();
+    cached_weight = 0;
+    cached_volume = 0;
+    aggregates_valid = true;
 }
 
 void inventory::add_stack(const std::list<item> newits)
@@ -164,6 +168,7 @@ void inventory::clone_stack (const std::list<item> &rhs)
     std::list<item> newstack;
     for( const auto &rh : rhs ) {
         newstack.push_back( rh );
+        count_in_aggregates( rh, 1 );
     }
     items.push_back(newstack);
 }
@@ -274,11 +279,15 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
     for( auto &elem : items ) {
         std::list<item>::iterator it_ref = elem.begin();
         if( it_ref->stacks_with( newit ) ) {
+            count_in_aggregates( *it_ref, -1 );
             if( it_ref->merge_charges( newit ) ) {
+                count_in_aggregates( *it_ref, 1 );
                 return *it_ref;
             }
+            count_in_aggregates( *it_ref, 1 );
             newit.invlet = it_ref->invlet;
             elem.push_back( newit );
+            count_in_aggregates( newit, 1 );
             return elem.back();
         } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
             // If keep_invlet is true, we'll be forcing other items out of their current invlet.
@@ -294,6 +303,7 @@ item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
     std::list<item> newstack;
     newstack.push_back(newit);
     items.push_back(newstack);
+    count_in_aggregates( newit, 1 );
     return items.back().back();
 }
 
@@ -318,6 +328,7 @@ void inventory::restack(player *p)
     if (!p) {
         return;
     }
+    invalidate_aggregates();
 
     std::list<item> to_restack;
     int idx = 0;
@@ -381,7 +392,7 @@ static long count_charges_in_list(const itype *type, const map_stack &items)
 
 void inventory::form_from_map( const tripoint &origin, int range, bool assign_invlet )
 {
-    items.clear();
+    clear();
     for( const tripoint &p : g->m.points_in_radius( origin, range ) ) {
         if (g->m.has_furn( p ) && g->m.accessible_furniture( origin, p, range )) {
             const furn_t &f = g->m.furn( p ).obj();
@@ -555,6 +566,9 @@ std::list<item> inventory::reduce_stack_internal(const Locator &locator, int qua
             if(quantity >= (int)iter->size() || quantity < 0) {
                 ret = *iter;
                 items.erase(iter);
+                for( const item &it : ret ) {
+                    count_in_aggregates( it, -1 );
+                }
             } else {
                 for(int i = 0 ; i < quantity ; i++) {
                     ret.push_back(remove_item(&iter->front()));
@@ -605,6 +619,7 @@ item inventory::remove_item_internal(const Locator &locator)
             if (iter->empty()) {
                 items.erase(iter);
             }
+            count_in_aggregates( ret, -1 );
             return ret;
         }
         ++pos;
@@ -637,6 +652,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
             }
         }
         volume_dropped += chosen_item->volume();
+        count_in_aggregates( *chosen_item, -1 );
         result.push_back( std::move( *chosen_item ) );
         chosen_item = chosen_stack->erase( chosen_item );
         if( chosen_item == chosen_stack->begin() && !chosen_stack->empty() ) {
@@ -652,6 +668,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
 
 void inventory::dump(std::vector<item *> &dest)
 {
+    invalidate_aggregates();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             dest.push_back( &( elem_stack_iter ) );
@@ -673,6 +690,7 @@ const item &inventory::find_item(int position) const
 
 item &inventory::find_item(int position)
 {
+    invalidate_aggregates();
     return const_cast<item&>( const_cast<const inventory*>(this)->find_item( position ) );
 }
 
@@ -704,6 +722,7 @@ int inventory::position_by_item( const item *it ) const
 
 item &inventory::item_by_type(itype_id type)
 {
+    invalidate_aggregates();
     for( auto &elem : items ) {
         if( elem.front().typeId() == type ) {
             return elem.front();
@@ -725,6 +744,7 @@ int inventory::position_by_type(itype_id type)
 }
 item &inventory::item_or_container(itype_id type)
 {
+    invalidate_aggregates();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             if( elem_stack_iter.typeId() == type ) {
@@ -742,6 +762,7 @@ item &inventory::item_or_container(itype_id type)
 
 std::vector<std::pair<item *, int> > inventory::all_items_by_type(itype_id type)
 {
+    invalidate_aggregates();
     std::vector<std::pair<item *, int> > ret;
     int i = 0;
     for( auto &elem : items ) {
@@ -759,6 +780,7 @@ std::list<item> inventory::use_amount(itype_id it, int _quantity)
 {
     long quantity = _quantity; // Don't wanny change the function signature right now
     sort();
+    invalidate_aggregates();
     std::list<item> ret;
     for (invstack::iterator iter = items.begin(); iter != items.end() && quantity > 0; /* noop */) {
         for (std::list<item>::iterator stack_iter = iter->begin();
@@ -840,6 +862,7 @@ bool inventory::has_enough_painkiller(int pain) const
 
 item *inventory::most_appropriate_painkiller(int pain)
 {
+    invalidate_aggregates();
     int difference = 9999;
     item *ret = &nullitem;
     for( auto &elem : items ) {
@@ -867,6 +890,7 @@ item *inventory::most_appropriate_painkiller(int pain)
 
 item *inventory::best_for_melee( player &p, double &best )
 {
+    invalidate_aggregates();
     item *ret = &nullitem;
     for( auto &elem : items ) {
         auto score = p.melee_value( elem.front() );
@@ -881,6 +905,7 @@ item *inventory::best_for_melee( player &p, double &best )
 
 item *inventory::most_loaded_gun()
 {
+    invalidate_aggregates();
     item *ret = &nullitem;
     int max = 0;
     for( auto &elem : items ) {
@@ -908,6 +933,7 @@ item *inventory::most_loaded_gun()
 
 void inventory::rust_iron_items()
 {
+    invalidate_aggregates();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             if( elem_stack_iter.made_of( material_id( "iron" ) ) &&
@@ -920,30 +946,74 @@ void inventory::rust_iron_items()
     }
 }
 
-int inventory::weight() const
+void inventory::count_in_aggregates( const item &it, int sign )
 {
-    int ret = 0;
-    for( const auto &elem : items ) {
-        for( const auto &elem_stack_iter : elem ) {
-            ret += elem_stack_iter.weight();
-        }
+    if( aggregates_valid ) {
+        cached_weight += sign * it.weight();
+        cached_volume += sign * it.volume();
     }
-    return ret;
 }
 
-units::volume inventory::volume() const
+void inventory::invalidate_aggregates()
+{
+    aggregates_valid = false;
+}
+
+void inventory::update_aggregates() const
 {
-    units::volume ret = 0;
+    if( aggregates_valid ) {
+        return;
+    }
+    cached_weight = 0;
+    cached_volume = 0;
     for( const auto &elem : items ) {
         for( const auto &elem_stack_iter : elem ) {
-            ret += elem_stack_iter.volume();
+            cached_weight += elem_stack_iter.weight();
+            cached_volume += elem_stack_iter.volume();
         }
     }
-    return ret;
+    aggregates_valid = true;
+}
+
+bool inventory::verify_aggregates() const
+{
+    if( !aggregates_valid ) {
+        return true;
+    }
+    const int weight = cached_weight;
+    const units::volume volume = cached_volume;
+    aggregates_valid = false;
+    update_aggregates();
+    if( weight != cached_weight || volume != cached_volume ) {
+        debugmsg( "Cached inventory weight %d / volume %d ml don't match the actual %d / %d ml",
+                  weight, units::to_milliliter( volume ), cached_weight,
+                  units::to_milliliter( cached_volume ) );
+        return false;
+    }
+    return true;
+}
+
+int inventory::weight() const
+{
+#ifdef DEBUG_INVENTORY_AGGREGATES
+    verify_aggregates();
+#endif
+    update_aggregates();
+    return cached_weight;
+}
+
+units::volume inventory::volume() const
+{
+#ifdef DEBUG_INVENTORY_AGGREGATES
+    verify_aggregates();
+#endif
+    update_aggregates();
+    return cached_volume;
 }
 
 std::vector<item *> inventory::active_items()
 {
+    invalidate_aggregates();
     std::vector<item *> ret;
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
@@ -150,8 +150,23 @@ class inventory : public visitable<inventory>
 
         void rust_iron_items();
 
+        /**
+         * Sum of the weight / volume of all items. Both are cached: methods adding or removing
+         * items keep them up to date, anything else that gives out non-const access to the
+         * items makes them get recalculated on the next call.
+         */
         int weight() const;
         units::volume volume() const;
+        /**
+         * Forgets the cached @ref weight and @ref volume. Has to be called after changing an
+         * item through a reference that was obtained before.
+         */
+        void invalidate_aggregates();
+        /**
+         * Recalculates @ref weight and @ref volume and reports a mismatch with the cached
+         * values. Returns whether they matched.
+         */
+        bool verify_aggregates() const;
 
         void dump(std::vector<item *> &dest); // dumps contents into dest (does not delete contents)
 
@@ -184,8 +199,16 @@ class inventory : public visitable<inventory>
         template<typename Locator> item remove_item_internal(const Locator &locator);
         template<typename Locator> std::list<item> reduce_stack_internal(const Locator &type, int amount);
 
+        /** Adds (or with sign -1, subtracts) the item to the cached sums if they are valid */
+        void count_in_aggregates( const item &it, int sign );
+        void update_aggregates() const;
+
         invstack items;
         bool sorted;
+
+        mutable int cached_weight = 0;
+        mutable units::volume cached_volume = 0;
+        mutable bool aggregates_valid = false;
 };
 
 #endif
@@ -5382,6 +5382,11 @@ int item::processing_speed() const
     return 1;
 }
 
+bool item::needs_continuous_processing() const
+{
+    return processing_speed() == 1;
+}
+
 bool item::process_food( player * /*carrier*/, const tripoint &pos )
 {
     calc_rot( g->m.getabs( pos ) );
@@ -771,6 +771,11 @@ public:
      * The rate at which an item should be processed, in number of turns between updates.
      */
     int processing_speed() const;
+    /**
+     * Whether the item has to be processed every turn. Other items that @ref needs_processing
+     * are only woken up every @ref processing_speed turns.
+     */
+    bool needs_continuous_processing() const;
     /**
      * Process and apply artifact effects. This should be called exactly once each turn, it may
      * modify character stats (like speed, strength, ...), so call it after those have been reset.
@@ -1,10 +1,12 @@
 #include "json.h"
 
+#include <algorithm>
 #include <cmath> // pow
 #include <cstdlib> // strtoul
 #include <cstring> // strcmp
 #include <fstream>
 #include <istream>
+#include <iterator>
 #include <locale> // ensure user's locale doesn't interfere with output
 #include <set>
 #include <sstream>
@@ -65,21 +67,31 @@ std::string utf16_to_utf8(uint32_t ch)
  * represents a JSON object,
  * providing access to the underlying data.
  */
-JsonObject::JsonObject(JsonIn &j) : positions()
+JsonObject::JsonObject(JsonIn &j) : members()
 {
     jsin = &j;
     start = jsin->tell();
     // cache the position of the value for each member
     jsin->start_object();
     while (!jsin->end_object()) {
-        std::string n = jsin->get_member_name();
-        int p = jsin->tell();
-        if (n != "//" && n != "comment" && positions.count(n) > 0) {
+        member m;
+        if( !jsin->skip_member_name( m.name_start, m.name_len ) ) {
+            m.unescaped_name = jsin->get_member_name();
+            m.name_start = -1;
+            m.name_len = m.unescaped_name.size();
+        }
+        m.value_pos = jsin->tell();
+        const char *name = m.name_start < 0 ? m.unescaped_name.data() : jsin->data + m.name_start;
+        const int existing = find_member( name, m.name_len );
+        if( existing < 0 ) {
+            members.push_back( std::move( m ) );
+        } else if( member_name_is( m, "//", 2 ) || member_name_is( m, "comment", 7 ) ) {
             // members with name "//" or "comment" are used for comments and
             // should be ignored anyway.
+            members[existing].value_pos = m.value_pos;
+        } else {
             j.error("duplicate entry in json object");
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end = jsin->tell();
@@ -90,7 +102,7 @@ JsonObject::JsonObject(const JsonObject &jo)
 {
     jsin = jo.jsin;
     start = jo.start;
-    positions = jo.positions;
+    members = jo.members;
     end = jo.end;
     final_separator = jo.final_separator;
 }
@@ -105,17 +117,42 @@ void JsonObject::finish()
 
 size_t JsonObject::size()
 {
-    return positions.size();
+    return members.size();
 }
 bool JsonObject::empty()
 {
-    return positions.empty();
+    return members.empty();
+}
+
+bool JsonObject::member_name_is( const member &m, const char *name, size_t len ) const
+{
+    if( static_cast<size_t>( m.name_len ) != len ) {
+        return false;
+    }
+    const char *own = m.name_start < 0 ? m.unescaped_name.data() : jsin->data + m.name_start;
+    return memcmp( own, name, len ) == 0;
+}
+
+int JsonObject::find_member( const char *name, size_t len ) const
+{
+    for( size_t i = 0; i < members.size(); ++i ) {
+        if( member_name_is( members[i], name, len ) ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int JsonObject::member_position( const std::string &name ) const
+{
+    const int index = find_member( name.data(), name.size() );
+    return index < 0 ? 0 : members[index].value_pos;
 }
 
 int JsonObject::verify_position(const std::string &name,
                                 const bool throw_exception)
 {
-    int pos = positions[name]; // initialized to 0 if it doesn't exist
+    int pos = member_position( name ); // 0 if it doesn't exist
     if (pos > start) {
         return pos;
     } else if (throw_exception && !jsin) {
@@ -137,8 +174,12 @@ bool JsonObject::has_member(const std::string &name)
 std::set<std::string> JsonObject::get_member_names()
 {
     std::set<std::string> ret;
-    for( auto &elem : positions ) {
-        ret.insert( elem.first );
+    for( auto &elem : members ) {
+        if( elem.name_start < 0 ) {
+            ret.insert( elem.unescaped_name );
+        } else {
+            ret.insert( std::string( jsin->data + elem.name_start, elem.name_len ) );
+        }
     }
     return ret;
 }
@@ -202,7 +243,7 @@ bool JsonObject::get_bool(const std::string &name)
 
 bool JsonObject::get_bool(const std::string &name, const bool fallback)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return fallback;
     }
@@ -219,7 +260,7 @@ int JsonObject::get_int(const std::string &name)
 
 int JsonObject::get_int(const std::string &name, const int fallback)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return fallback;
     }
@@ -236,7 +277,7 @@ long JsonObject::get_long(const std::string &name)
 
 long JsonObject::get_long(const std::string &name, const long fallback)
 {
-    long pos = positions[name];
+    long pos = member_position( name );
     if (pos <= start) {
         return fallback;
     }
@@ -253,7 +294,7 @@ double JsonObject::get_float(const std::string &name)
 
 double JsonObject::get_float(const std::string &name, const double fallback)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return fallback;
     }
@@ -270,7 +311,7 @@ std::string JsonObject::get_string(const std::string &name)
 
 std::string JsonObject::get_string(const std::string &name, const std::string &fallback)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return fallback;
     }
@@ -282,7 +323,7 @@ std::string JsonObject::get_string(const std::string &name, const std::string &f
 
 JsonArray JsonObject::get_array(const std::string &name)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return JsonArray(); // empty array
     }
@@ -312,7 +353,7 @@ std::vector<std::string> JsonObject::get_string_array(const std::string &name)
 
 JsonObject JsonObject::get_object(const std::string &name)
 {
-    int pos = positions[name];
+    int pos = member_position( name );
     if (pos <= start) {
         return JsonObject(); // empty object
     }
@@ -690,38 +731,97 @@ bool JsonArray::has_object(int i)
     return jsin->test_object();
 }
 
+JsonIn::JsonIn( std::istream &s ) : stream( &s )
+{
+    std::streamoff start = s.tellg();
+    if( start > 0 && !s.seekg( 0 ) ) {
+        // Can't rewind, positions start at the current one then.
+        s.clear();
+        start = 0;
+    }
+    buffer.assign( std::istreambuf_iterator<char>( s ), std::istreambuf_iterator<char>() );
+    data = buffer.data();
+    size = buffer.size();
+    pos = std::max( 0, std::min( static_cast<int>( start ), size ) );
+}
+
+JsonIn::JsonIn( const std::string &s ) : data( s.data() ), size( s.size() )
+{
+}
+
+JsonIn::~JsonIn()
+{
+    if( stream != nullptr ) {
+        // Leave the stream where the parsing ended, for anyone reading on.
+        stream->clear();
+        stream->seekg( pos );
+        if( eof ) {
+            stream->setstate( std::istream::eofbit );
+        }
+    }
+}
+
 int JsonIn::tell()
 {
-    return stream->tellg();
+    return pos;
 }
 char JsonIn::peek()
 {
-    return (char)stream->peek();
+    if( pos >= size ) {
+        eof = true;
+        return static_cast<char>( EOF );
+    }
+    return data[pos];
 }
 bool JsonIn::good()
 {
-    return stream->good();
+    return !eof;
 }
 
-void JsonIn::seek(int pos)
+char JsonIn::next()
 {
-    stream->clear();
-    stream->seekg(pos);
+    if( pos >= size ) {
+        eof = true;
+        return static_cast<char>( EOF );
+    }
+    return data[pos++];
+}
+
+void JsonIn::get_chars( char *buf, int n )
+{
+    int i = 0;
+    while( i < n - 1 && pos < size && data[pos] != '\n' ) {
+        buf[i++] = data[pos++];
+    }
+    if( i < n - 1 && pos >= size ) {
+        eof = true;
+    }
+    buf[i] = '\0';
+}
+
+void JsonIn::seek(int p)
+{
+    pos = std::max( 0, std::min( p, size ) );
+    eof = false;
     ate_separator = false;
 }
 
 void JsonIn::eat_whitespace()
 {
-    while (is_whitespace(peek())) {
-        stream->get();
+    while( pos < size && is_whitespace( data[pos] ) ) {
+        ++pos;
+    }
+    if( pos >= size ) {
+        eof = true;
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
-    while (tell() > 0) {
-        stream->seekg(-1, std::istream::cur);
-        if (!is_whitespace(peek())) {
+    eof = false;
+    while( pos > 0 ) {
+        --pos;
+        if( !is_whitespace( data[pos] ) ) {
             break;
         }
     }
@@ -749,7 +849,7 @@ void JsonIn::skip_separator()
         if( ate_separator ) {
             error("duplicate separator");
         }
-        stream->get();
+        ++pos;
         ate_separator = true;
     } else if (ch == ']' || ch == '}' || ch == ':') {
         // okay
@@ -776,9 +876,8 @@ void JsonIn::skip_separator()
 
 void JsonIn::skip_pair_separator()
 {
-    char ch;
     eat_whitespace();
-    stream->get(ch);
+    const char ch = next();
     if (ch != ':') {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
@@ -791,26 +890,53 @@ void JsonIn::skip_pair_separator()
 
 void JsonIn::skip_string()
 {
-    char ch;
     eat_whitespace();
-    stream->get(ch);
+    char ch = next();
     if (ch != '"') {
         std::stringstream err;
         err << "expecting string but found '" << ch << "'";
         error(err.str(), -1);
     }
-    while (stream->good()) {
-        stream->get(ch);
+    bool closed = false;
+    while( pos < size ) {
+        ch = data[pos++];
         if (ch == '\\') {
-            stream->get(ch);
+            ++pos;
             continue;
         } else if (ch == '"') {
+            closed = true;
             break;
         } else if( ch == '\r' || ch == '\n' ) {
             error("string not closed before end of line", -1);
         }
     }
+    if( !closed ) {
+        pos = size;
+        eof = true;
+    }
+    end_value();
+}
+
+bool JsonIn::skip_member_name( int &name_start, int &name_len )
+{
+    eat_whitespace();
+    if( pos >= size || data[pos] != '"' ) {
+        return false;
+    }
+    int i = pos + 1;
+    while( i < size && data[i] != '"' && data[i] != '\\' &&
+           static_cast<unsigned char>( data[i] ) >= 0x20 ) {
+        ++i;
+    }
+    if( i >= size || data[i] != '"' ) {
+        return false;
+    }
+    name_start = pos + 1;
+    name_len = i - name_start;
+    pos = i + 1;
     end_value();
+    skip_pair_separator();
+    return true;
 }
 
 void JsonIn::skip_value()
@@ -868,7 +994,7 @@ void JsonIn::skip_true()
 {
     char text[5];
     eat_whitespace();
-    stream->get(text, 5);
+    get_chars(text, 5);
     if (strcmp(text, "true") != 0) {
         std::stringstream err;
         err << "expected \"true\", but found \"" << text << "\"";
@@ -881,7 +1007,7 @@ void JsonIn::skip_false()
 {
     char text[6];
     eat_whitespace();
-    stream->get(text, 6);
+    get_chars(text, 6);
     if (strcmp(text, "false") != 0) {
         std::stringstream err;
         err << "expected \"false\", but found \"" << text << "\"";
@@ -894,7 +1020,7 @@ void JsonIn::skip_null()
 {
     char text[5];
     eat_whitespace();
-    stream->get(text, 5);
+    get_chars(text, 5);
     if (strcmp(text, "null") != 0) {
         std::stringstream err;
         err << "expected \"null\", but found \"" << text << "\"";
@@ -905,16 +1031,18 @@ void JsonIn::skip_null()
 
 void JsonIn::skip_number()
 {
-    char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while (stream->good()) {
-        stream->get(ch);
+    while( pos < size ) {
+        const char ch = data[pos];
         if (ch != '+' && ch != '-' && (ch < '0' || ch > '9') &&
             ch != 'e' && ch != 'E' && ch != '.') {
-            stream->unget();
             break;
         }
+        ++pos;
+    }
+    if( pos >= size ) {
+        eof = true;
     }
     end_value();
 }
@@ -928,83 +1056,79 @@ std::string JsonIn::get_member_name()
 
 std::string JsonIn::get_string()
 {
-    std::string s = "";
+    std::string s;
     char ch;
-    bool backslash = false;
     char unihex[5] = "0000";
     eat_whitespace();
     int startpos = tell();
     // the first character had better be a '"'
-    stream->get(ch);
+    ch = next();
     if (ch != '"') {
         std::stringstream err;
         err << "expecting string but got '" << ch << "'";
         error(err.str(), -1);
     }
-    // add chars to the string, one at a time, converting:
+    // copy runs of plain characters at once, converting
     // \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-    while (stream->good()) {
-        stream->get(ch);
-        if (ch == '\\') {
-            if (backslash) {
-                s += '\\';
-                backslash = false;
-            } else {
-                backslash = true;
-                continue;
-            }
-        } else if (backslash) {
-            backslash = false;
-            if (ch == '"') {
-                s += '"';
-            } else if (ch == '/') {
-                s += '/';
-            } else if (ch == 'b') {
-                s += '\b';
-            } else if (ch == 'f') {
-                s += '\f';
-            } else if (ch == 'n') {
-                s += '\n';
-            } else if (ch == 'r') {
-                s += '\r';
-            } else if (ch == 't') {
-                s += '\t';
-            } else if (ch == 'u') {
-                // get the next four characters as hexadecimal
-                stream->get(unihex, 5);
-                // insert the appropriate unicode character in utf8
-                // TODO: verify that unihex is in fact 4 hex digits.
-                char **endptr = 0;
-                uint32_t u = (uint32_t)strtoul(unihex, endptr, 16);
-                try {
-                    s += utf16_to_utf8(u);
-                } catch( const std::exception &err ) {
-                    error( err.what() );
-                }
-            } else {
-                // for anything else, just add the character, i suppose
-                s += ch;
-            }
-        } else if (ch == '"') {
+    while( pos < size ) {
+        int run_end = pos;
+        while( run_end < size && data[run_end] != '"' && data[run_end] != '\\' &&
+               static_cast<unsigned char>( data[run_end] ) >= 0x20 ) {
+            ++run_end;
+        }
+        s.append( data + pos, run_end - pos );
+        pos = run_end;
+        if( pos >= size ) {
+            break;
+        }
+        ch = data[pos++];
+        if (ch == '"') {
             // end of the string
             end_value();
             return s;
         } else if( ch == '\r' || ch == '\n' ) {
             error("reached end of line without closing string", -1);
-        } else if( (unsigned char) ch < 0x20 ) {
+        } else if( ch != '\\' ) {
             error("invalid character inside string", -1);
+        }
+        if( pos >= size ) {
+            break;
+        }
+        ch = data[pos++];
+        if (ch == '"') {
+            s += '"';
+        } else if (ch == '/') {
+            s += '/';
+        } else if (ch == 'b') {
+            s += '\b';
+        } else if (ch == 'f') {
+            s += '\f';
+        } else if (ch == 'n') {
+            s += '\n';
+        } else if (ch == 'r') {
+            s += '\r';
+        } else if (ch == 't') {
+            s += '\t';
+        } else if (ch == 'u') {
+            // get the next four characters as hexadecimal
+            get_chars(unihex, 5);
+            // insert the appropriate unicode character in utf8
+            // TODO: verify that unihex is in fact 4 hex digits.
+            char **endptr = 0;
+            uint32_t u = (uint32_t)strtoul(unihex, endptr, 16);
+            try {
+                s += utf16_to_utf8(u);
+            } catch( const std::exception &err ) {
+                error( err.what() );
+            }
         } else {
+            // for anything else (including '\\'), just add the character, i suppose
             s += ch;
         }
     }
-    // if we get to here, probably hit a premature EOF?
-    if (stream->eof()) {
-        stream->clear();
-        seek(startpos);
-        error("couldn't find end of string, reached EOF.");
-    } else if (stream->fail()) {
-        throw JsonError( "stream failure while reading string." );
-    }
+    // if we get to here, we hit a premature EOF
+    seek(startpos);
+    error("couldn't find end of string, reached EOF.");
     throw JsonError( "something went wrong D:" );
 }
 
@@ -1031,10 +1155,10 @@ double JsonIn::get_float()
     int e = 0;
     int mod_e = 0;
     eat_whitespace();
-    stream->get(ch);
+    ch = next();
     if (ch == '-') {
         neg = true;
-        stream->get(ch);
+        ch = next();
     } else if (ch != '.' && (ch < '0' || ch > '9')) {
         // not a valid float
         std::stringstream err;
@@ -1043,7 +1167,7 @@ double JsonIn::get_float()
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get(ch);
+        ch = next();
         if (ch >= '0' && ch <= '9') {
             error("leading zeros not strictly allowed", -1);
         }
@@ -1051,40 +1175,42 @@ double JsonIn::get_float()
     while (ch >= '0' && ch <= '9') {
         i *= 10;
         i += (ch - '0');
-        stream->get(ch);
+        ch = next();
     }
     if (ch == '.') {
-        stream->get(ch);
+        ch = next();
         while (ch >= '0' && ch <= '9') {
             i *= 10;
             i += (ch - '0');
             mod_e -= 1;
-            stream->get(ch);
+            ch = next();
         }
     }
     if (neg) {
         i *= -1;
     }
     if (ch == 'e' || ch == 'E') {
-        stream->get(ch);
+        ch = next();
         neg = false;
         if (ch == '-') {
             neg = true;
-            stream->get(ch);
+            ch = next();
         } else if (ch == '+') {
-            stream->get(ch);
+            ch = next();
         }
         while (ch >= '0' && ch <= '9') {
             e *= 10;
             e += (ch - '0');
-            stream->get(ch);
+            ch = next();
         }
         if (neg) {
             e *= -1;
         }
     }
     // unget the final non-number character (probably a separator)
-    stream->unget();
+    if( !eof ) {
+        --pos;
+    }
     end_value();
     // now put it all together!
     return i * std::pow(10.0f, e + mod_e);
@@ -1096,9 +1222,9 @@ bool JsonIn::get_bool()
     char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get(ch);
+    ch = next();
     if (ch == 't') {
-        stream->get(text, 4);
+        get_chars(text, 4);
         if (strcmp(text, "rue") == 0) {
             end_value();
             return true;
@@ -1108,7 +1234,7 @@ bool JsonIn::get_bool()
             error(err.str(), -4);
         }
     } else if (ch == 'f') {
-        stream->get(text, 5);
+        get_chars(text, 5);
         if (strcmp(text, "alse") == 0) {
             end_value();
             return false;
@@ -1136,7 +1262,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if (peek() == '[') {
-        stream->get();
+        ++pos;
         ate_separator = false;
         return;
     } else {
@@ -1156,7 +1282,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error("separator not strictly allowed at end of array");
         }
-        stream->get();
+        ++pos;
         end_value();
         return true;
     } else {
@@ -1169,7 +1295,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if (peek() == '{') {
-        stream->get();
+        ++pos;
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1189,7 +1315,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error("separator not strictly allowed at end of object");
         }
-        stream->get();
+        ++pos;
         end_value();
         return true;
     } else {
@@ -1419,23 +1545,17 @@ bool JsonIn::read(JsonDeserializer &j)
 // WARNING: for occasional use only.
 std::string JsonIn::line_number(int offset_modifier)
 {
-    if (stream->eof()) {
+    if( eof ) {
         return "EOF";
-    } else if (stream->fail()) {
-        return "???";
-    } // else stream is fine
-    int pos = tell();
+    }
     int line = 1;
     int offset = 1;
-    char ch;
-    seek(0);
-    for (int i = 0; i < pos; ++i) {
-        stream->get(ch);
+    for( int i = 0; i < pos; ++i ) {
+        const char ch = data[i];
         if (ch == '\r') {
             offset = 1;
             ++line;
-            if (peek() == '\n') {
-                stream->get();
+            if( i + 1 < size && data[i + 1] == '\n' ) {
                 ++i;
             }
         } else if (ch == '\n') {
@@ -1454,55 +1574,52 @@ void JsonIn::error(std::string message, int offset)
 {
     std::ostringstream err;
     err << line_number(offset) << ": " << message;
-    // if we can't get more info from the stream don't try
-    if (!stream->good()) {
+    // if we can't get more info from the input don't try
+    if( eof ) {
         throw JsonError( err.str() );
     }
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg(offset, std::istream::cur);
-    size_t pos = tell();
+    const int errpos = std::max( 0, std::min( pos + offset, size ) );
+    pos = errpos;
     rewind(3, 240);
-    size_t startpos = tell();
-    std::string buffer( pos - startpos, '\0' );
-    stream->read( &buffer[0], pos - startpos );
-    err << buffer;
-    if (!is_whitespace(peek())) {
-        err << peek();
+    int startpos = pos;
+    err << std::string( data + startpos, errpos - startpos );
+    if( errpos < size && !is_whitespace( data[errpos] ) ) {
+        err << data[errpos];
     }
     // display a pointer to the position
+    pos = errpos;
     rewind(1, 240);
-    startpos = tell();
+    startpos = pos;
     err << '\n';
-    if (pos > startpos) {
-        err << std::string(pos - startpos - 1, ' ');
+    if (errpos > startpos) {
+        err << std::string(errpos - startpos - 1, ' ');
     }
     err << "^\n";
-    seek(pos);
+    seek(errpos);
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
+    const char ch = next();
     if (ch == '\r') {
-        if (peek() == '\n') {
-            stream->get();
+        if( pos < size && data[pos] == '\n' ) {
+            ++pos;
         }
     } else if (ch == '\n') {
         // pass
-    } else if (peek() != '\r' && peek() != '\n') {
-        for (size_t i = 0; i < pos - startpos; ++i) {
-            err << ' ';
-        }
+    } else if( pos < size && data[pos] != '\r' && data[pos] != '\n' ) {
+        err << std::string( errpos - startpos, ' ' );
     }
     // print the next couple lines as well
     int line_count = 0;
-    for (int i = 0; i < 240; ++i) {
-        stream->get(ch);
-        err << ch;
-        if (ch == '\r') {
+    for( int i = 0; i < 240 && pos < size; ++i ) {
+        const char c = data[pos++];
+        err << c;
+        if (c == '\r') {
             ++line_count;
-            if (peek() == '\n') {
-                err << stream->get();
+            if( pos < size && data[pos] == '\n' ) {
+                err << data[pos++];
             }
-        } else if (ch == '\n') {
+        } else if (c == '\n') {
             ++line_count;
         }
         if (line_count > 2) {
@@ -1519,48 +1636,43 @@ void JsonIn::rewind(int max_lines, int max_chars)
         seek(0);
         return;
     }
-    if (tell() == 0) {
+    if( pos == 0 ) {
         return;
     }
+    eof = false;
     int lines_found = 0;
-    stream->seekg(-1, std::istream::cur);
+    --pos;
     for (int i = 0; i < max_chars; ++i) {
-        size_t tellpos = tell();
-        if (peek() == '\n') {
+        const int tellpos = pos;
+        if( data[pos] == '\n' ) {
             ++lines_found;
             if (tellpos > 0) {
-                stream->seekg(-1, std::istream::cur);
+                --pos;
                 // note: does not update tellpos or count a character
-                if (peek() != '\r') {
+                if( data[pos] != '\r' ) {
                     continue;
                 }
             }
-        } else if (peek() == '\r') {
+        } else if( data[pos] == '\r' ) {
             ++lines_found;
         }
         if (tellpos == 0) {
             break;
         } else if (lines_found == max_lines) {
             // don't include the last \n or \r
-            stream->seekg(1, std::istream::cur);
+            ++pos;
             break;
         }
-        stream->seekg(-1, std::istream::cur);
+        --pos;
     }
 }
 
 std::string JsonIn::substr(size_t pos, size_t len)
 {
-    std::string ret;
-    if (len == std::string::npos) {
-        stream->seekg(0, std::istream::end);
-        size_t end = tell();
-        len = end - pos;
+    if( pos >= static_cast<size_t>( size ) ) {
+        return std::string();
     }
-    ret.resize(len);
-    stream->seekg(pos);
-    stream->read(&ret[0], len);
-    return ret;
+    return std::string( data + pos, std::min( len, size - pos ) );
 }
 
 
@@ -1828,8 +1940,8 @@ void JsonSerializer::serialize(std::ostream &o) const
 
 void JsonDeserializer::deserialize(const std::string &json_string)
 {
-    std::istringstream s(json_string);
-    deserialize(s);
+    JsonIn jin( json_string );
+    deserialize( jin );
 }
 
 void JsonDeserializer::deserialize(std::istream &i)
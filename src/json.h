@@ -80,8 +80,10 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 /* JsonIn
  * ======
  *
- * The JsonIn class provides a wrapper around a std::istream,
- * with methods for reading JSON data directly from the stream.
+ * The JsonIn class provides methods for reading JSON data directly from a
+ * buffer in memory. When constructed from a std::istream, the content of the
+ * stream is read into the buffer at once. Positions are byte offsets into the
+ * buffer, which are the same as the offsets in the stream.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -160,15 +162,43 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 class JsonIn
 {
     private:
-        std::istream *stream;
+        /** Copy of the input if it was read from a stream */
+        std::string buffer;
+        const char *data;
+        int size;
+        int pos = 0;
+        /** Set when trying to read past the end, like the eof bit of a stream */
+        bool eof = false;
+        /** Stream the input was read from, it's moved to the current position when done */
+        std::istream *stream = nullptr;
         bool ate_separator = false;
 
         void skip_separator();
         void skip_pair_separator();
         void end_value();
 
+        /** Consumes the next character, returns EOF at the end */
+        char next();
+        /** Reads up to n - 1 characters (stopping before a newline) into buf, like istream::get */
+        void get_chars( char *buf, int n );
+        /**
+         * Skips a member name and the following ':', the name is stored as position into the
+         * buffer. Returns false without consuming anything if the name needs to be unescaped
+         * (or is invalid), @ref get_member_name has to be used for it.
+         */
+        bool skip_member_name( int &name_start, int &name_len );
+
+        friend class JsonObject;
+
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
+        /** Reads the stream, from its start, so positions match the ones in the stream */
+        JsonIn( std::istream &s );
+        /** Parses the given string in place, it has to outlive the JsonIn */
+        JsonIn( const std::string &s );
+        JsonIn( std::string &&s ) = delete;
+        JsonIn( const JsonIn & ) = delete;
+        JsonIn &operator=( const JsonIn & ) = delete;
+        ~JsonIn();
 
         bool get_ate_separator()
         {
@@ -598,18 +628,33 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        /**
+         * Position of a member value. The name refers to the input of the JsonIn,
+         * unless it contained escape sequences.
+         */
+        struct member {
+            int name_start;
+            int name_len;
+            int value_pos;
+            std::string unescaped_name;
+        };
+        std::vector<member> members;
         int start;
         int end;
         bool final_separator;
         JsonIn *jsin;
         int verify_position(const std::string &name,
                             const bool throw_exception = true);
+        bool member_name_is( const member &m, const char *name, size_t len ) const;
+        /** Index of the named member in @ref members or -1 */
+        int find_member( const char *name, size_t len ) const;
+        /** Position of the named members value, 0 if there is no such member */
+        int member_position( const std::string &name ) const;
 
     public:
         JsonObject(JsonIn &jsin);
         JsonObject(const JsonObject &jsobj);
-        JsonObject() : positions(), start(0), end(0), jsin(NULL) {}
+        JsonObject() : members(), start(0), end(0), jsin(NULL) {}
         ~JsonObject()
         {
             finish();
@@ -692,7 +737,7 @@ class JsonObject
         // return false if the member is not found.
         template <typename T> bool read(const std::string &name, T &t)
         {
-            int pos = positions[name];
+            int pos = member_position( name );
             if (pos <= start) {
                 return false;
             }
@@ -902,7 +947,7 @@ template <typename T>
 std::set<T> JsonObject::get_tags( const std::string &name )
 {
     std::set<T> res;
-    int pos = positions[ name ];
+    int pos = member_position( name );
     if ( pos <= start ) {
         return res;
     }
@@ -13,6 +13,7 @@
 #include "weather.h"
 #include "shadowcasting.h"
 #include "messages.h"
+#include "profiler.h"
 
 #include <cmath>
 #include <cstring>
@@ -83,7 +84,7 @@ void map::build_transparency_cache( const int zlev )
                         value *= weather_data(g->weather).sight_penalty;
                     }
 
-                    for( auto const &fld : cur_submap->fld[sx][sy] ) {
+                    for( auto const &fld : cur_submap->fld.get( sx, sy ) ) {
                         const field_entry &cur = fld.second;
                         const field_id type = cur.getFieldType();
                         const int density = cur.getFieldDensity();
@@ -150,6 +151,7 @@ void map::apply_character_light( player &p )
 
 void map::generate_lightmap( const int zlev )
 {
+    profiler::scoped_timer timer( profiler::PROF_LIGHTMAP );
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -232,7 +234,7 @@ void map::generate_lightmap( const int zlev )
                         add_light_source( p, 240 );
                     }
 
-                    for( auto &fld : cur_submap->fld[sx][sy] ) {
+                    for( auto &fld : cur_submap->fld.get( sx, sy ) ) {
                         const field_entry *cur = &fld.second;
                         // TODO: [lightmap] Attach light brightness to fields
                         switch(cur->getFieldType()) {
@@ -352,13 +354,13 @@ void map::generate_lightmap( const int zlev )
             }
         };
 
-        for( size_t p = 0; p < v->parts.size(); ++p ) {
+        for( const int p : v->parts_with_flag( VPFLAG_CARGO ) ) {
             tripoint pp = tripoint( vv.x, vv.y, vv.z ) +
                           v->parts[p].precalc[0];
             if( !inbounds( pp ) ) {
                 continue;
             }
-            if( v->part_flag( p, VPFLAG_CARGO ) && !v->part_flag( p, "COVERED" ) ) {
+            if( !v->part_flag( p, "COVERED" ) ) {
                 add_light_from_items( pp, v->get_items(p).begin(), v->get_items(p).end() );
             }
         }
@@ -15,6 +15,8 @@
 #include "mapsharing.h"
 #include "output.h"
 #include "main_menu.h"
+#include "profiler.h"
+#include "replay.h"
 
 #include <cstring>
 #include <ctime>
@@ -64,7 +66,12 @@ int main(int argc, char *argv[])
     std::string dump;
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
+    std::string benchmark;
+    int benchmark_turns = 100;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string record_file;
+    std::string replay_file;
+    int replay_verify_interval = 1;
 
     // Set default file paths
 #ifdef PREFIX
@@ -148,6 +155,26 @@ int main(int argc, char *argv[])
                     return 0;
                 }
             },
+            {
+                "--benchmark", "<scenario> [turns = 100] [key=value...]",
+                "Runs turns headlessly and prints per-phase timings",
+                section_default,
+                [&benchmark,&benchmark_turns,&opts](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    test_mode = true;
+                    benchmark = params[ 0 ];
+                    int i = 1;
+                    if( i < n && isdigit( params[ i ][ 0 ] ) ) {
+                        benchmark_turns = atoi( params[ i++ ] );
+                    }
+                    for( ; i < n && strchr( params[ i ], '=' ) != nullptr; ++i ) {
+                        opts.emplace_back( params[ i ] );
+                    }
+                    return i;
+                }
+            },
             {
                 "--world", "<name>",
                 "Load world",
@@ -160,6 +187,34 @@ int main(int argc, char *argv[])
                     return 1;
                 }
             },
+            {
+                "--record", "<file>",
+                "Records the game that is loaded for --replay",
+                section_default,
+                [&record_file](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    record_file = params[0];
+                    return 1;
+                }
+            },
+            {
+                "--replay", "<file> [verify every N turns = 1]",
+                "Replays a recorded game headlessly and prints timings",
+                section_default,
+                [&replay_file,&replay_verify_interval](int n, const char *params[]) -> int {
+                    if( n < 1 ) {
+                        return -1;
+                    }
+                    replay_file = params[0];
+                    if( n > 1 && isdigit( params[1][0] ) ) {
+                        replay_verify_interval = atoi( params[1] );
+                        return 2;
+                    }
+                    return 1;
+                }
+            },
             {
                 "--basepath", "<path>",
                 "Base path for all game data subdirectories",
@@ -412,9 +467,14 @@ int main(int argc, char *argv[])
 
     set_language(true);
 
+    if( !replay_file.empty() && !replay::load( replay_file ) ) {
+        return 1;
+    }
+
     // in test mode don't initialize curses to avoid escape sequences being inserted into output stream
     if( !test_mode ) {
-         if( initscr() == nullptr ) { // Initialize ncurses
+         WINDOW *screen = replay_file.empty() ? initscr() : replay::open_screen();
+         if( screen == nullptr ) { // Initialize ncurses
             DebugLog( D_ERROR, DC_ALL ) << "initscr failed!";
             return 1;
         }
@@ -431,7 +491,7 @@ int main(int argc, char *argv[])
     // curs_set(0); // Invisible cursor
     set_escdelay(10); // Make escape actually responsive
 
-    srand(seed);
+    rng_set_engine_seed( seed );
 
     g = new game;
     // First load and initialize everything that does not
@@ -448,6 +508,12 @@ int main(int argc, char *argv[])
             init_colors();
             exit( g->dump_stats( dump, dmode, opts ) ? 0 : 1 );
         }
+        if( !benchmark.empty() ) {
+            init_colors();
+            const bool success = g->run_benchmark( benchmark, benchmark_turns, world, opts );
+            profiler::write();
+            exit( success ? 0 : 1 );
+        }
         if( check_mods ) {
             init_colors();
             exit( g->check_mod_data( opts ) && !test_dirty ? 0 : 1 );
@@ -474,6 +540,15 @@ int main(int argc, char *argv[])
     sigaction(SIGINT, &sigIntHandler, NULL);
 #endif
 
+    if( !replay_file.empty() ) {
+        const bool success = g->run_replay( replay_file, replay_verify_interval );
+        profiler::write();
+        exit( success ? 0 : 1 );
+    }
+    if( !record_file.empty() ) {
+        replay::record_to( record_file );
+    }
+
     while( true ) {
         if( !world.empty() ) {
             if( !g->load( world ) ) {
@@ -489,6 +564,7 @@ int main(int argc, char *argv[])
         }
 
         while( !g->do_turn() );
+        replay::end_recording();
         if( g->game_error() ) {
             break;
         }
@@ -551,6 +627,7 @@ void exit_handler(int s)
         erase(); // Clear screen
 
         deinitDebug();
+        profiler::write();
 
         int exit_status = 0;
         if( g != NULL ) {
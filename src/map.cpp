@@ -17,6 +17,7 @@
 #include "trap.h"
 #include "messages.h"
 #include "mapsharing.h"
+#include "profiler.h"
 #include "iuse_actor.h"
 #include "mongroup.h"
 #include "npc.h"
@@ -293,6 +294,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             ch.vehicle_list.erase(veh);
             reset_vehicle_cache( zlev );
             current_submap->vehicles.erase (current_submap->vehicles.begin() + i);
+            current_submap->dirty = true;
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
@@ -318,6 +320,7 @@ void map::on_vehicle_moved( const int smz ) {
 
 void map::vehmove()
 {
+    profiler::scoped_timer timer( profiler::PROF_VEHMOVE );
     // give vehicles movement points
     {
         VehicleList vehs = get_vehicles();
@@ -477,7 +480,7 @@ bool map::vehact( vehicle &veh )
             veh.stop();
             // TODO: Remove this hack
             // TODO: Amphibious vehicles
-            if( veh.floating.empty() ) {
+            if( veh.parts_with_flag( VPFLAG_FLOATS ).empty() ) {
                 add_msg(m_info, _("Your %s can't move on this terrain."), veh.name.c_str());
             } else {
                 add_msg(m_info, _("Your %s is beached."), veh.name.c_str());
@@ -603,12 +606,12 @@ float map::vehicle_wheel_traction( const vehicle &veh ) const
 {
     const tripoint pt = veh.global_pos3();
     // TODO: Remove this and allow amphibious vehicles
-    if( !veh.floating.empty() ) {
+    if( !veh.parts_with_flag( VPFLAG_FLOATS ).empty() ) {
         return vehicle_buoyancy( veh );
     }
 
     // Sink in water?
-    const auto &wheel_indices = veh.wheelcache;
+    const auto &wheel_indices = veh.parts_with_flag( VPFLAG_WHEEL );
     int num_wheels = wheel_indices.size();
     if( num_wheels == 0 ) {
         // TODO: Assume it is digging in dirt
@@ -663,7 +666,7 @@ float map::vehicle_wheel_traction( const vehicle &veh ) const
 float map::vehicle_buoyancy( const vehicle &veh ) const
 {
     const tripoint pt = veh.global_pos3();
-    const auto &float_indices = veh.floating;
+    const auto &float_indices = veh.parts_with_flag( VPFLAG_FLOATS );
     const int num = float_indices.size();
     int moored = 0;
     float total_wheel_area = 0.0f;
@@ -684,6 +687,19 @@ float map::vehicle_buoyancy( const vehicle &veh ) const
     return total_wheel_area;
 }
 
+// Whether a part of the vehicle is in the player's line of sight, as of the last time the
+// map cache was built
+static bool player_sees_vehicle( const vehicle &veh )
+{
+    const tripoint pos = veh.global_pos3();
+    for( const vehicle_part &part : veh.parts ) {
+        if( !part.removed && g->m.pl_line_of_sight( pos + part.precalc[0], -1 ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &facing )
 {
     const bool vertical = dp.z != 0;
@@ -698,6 +714,7 @@ void map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &facing
         return;
     }
 
+    const bool seen_before = player_sees_vehicle( veh );
     tripoint pt = veh.global_pos3();
     veh.precalc_mounts( 1, veh.skidding ? veh.turn_dir : facing.dir(), veh.pivot_point() );
 
@@ -782,7 +799,7 @@ void map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &facing
     }
 
     // If not enough wheels, mess up the ground a bit.
-    if( !vertical && !veh.valid_wheel_config( !veh.floating.empty() ) ) {
+    if( !vertical && !veh.valid_wheel_config( !veh.parts_with_flag( VPFLAG_FLOATS ).empty() ) ) {
         veh.velocity += veh.velocity < 0 ? 2000 : -2000;
         for( const auto &p : veh.get_points() ) {
             const ter_id &pter = ter( p );
@@ -794,7 +811,7 @@ void map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &facing
 
     // Now we're gonna handle traps we're standing on (if we're still moving).
     if( !vertical && can_move ) {
-        const auto wheel_indices = veh.wheelcache; // Don't use a reference here, it causes a crash.
+        const auto wheel_indices = veh.parts_with_flag( VPFLAG_WHEEL ); // Don't use a reference here, it causes a crash.
         for( auto &w : wheel_indices ) {
             const tripoint wheel_p = pt + veh.parts[w].precalc[0];
             if( one_in( 2 ) && displace_water( wheel_p ) ) {
@@ -850,9 +867,10 @@ void map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &facing
             veh.possibly_recover_from_skid();
         }
     }
-    // Redraw scene
-    // TODO: Make this not happen on unseen vehicles
-    g->draw();
+    // Redraw scene, unless the vehicle was out of sight before and after the move
+    if( seen_before || player_sees_vehicle( veh ) ) {
+        g->draw();
+    }
 }
 
 int map::shake_vehicle( vehicle &veh, const int velocity_before, const int direction )
@@ -1379,6 +1397,8 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
     }
     veh->pivot_anchor[0] = veh->pivot_anchor[1];
     veh->pivot_rotation[0] = veh->pivot_rotation[1];
+    veh->precalc_min[0] = veh->precalc_min[1];
+    veh->precalc_max[0] = veh->precalc_max[1];
 
     veh->posx = dst_offset_x;
     veh->posy = dst_offset_y;
@@ -1390,10 +1410,16 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         dst_submap->vehicles.push_back( veh );
         src_submap->vehicles.erase( src_submap->vehicles.begin() + our_i );
         dst_submap->is_uniform = false;
+        src_submap->dirty = true;
+        dst_submap->dirty = true;
     }
 
     p = p2;
 
+    if( src.z != p2.z ) {
+        get_cache( src.z ).vehicle_list.erase( veh );
+        get_cache( p2.z ).vehicle_list.insert( veh );
+    }
     update_vehicle_cache( veh, src.z );
 
     if( need_update ) {
@@ -2860,6 +2886,7 @@ void map::decay_fields_and_scent( const int amount )
                 // This submap has no fields
                 continue;
             }
+            cur_submap->dirty = true;
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 if( to_proc < 1 ) {
@@ -2871,7 +2898,7 @@ void map::decay_fields_and_scent( const int amount )
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
 
-                    field &fields = cur_submap->fld[sx][sy];
+                    field &fields = cur_submap->fld.get_mutable( sx, sy );
                     if( !outside_cache[x][y] ) {
                         to_proc -= fields.fieldCount();
                         continue;
@@ -4243,7 +4270,7 @@ map_stack map::i_at( const int x, const int y )
     int lx, ly;
     submap *const current_submap = get_submap_at( x, y, lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], tripoint( x, y, abs_sub.z ), this };
+    return map_stack{ &current_submap->get_items( lx, ly ), tripoint( x, y, abs_sub.z ), this };
 }
 
 std::list<item>::iterator map::i_rem( const point location, std::list<item>::iterator it )
@@ -4307,7 +4334,7 @@ map_stack map::i_at( const tripoint &p )
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], p, this };
+    return map_stack{ &current_submap->get_items( lx, ly ), p, this };
 }
 
 std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterator it )
@@ -4321,7 +4348,7 @@ std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterat
 
     current_submap->update_lum_rem(*it, lx, ly);
 
-    return current_submap->itm[lx][ly].erase( it );
+    return current_submap->get_items( lx, ly ).erase( it );
 }
 
 int map::i_rem(const tripoint &p, const int index)
@@ -4360,15 +4387,18 @@ void map::i_clear(const tripoint &p)
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    for( auto item_it = current_submap->itm[lx][ly].begin();
-         item_it != current_submap->itm[lx][ly].end(); ++item_it ) {
+    if( !current_submap->has_items( lx, ly ) ) {
+        return;
+    }
+    auto &items = current_submap->get_items( lx, ly );
+    for( auto item_it = items.begin(); item_it != items.end(); ++item_it ) {
         if( current_submap->active_items.has( item_it, point( lx, ly ) ) ) {
             current_submap->active_items.remove( item_it, point( lx, ly ) );
         }
     }
 
     current_submap->lum[lx][ly] = 0;
-    current_submap->itm[lx][ly].clear();
+    items.clear();
 }
 
 item &map::spawn_an_item(const tripoint &p, item new_item,
@@ -4544,7 +4574,7 @@ item &map::add_item(const tripoint &p, item new_item)
     if( new_item.needs_processing() && new_item.is_food() ) {
         new_item.process( nullptr, p, false );
     }
-    return add_item_at(p, current_submap->itm[lx][ly].end(), new_item);
+    return add_item_at(p, current_submap->get_items( lx, ly ).end(), new_item);
 }
 
 item &map::add_item_at( const tripoint &p,
@@ -4567,7 +4597,7 @@ item &map::add_item_at( const tripoint &p,
     current_submap->is_uniform = false;
 
     current_submap->update_lum_add(new_item, lx, ly);
-    const auto new_pos = current_submap->itm[lx][ly].insert( index, new_item );
+    const auto new_pos = current_submap->get_items( lx, ly ).insert( index, new_item );
     if( new_item.needs_processing() ) {
         current_submap->active_items.add( new_pos, point(lx, ly) );
     }
@@ -4668,13 +4698,13 @@ static bool process_map_items( item_stack &items, std::list<item>::iterator &n,
 
 static void process_vehicle_items( vehicle *cur_veh, int part )
 {
-    const bool fridge_here = cur_veh->has_part( "FRIDGE", true ) && cur_veh->part_flag(part, VPFLAG_FRIDGE);
+    const bool fridge_here = cur_veh->has_part( VPFLAG_FRIDGE, true ) && cur_veh->part_flag(part, VPFLAG_FRIDGE);
     if( fridge_here ) {
         for( auto &n : cur_veh->get_items( part ) ) {
             apply_in_fridge(n);
         }
     }
-    if( cur_veh->has_part( "RECHARGE", true ) && cur_veh->part_with_feature(part, VPFLAG_RECHARGE) >= 0 ) {
+    if( cur_veh->has_part( VPFLAG_RECHARGE, true ) && cur_veh->part_with_feature(part, VPFLAG_RECHARGE) >= 0 ) {
         for( auto &n : cur_veh->get_items( part ) ) {
             if( !n.is_tool() || ( !n.has_flag("RECHARGE") && !n.has_flag("USE_UPS") ) ) {
                 continue;
@@ -4698,6 +4728,7 @@ static void process_vehicle_items( vehicle *cur_veh, int part )
 
 void map::process_active_items()
 {
+    profiler::scoped_timer timer( profiler::PROF_ACTIVE_ITEMS );
     process_items( true, process_map_items, std::string {} );
 }
 
@@ -4734,7 +4765,7 @@ void map::process_items_in_submap( submap *const current_submap,
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
-    std::list<item_reference> active_items = current_submap->active_items.get();
+    arena_vector<item_reference> active_items = current_submap->active_items.get( calendar::turn );
     auto const grid_offset = point {gridp.x * SEEX, gridp.y * SEEY};
     for( auto &active_item : active_items ) {
         if( !current_submap->active_items.has( active_item ) ) {
@@ -4755,7 +4786,7 @@ void map::process_items_in_vehicles( submap *const current_submap, T processor,
     // a copy, important if the vehicle list changes because a
     // vehicle got destroyed by a bomb (an active item!), this list
     // won't change, but veh_in_nonant will change.
-    std::vector<vehicle*> const vehicles = veh_in_nonant;
+    arena_vector<vehicle*> const vehicles( veh_in_nonant.begin(), veh_in_nonant.end() );
     for( auto &cur_veh : vehicles ) {
         if (std::find(begin(veh_in_nonant), end(veh_in_nonant), cur_veh) == veh_in_nonant.end()) {
             // vehicle not in the vehicle list of the nonant, has been
@@ -4777,7 +4808,7 @@ void map::process_items_in_vehicle( vehicle *const cur_veh, submap *const curren
         process_vehicle_items( cur_veh, part );
     }
 
-    for( auto &active_item : cur_veh->active_items.get() ) {
+    for( auto &active_item : cur_veh->active_items.get( calendar::turn ) ) {
         if ( cargo_parts.empty() ) {
             return;
         } else if( !cur_veh->active_items.has( active_item ) ) {
@@ -4860,7 +4891,7 @@ bool map::has_items( const tripoint &p ) const
     int lx, ly;
     submap * const current_submap = get_submap_at( p, lx, ly );
 
-    return !current_submap->itm[lx][ly].empty();
+    return current_submap->has_items( lx, ly );
 }
 
 template <typename Stack>
@@ -5386,7 +5417,7 @@ const field &map::field_at( const tripoint &p ) const
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly];
+    return current_submap->fld.get( lx, ly );
 }
 
 /*
@@ -5401,8 +5432,14 @@ field &map::field_at( const tripoint &p )
 
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
+    if( !current_submap->fld.allocated() ) {
+        // No fields on this submap, fields are only ever added through add_field
+        nulfield = field();
+        return nulfield;
+    }
 
-    return current_submap->fld[lx][ly];
+    current_submap->dirty = true;
+    return current_submap->fld.get_mutable( lx, ly );
 }
 
 int map::adjust_field_age( const tripoint &p, const field_id t, const int offset ) {
@@ -5469,8 +5506,12 @@ field_entry *map::get_field( const tripoint &p, const field_id t ) {
 
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
+    if( !current_submap->fld.allocated() ) {
+        return nullptr;
+    }
 
-    return current_submap->fld[lx][ly].findField( t );
+    current_submap->dirty = true;
+    return current_submap->fld.get_mutable( lx, ly ).findField( t );
 }
 
 bool map::add_field(const tripoint &p, const field_id t, int density, const int age)
@@ -5492,8 +5533,9 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
 
     submap *const current_submap = get_submap_at( p, lx, ly );
     current_submap->is_uniform = false;
+    current_submap->dirty = true;
 
-    if( current_submap->fld[lx][ly].addField( t, density, age ) ) {
+    if( current_submap->fld.get_mutable( lx, ly ).addField( t, density, age ) ) {
         //Only adding it to the count if it doesn't exist.
         current_submap->field_count++;
     }
@@ -5522,7 +5564,9 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
     int lx, ly;
     submap * const current_submap = get_submap_at( p, lx, ly );
 
-    if( current_submap->fld[lx][ly].removeField( field_to_remove ) ) {
+    if( current_submap->fld.allocated() &&
+        current_submap->fld.get_mutable( lx, ly ).removeField( field_to_remove ) ) {
+        current_submap->dirty = true;
         // Only adjust the count if the field actually existed.
         current_submap->field_count--;
         const auto &fdata = fieldlist[ field_to_remove ];
@@ -5602,6 +5646,8 @@ computer* map::computer_at( const tripoint &p )
         return nullptr;
     }
 
+    // The computer may be changed through the pointer
+    current_submap->dirty = true;
     return &(current_submap->comp);
 }
 
@@ -5627,6 +5673,7 @@ basecamp* map::camp_at( const tripoint &p, const int radius)
             submap * const current_submap = get_submap_at( p );
             if( current_submap->camp.is_valid() ) {
                 // we only allow on camp per size radius, kinda
+                current_submap->dirty = true;
                 return &(current_submap->camp);
             }
         }
@@ -5642,7 +5689,9 @@ void map::add_camp( const tripoint &p, const std::string& name )
         return;
     }
 
-    get_submap_at( p )->camp = basecamp( name, p.x, p.y );
+    submap *const current_submap = get_submap_at( p );
+    current_submap->camp = basecamp( name, p.x, p.y );
+    current_submap->dirty = true;
 }
 
 void map::debug()
@@ -7037,10 +7086,9 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
         for( int y = 0; y < SEEY; y++ ) {
             const tripoint pnt( gridx * SEEX + x, gridy * SEEY + y, gridz );
 
-            const auto &furn = this->furn( pnt ).obj();
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "PLANT" ) ) {
-                remove_rotten_items( tmpsub->itm[x][y], pnt );
+            if( tmpsub->has_items( x, y ) && !this->furn( pnt ).obj().has_flag( "PLANT" ) ) {
+                remove_rotten_items( tmpsub->get_items( x, y ), pnt );
             }
 
             const auto trap_here = tmpsub->get_trap( x, y );
@@ -7114,6 +7162,7 @@ void map::add_roofs( const int gridx, const int gridy, const int gridz )
             if( !check_roof ) {
                 // Make sure we don't have open air at lowest z-level
                 sub_here->ter[x][y] = t_rock_floor;
+                sub_here->dirty = true;
                 continue;
             }
 
@@ -7121,6 +7170,7 @@ void map::add_roofs( const int gridx, const int gridy, const int gridz )
             if( ter_below.roof ) {
                 // TODO: Make roof variable a ter_id to speed this up
                 sub_here->ter[x][y] = ter_below.roof.id();
+                sub_here->dirty = true;
             }
         }
     }
@@ -7306,7 +7356,10 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->spawns.clear();
+        current_submap->dirty = true;
+    }
     overmap_buffer.spawn_monster( abs_sub.x + gp.x, abs_sub.y + gp.y, gp.z );
 }
 
@@ -7330,7 +7383,10 @@ void map::spawn_monsters(bool ignore_sight)
 void map::clear_spawns()
 {
     for( auto & smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->dirty = true;
+        }
     }
 }
 
@@ -7554,6 +7610,7 @@ void map::build_floor_caches()
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    profiler::scoped_timer timer( profiler::PROF_MAP_CACHE );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     for( int z = minz; z <= maxz; z++ ) {
@@ -8177,6 +8234,8 @@ void map::update_pathfinding_cache( int zlev ) const
         return;
     }
 
+    profiler::scoped_timer timer( profiler::PROF_PATHFINDING_CACHE );
+
     std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE*SEEX * MAPSIZE*SEEY, PF_NORMAL );
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
@@ -19,6 +19,7 @@
 #include "enums.h"
 #include "pathfinding.h"
 #include "emit.h"
+#include "turn_arena.h"
 
 //TODO: include comments about how these variables work. Where are they used. Are they constant etc.
 #define CAMPSIZE 1
@@ -71,7 +72,7 @@ struct wrapped_vehicle{
  vehicle* v;
 };
 
-typedef std::vector<wrapped_vehicle> VehicleList;
+typedef arena_vector<wrapped_vehicle> VehicleList;
 typedef std::vector< std::pair< item*, int > > itemslice;
 typedef std::string items_location;
 struct vehicle_prototype;
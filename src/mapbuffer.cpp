@@ -14,8 +14,11 @@
 #include "trap.h"
 #include "vehicle.h"
 #include "submap.h"
+#include "calendar.h"
 
 #include <sstream>
+#include <algorithm>
+#include <unordered_set>
 
 #define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -36,6 +39,7 @@ void mapbuffer::reset()
         delete elem.second;
     }
     submaps.clear();
+    quad_last_used.clear();
 }
 
 bool mapbuffer::add_submap(const tripoint &p, submap *sm)
@@ -45,6 +49,7 @@ bool mapbuffer::add_submap(const tripoint &p, submap *sm)
     }
 
     submaps[p] = sm;
+    quad_last_used[sm_to_omt_copy( p )] = calendar::turn;
 
     return true;
 }
@@ -75,6 +80,7 @@ void mapbuffer::remove_submap( tripoint addr )
     }
     delete m_target->second;
     submaps.erase( m_target );
+    quad_last_used.erase( sm_to_omt_copy( addr ) );
 }
 
 submap *mapbuffer::lookup_submap(int x, int y, int z)
@@ -96,21 +102,61 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return NULL;
     }
 
+    quad_last_used[sm_to_omt_copy( p )] = calendar::turn;
     return iter->second;
 }
 
-void mapbuffer::save( bool delete_after_save )
+bool mapbuffer::in_reality_bubble( const tripoint &om_addr ) const
 {
-    std::stringstream map_directory;
-    map_directory << world_generator->active_world->world_path << "/maps";
-    assure_dir_exist( map_directory.str().c_str() );
+    const tripoint map_origin = sm_to_omt_copy( g->m.get_abs_sub() );
+    if( !g->m.has_zlevels() && om_addr.z != g->get_levz() ) {
+        return false;
+    }
+    return om_addr.x >= map_origin.x && om_addr.y >= map_origin.y &&
+           om_addr.x <= map_origin.x + ( MAPSIZE / 2 ) &&
+           om_addr.y <= map_origin.y + ( MAPSIZE / 2 );
+}
 
+void mapbuffer::trim( const size_t max_submaps )
+{
+    if( max_submaps == 0 || submaps.size() <= max_submaps ) {
+        return;
+    }
+    // Free some more than needed, so this doesn't have to be done again on the next turn.
+    const size_t target = max_submaps - max_submaps / 8;
+
+    std::vector<std::pair<int, tripoint>> quads;
+    std::unordered_set<tripoint> seen;
+    for( auto &elem : submaps ) {
+        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        if( !seen.insert( om_addr ).second || in_reality_bubble( om_addr ) ) {
+            continue;
+        }
+        const auto used = quad_last_used.find( om_addr );
+        quads.emplace_back( used != quad_last_used.end() ? used->second : 0, om_addr );
+    }
+    // Least recently used first
+    std::sort( quads.begin(), quads.end() );
+
+    std::list<tripoint> submaps_to_delete;
+    for( auto &quad : quads ) {
+        if( submaps.size() - submaps_to_delete.size() <= target ) {
+            break;
+        }
+        save_quad( quad.second, submaps_to_delete, true );
+    }
+    dbg( D_INFO ) << "mapbuffer::trim: freeing " << submaps_to_delete.size() << " of " <<
+                  submaps.size() << " submaps";
+    for( auto &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+}
+
+void mapbuffer::save( bool delete_after_save )
+{
     int num_saved_submaps = 0;
     int num_total_submaps = submaps.size();
 
-    const tripoint map_origin = sm_to_omt_copy( g->m.get_abs_sub() );
-    const bool map_has_zlevels = g != nullptr && g->m.has_zlevels();
-
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
@@ -130,26 +176,9 @@ void mapbuffer::save( bool delete_after_save )
         }
         saved_submaps.insert( om_addr );
 
-        // A segment is a chunk of 32x32 submap quads.
-        // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
-        std::stringstream dirname;
-        tripoint segment_addr = omt_to_seg_copy( om_addr );
-        dirname << map_directory.str() << "/" << segment_addr.x << "." <<
-                     segment_addr.y << "." << segment_addr.z;
-
-        std::stringstream quad_path;
-        quad_path << dirname.str() << "/" << om_addr.x << "." <<
-                  om_addr.y << "." << om_addr.z << ".map";
-
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
-        const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + (MAPSIZE / 2) ||
-                   om_addr.y > map_origin.y + (MAPSIZE / 2) );
+        save_quad( om_addr, submaps_to_delete, delete_after_save || !in_reality_bubble( om_addr ) );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
@@ -157,6 +186,27 @@ void mapbuffer::save( bool delete_after_save )
     }
 }
 
+void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
+                           bool delete_after_save )
+{
+    std::stringstream map_directory;
+    map_directory << world_generator->active_world->world_path << "/maps";
+    assure_dir_exist( map_directory.str().c_str() );
+
+    // A segment is a chunk of 32x32 submap quads.
+    // We're breaking them into subdirectories so there aren't too many files per directory.
+    std::stringstream dirname;
+    tripoint segment_addr = omt_to_seg_copy( om_addr );
+    dirname << map_directory.str() << "/" << segment_addr.x << "." <<
+                 segment_addr.y << "." << segment_addr.z;
+
+    std::stringstream quad_path;
+    quad_path << dirname.str() << "/" << om_addr.x << "." <<
+              om_addr.y << "." << om_addr.z << ".map";
+
+    save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete, delete_after_save );
+}
+
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                            bool delete_after_save )
@@ -174,8 +224,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
-        if( sm != nullptr && !sm->is_uniform ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr && !iter->second->is_uniform ) {
             all_uniform = false;
         }
     }
@@ -184,7 +234,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                const auto iter = submaps.find( submap_addr );
+                if( iter != submaps.end() && iter->second != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -193,20 +244,50 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         return;
     }
 
+    // If nothing changed since the quad has been loaded or saved, its file is up to date.
+    // Vehicles are processed every turn wherever they are, and active items while in the
+    // reality bubble, without marking their submap as dirty. Quads with either are always saved.
+    bool modified = false;
+    for( auto &submap_addr : submap_addrs ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter == submaps.end() || iter->second == nullptr ) {
+            continue;
+        }
+        const submap &sm = *iter->second;
+        if( sm.dirty || !sm.vehicles.empty() || !sm.active_items.empty() ) {
+            modified = true;
+        }
+    }
+    if( !modified ) {
+        if( delete_after_save ) {
+            for( auto &submap_addr : submap_addrs ) {
+                const auto iter = submaps.find( submap_addr );
+                if( iter != submaps.end() && iter->second != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
+            }
+        }
+        return;
+    }
+
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname.c_str() );
     ofstream_wrapper_exclusive fout( filename );
     JsonOut jsout( fout );
     jsout.start_array();
     for( auto &submap_addr : submap_addrs ) {
-        if( submaps.count( submap_addr ) == 0 ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter == submaps.end() ) {
             continue;
         }
 
-        submap *sm = submaps[submap_addr];
+        submap *sm = iter->second;
         if( sm == nullptr ) {
             continue;
         }
+        // Saving is done between turns, nothing refers to the emptied item lists anymore.
+        sm->compact_items();
+        sm->compact_layers();
 
         jsout.start_object();
 
@@ -277,12 +358,12 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         jsout.start_array();
         for(int j = 0; j < SEEY; j++) {
             for(int i = 0; i < SEEX; i++) {
-                if( sm->itm[i][j].empty() ) {
+                if( !sm->has_items( i, j ) ) {
                     continue;
                 }
                 jsout.write( i );
                 jsout.write( j );
-                jsout.write( sm->itm[i][j] );
+                jsout.write( sm->get_items( i, j ) );
             }
         }
         jsout.end_array();
@@ -309,11 +390,11 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         for(int j = 0; j < SEEY; j++) {
             for(int i = 0; i < SEEX; i++) {
                 // Save fields
-                if (sm->fld[i][j].fieldCount() > 0) {
+                if (sm->fld.get( i, j ).fieldCount() > 0) {
                     jsout.write( i );
                     jsout.write( j );
                     jsout.start_array();
-                    for( auto &fld : sm->fld[i][j] ) {
+                    for( auto &fld : sm->fld.get( i, j ) ) {
                         const field_entry &cur = fld.second;
                             // We don't seem to have a string identifier for fields anywhere.
                             jsout.write( cur.getFieldType() );
@@ -330,11 +411,11 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         jsout.start_array();
         for (int j = 0; j < SEEY; j++) {
             for (int i = 0; i < SEEX; i++) {
-                if (sm->cosmetics[i][j].size() > 0) {
+                if (sm->cosmetics.get( i, j ).size() > 0) {
                     jsout.start_array();
                     jsout.write(i);
                     jsout.write(j);
-                    jsout.write(sm->cosmetics[i][j]);
+                    jsout.write(sm->cosmetics.get( i, j ));
                     jsout.end_array();
                 }
             }
@@ -385,6 +466,13 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
     jsout.end_array();
     fout.close();
+
+    for( auto &submap_addr : submap_addrs ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr ) {
+            iter->second->dirty = false;
+        }
+    }
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -451,13 +539,13 @@ void mapbuffer::deserialize( JsonIn &jsin )
                             if ( tid == "t_rubble" ) {
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_rubble" );
-                                sm->itm[i][j].push_back( rock );
-                                sm->itm[i][j].push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
                             } else if ( tid == "t_wreckage" ){
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_wreckage" );
-                                sm->itm[i][j].push_back( chunk );
-                                sm->itm[i][j].push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
                             } else if ( tid == "t_ash" ){
                                 sm->ter[i][j] = ter_id(  "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_ash" );
@@ -519,14 +607,14 @@ void mapbuffer::deserialize( JsonIn &jsin )
 
                         tmp.visit_items( [ &sm, i, j ]( item *it ) {
                             for( auto& e: it->magazine_convert() ) {
-                                sm->itm[i][j].push_back( e );
+                                sm->get_items( i, j ).push_back( e );
                             }
                             return VisitResponse::NEXT;
                         } );
 
-                        sm->itm[i][j].push_back( tmp );
+                        sm->get_items( i, j ).push_back( tmp );
                         if( tmp.needs_processing() ) {
-                            sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
+                            sm->active_items.add( std::prev( sm->get_items( i, j ).end() ), point( i, j ) );
                         }
                     }
                 }
@@ -537,7 +625,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                     int i = jsin.get_int();
                     int j = jsin.get_int();
                     // TODO: jsin should support returning an id like jsin.get_id<trap>()
-                    sm->trp[i][j] = trap_str_id( jsin.get_string() );
+                    sm->trp.set( i, j, trap_str_id( jsin.get_string() ) );
                     jsin.end_array();
                 }
             } else if( submap_member_name == "fields" ) {
@@ -551,10 +639,11 @@ void mapbuffer::deserialize( JsonIn &jsin )
                         int type = jsin.get_int();
                         int density = jsin.get_int();
                         int age = jsin.get_int();
-                        if (sm->fld[i][j].findField(field_id(type)) == NULL) {
+                        field &fld = sm->fld.get_mutable( i, j );
+                        if (fld.findField(field_id(type)) == NULL) {
                             sm->field_count++;
                         }
-                        sm->fld[i][j].addField(field_id(type), density, age);
+                        fld.addField(field_id(type), density, age);
                     }
                 }
             } else if( submap_member_name == "graffiti" ) {
@@ -572,7 +661,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                     jsin.start_array();
                     int i = jsin.get_int();
                     int j = jsin.get_int();
-                    jsin.read(sm->cosmetics[i][j]);
+                    jsin.read(sm->cosmetics.get_mutable( i, j ));
                     jsin.end_array();
                 }
             } else if( submap_member_name == "spawns" ) {
@@ -608,6 +697,8 @@ void mapbuffer::deserialize( JsonIn &jsin )
                 jsin.skip_value();
             }
         }
+        // Same as the file, the changes made while loading are repeated when loading it again.
+        sm->dirty = false;
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
@@ -1,7 +1,7 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
-#include <map>
+#include <unordered_map>
 #include <list>
 #include <memory>
 #include <string>
@@ -30,6 +30,14 @@ class mapbuffer
         /** Delete all buffered submaps. **/
         void reset();
 
+        /**
+         * Keeps at most the given number of submaps in memory (0 means no limit):
+         * if there are more, the least recently used quads outside of the reality
+         * bubble are saved and deleted. Must only be called between turns, when
+         * nothing but the main map refers to submaps.
+         */
+        void trim( size_t max_submaps );
+
         /** Add a new submap to the buffer.
          *
          * @param x, y, z The absolute world position in submap coordinates.
@@ -58,7 +66,7 @@ class mapbuffer
         submap *lookup_submap( const tripoint &p );
 
     private:
-        typedef std::map<tripoint, submap *> submap_map_t;
+        typedef std::unordered_map<tripoint, submap *> submap_map_t;
 
     public:
         inline submap_map_t::iterator begin() {
@@ -74,10 +82,16 @@ class mapbuffer
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
+        /** Whether the quad (in overmap terrain coordinates) is part of the main map */
+        bool in_reality_bubble( const tripoint &om_addr ) const;
+        void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
+                        bool delete_after_save );
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        /** Turn each quad (in overmap terrain coordinates) has last been looked up or added */
+        std::unordered_map<tripoint, int> quad_last_used;
 };
 
 extern mapbuffer MAPBUFFER;
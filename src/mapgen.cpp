@@ -8820,7 +8820,7 @@ FFFFFFFFFFFFFFFFFFFFFFFF\n\
         for(int a = 0; a < 21; a++ ) {
             vset.push_back(a);
         }
-        std::random_shuffle(vset.begin(), vset.end());
+        std::shuffle( vset.begin(), vset.end(), rng_get_engine() );
         for(int a = 0; a < vnum; a++) {
             if (vset[a] < 12) {
                 if (one_in(2)) {
@@ -9023,7 +9023,7 @@ FFFFFFFFFFFFFFFFFFFFFFFF\n\
         for(int a = 0; a < 17; a++) {
             vset.push_back(a);
         }
-        std::random_shuffle(vset.begin(), vset.end());
+        std::shuffle( vset.begin(), vset.end(), rng_get_engine() );
         for(int a = 0; a < vnum; a++) {
             if (vset[a] < 3) {
                 if (one_in(2)) {
@@ -10642,6 +10642,7 @@ vehicle *map::add_vehicle(const vproto_id &type, const tripoint &p, const int di
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz );
         place_on_submap->vehicles.push_back(placed_vehicle);
         place_on_submap->is_uniform = false;
+        place_on_submap->dirty = true;
 
         auto &ch = get_cache( placed_vehicle->smz );
         ch.vehicle_list.insert(placed_vehicle);
@@ -10867,12 +10868,18 @@ void map::rotate(int turns)
             int new_lx, new_ly;
             const auto new_sm = get_submap_at( new_x, new_y, new_lx, new_ly );
             new_sm->is_uniform = false;
+            new_sm->dirty = true;
             std::swap( rotated[old_x][old_y], new_sm->ter[new_lx][new_ly] );
             std::swap( furnrot[old_x][old_y], new_sm->frn[new_lx][new_ly] );
-            std::swap( traprot[old_x][old_y], new_sm->trp[new_lx][new_ly] );
-            std::swap( fldrot[old_x][old_y], new_sm->fld[new_lx][new_ly] );
-            std::swap( radrot[old_x][old_y], new_sm->rad[new_lx][new_ly] );
-            std::swap( cosmetics_rot[old_x][old_y], new_sm->cosmetics[new_lx][new_ly] );
+            // Only touch the sparse layers the submap actually has, to not allocate them all.
+            traprot[old_x][old_y] = new_sm->get_trap( new_lx, new_ly );
+            radrot[old_x][old_y] = new_sm->get_radiation( new_lx, new_ly );
+            if( new_sm->fld.allocated() ) {
+                std::swap( fldrot[old_x][old_y], new_sm->fld.get_mutable( new_lx, new_ly ) );
+            }
+            if( new_sm->cosmetics.allocated() ) {
+                std::swap( cosmetics_rot[old_x][old_y], new_sm->cosmetics.get_mutable( new_lx, new_ly ) );
+            }
             auto items = i_at(new_x, new_y);
             itrot[old_x][old_y].reserve( items.size() );
             // Copy items, if we move them, it'll wreck i_clear().
@@ -10996,12 +11003,17 @@ void map::rotate(int turns)
             int lx, ly;
             const auto sm = get_submap_at( i, j, lx, ly );
             sm->is_uniform = false;
+            sm->dirty = true;
             std::swap( rotated[i][j], sm->ter[lx][ly] );
             std::swap( furnrot[i][j], sm->frn[lx][ly] );
-            std::swap( traprot[i][j], sm->trp[lx][ly] );
-            std::swap( fldrot[i][j], sm->fld[lx][ly] );
-            std::swap( radrot[i][j], sm->rad[lx][ly] );
-            std::swap( cosmetics_rot[i][j], sm->cosmetics[lx][ly] );
+            sm->trp.set( lx, ly, traprot[i][j] );
+            sm->rad.set( lx, ly, radrot[i][j] );
+            if( sm->fld.allocated() || fldrot[i][j].fieldCount() > 0 ) {
+                std::swap( fldrot[i][j], sm->fld.get_mutable( lx, ly ) );
+            }
+            if( sm->cosmetics.allocated() || !cosmetics_rot[i][j].empty() ) {
+                std::swap( cosmetics_rot[i][j], sm->cosmetics.get_mutable( lx, ly ) );
+            }
             for( auto &itm : itrot[i][j] ) {
                 add_item( i, j, itm );
             }
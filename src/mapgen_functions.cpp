@@ -481,10 +481,14 @@ void mapgen_field(map *m, oter_id, mapgendata dat, int turn, float)
 
     ter_furn_id altbush = dat.region->field_coverage.pick( true ); // one dominant plant type ( for boosted_vegetation == true )
 
+    // The shrub roll of every square, drawn at once.
+    std::array<long, SEEX * 2 * SEEY * 2> bush_rolls;
+    rng_get_engine().fill( bush_rolls.begin(), bush_rolls.end(), 0, 1000000 );
+
     for (int i = 0; i < SEEX * 2; i++) {
         for (int j = 0; j < SEEY * 2; j++) {
             m->ter_set(i, j, dat.groundcover() ); // default is
-            if ( mpercent_bush > rng(0, 1000000) ) { // yay, a shrub ( or tombstone )
+            if ( mpercent_bush > bush_rolls[i * SEEY * 2 + j] ) { // yay, a shrub ( or tombstone )
                 if ( boosted_vegetation && dat.region->field_coverage.boosted_other_mpercent > rng(0, 1000000) ) {
                     // already chose the lucky terrain/furniture/plant/rock/etc
                     ter_or_furn_set(m, i, j, altbush );
@@ -677,11 +677,9 @@ void player::ma_ongethit_effects()
 template<typename C, typename F>
 static void accumulate_ma_buff_effects( const C &container, F f )
 {
-    for( auto &elem : container ) {
-        for( auto &eff : elem.second ) {
-            if( auto buff = ma_buff::from_effect( eff.second ) ) {
-                f( *buff, eff.second );
-            }
+    for( auto &eff : container ) {
+        if( auto buff = ma_buff::from_effect( eff ) ) {
+            f( *buff, eff );
         }
     }
 }
@@ -689,12 +687,10 @@ static void accumulate_ma_buff_effects( const C &container, F f )
 template<typename C, typename F>
 static bool search_ma_buff_effect( const C &container, F f )
 {
-    for( auto &elem : container ) {
-        for( auto &eff : elem.second ) {
-            if( auto buff = ma_buff::from_effect( eff.second ) ) {
-                if( f( *buff, eff.second ) ) {
-                    return true;
-                }
+    for( auto &eff : container ) {
+        if( auto buff = ma_buff::from_effect( eff ) ) {
+            if( f( *buff, eff ) ) {
+                return true;
             }
         }
     }
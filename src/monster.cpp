@@ -1684,37 +1684,34 @@ void monster::process_effects()
 {
     // Monster only effects
     int mod = 1;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            // Monsters don't get trait-based reduction, but they do get effect based reduction
-            bool reduced = resists_effect(it);
-
-            mod_speed_bonus(it.get_mod("SPEED", reduced));
-
-            int val = it.get_mod("HURT", reduced);
-            if (val > 0) {
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    apply_damage(nullptr, bp_torso, val);
-                }
+    for( effect &it : effects ) {
+        // Monsters don't get trait-based reduction, but they do get effect based reduction
+        bool reduced = resists_effect(it);
+
+        mod_speed_bonus(it.get_mod("SPEED", reduced));
+
+        int val = it.get_mod("HURT", reduced);
+        if (val > 0) {
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                apply_damage(nullptr, bp_torso, val);
             }
+        }
 
-            const efftype_id &id = _effect_it.second.get_id();
-            // MATERIALS-TODO: use fire resistance
-            if( id == effect_onfire ) {
-                int dam = 0;
-                if( made_of( material_id( "veggy" ) ) ) {
-                    dam = rng( 10, 20 );
-                } else if( made_of( material_id( "flesh" ) ) || made_of( material_id( "iflesh" ) ) ) {
-                    dam = rng( 5, 10 );
-                }
+        const efftype_id &id = it.get_id();
+        // MATERIALS-TODO: use fire resistance
+        if( id == effect_onfire ) {
+            int dam = 0;
+            if( made_of( material_id( "veggy" ) ) ) {
+                dam = rng( 10, 20 );
+            } else if( made_of( material_id( "flesh" ) ) || made_of( material_id( "iflesh" ) ) ) {
+                dam = rng( 5, 10 );
+            }
 
-                dam -= get_armor_type( DT_HEAT, bp_torso );
-                if( dam > 0 ) {
-                    apply_damage( nullptr, bp_torso, dam );
-                } else {
-                    it.set_duration( 0 );
-                }
+            dam -= get_armor_type( DT_HEAT, bp_torso );
+            if( dam > 0 ) {
+                apply_damage( nullptr, bp_torso, dam );
+            } else {
+                it.set_duration( 0 );
             }
         }
     }
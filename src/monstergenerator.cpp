@@ -38,6 +38,12 @@ bool string_id<mtype>::is_valid() const
     return MonsterGenerator::generator().mon_templates->is_valid( *this );
 }
 
+template<>
+int_id<mtype> string_id<mtype>::id() const
+{
+    return MonsterGenerator::generator().mon_templates->convert( *this, int_id<mtype>( 0 ) );
+}
+
 template<>
 const species_id string_id<species_type>::NULL_ID( "spec_null" );
 
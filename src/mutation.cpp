@@ -14,9 +14,40 @@
 #include "field.h"
 #include "vitamin.h"
 
+static bool test_trait_bit( const std::vector<bool> &bits, int id )
+{
+    return id >= 0 && id < static_cast<int>( bits.size() ) && bits[id];
+}
+
+static void set_trait_bit( std::vector<bool> &bits, const std::string &mut, bool value )
+{
+    const int id = mutation_branch::intern( mut );
+    if( id >= static_cast<int>( bits.size() ) ) {
+        bits.resize( id + 1, false );
+    }
+    bits[id] = value;
+}
+
 bool Character::has_trait(const std::string &b) const
 {
-    return my_mutations.count( b ) > 0;
+    return test_trait_bit( mutation_bits, mutation_branch::find_interned( b ) );
+}
+
+bool Character::has_trait( const trait_id &b ) const
+{
+    return test_trait_bit( mutation_bits, b.id() );
+}
+
+void Character::rebuild_trait_bits()
+{
+    mutation_bits.clear();
+    for( const auto &mut : my_mutations ) {
+        set_trait_bit( mutation_bits, mut.first, true );
+    }
+    trait_bits.clear();
+    for( const auto &tr : my_traits ) {
+        set_trait_bit( trait_bits, tr, true );
+    }
 }
 
 bool Character::has_trait_flag( const std::string &b ) const
@@ -35,7 +66,12 @@ bool Character::has_trait_flag( const std::string &b ) const
 bool Character::has_base_trait(const std::string &b) const
 {
     // Look only at base traits
-    return my_traits.find( b ) != my_traits.end();
+    return test_trait_bit( trait_bits, mutation_branch::find_interned( b ) );
+}
+
+bool Character::has_base_trait( const trait_id &b ) const
+{
+    return test_trait_bit( trait_bits, b.id() );
 }
 
 void Character::toggle_trait(const std::string &flag)
@@ -43,15 +79,19 @@ void Character::toggle_trait(const std::string &flag)
     const auto titer = my_traits.find( flag );
     if( titer == my_traits.end() ) {
         my_traits.insert( flag );
+        set_trait_bit( trait_bits, flag, true );
     } else {
         my_traits.erase( titer );
+        set_trait_bit( trait_bits, flag, false );
     }
     const auto miter = my_mutations.find( flag );
     if( miter == my_mutations.end() ) {
         my_mutations[flag]; // Creates a new entry with default values
+        set_trait_bit( mutation_bits, flag, true );
         mutation_effect(flag);
     } else {
         my_mutations.erase( miter );
+        set_trait_bit( mutation_bits, flag, false );
         mutation_loss_effect(flag);
     }
     recalc_sight_limits();
@@ -63,6 +103,7 @@ void Character::set_mutation(const std::string &flag)
     const auto iter = my_mutations.find( flag );
     if( iter == my_mutations.end() ) {
         my_mutations[flag]; // Creates a new entry with default values
+        set_trait_bit( mutation_bits, flag, true );
     } else {
         debugmsg("Trying to set %s mutation, but the character already has it.", flag.c_str());
     }
@@ -77,6 +118,7 @@ void Character::unset_mutation(const std::string &flag)
         debugmsg("Trying to unset %s mutation, but the character does not have it.", flag.c_str());
     } else {
         my_mutations.erase( iter );
+        set_trait_bit( mutation_bits, flag, false );
     }
     recalc_sight_limits();
     reset_encumbrance();
@@ -7,6 +7,7 @@
 #include "color.h"
 #include "damage.h"
 #include "string_id.h"
+#include "int_id.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -18,6 +19,7 @@ class martialart;
 using matype_id = string_id<martialart>;
 struct dream;
 struct mutation_branch;
+using trait_id = string_id<mutation_branch>;
 class item;
 
 extern std::vector<dream> dreams;
@@ -151,6 +153,14 @@ struct mutation_branch {
      * also get by calling @ref get.
      */
     static const MutationMap &get_all();
+    /**
+     * Returns the interned integer id of a mutation id string. Interned ids are handed out
+     * on first use and never reused or reset, so they stay valid when the mutation data is
+     * reloaded. @ref Character stores its traits and mutations as bitsets over them.
+     */
+    static int_id<mutation_branch> intern( const std::string &mutation_id );
+    /** Same as @ref intern, but returns -1 for strings that haven't been interned yet. */
+    static int_id<mutation_branch> find_interned( const std::string &mutation_id );
     // For init.cpp: reset (clear) the mutation data
     static void reset_all();
     // For init.cpp: load mutation data from json
@@ -325,6 +325,44 @@ const mutation_branch::MutationMap &mutation_branch::get_all()
     return mutation_data;
 }
 
+namespace
+{
+std::unordered_map<std::string, int> interned_mutation_ids;
+}
+
+int_id<mutation_branch> mutation_branch::intern( const std::string &mutation_id )
+{
+    const auto iter = interned_mutation_ids.emplace( mutation_id, interned_mutation_ids.size() ).first;
+    return int_id<mutation_branch>( iter->second );
+}
+
+int_id<mutation_branch> mutation_branch::find_interned( const std::string &mutation_id )
+{
+    const auto iter = interned_mutation_ids.find( mutation_id );
+    return int_id<mutation_branch>( iter != interned_mutation_ids.end() ? iter->second : -1 );
+}
+
+template<>
+int_id<mutation_branch> string_id<mutation_branch>::id() const
+{
+    if( get_cid().to_i() < 0 ) {
+        set_cid( mutation_branch::intern( str() ) );
+    }
+    return get_cid();
+}
+
+template<>
+const mutation_branch &string_id<mutation_branch>::obj() const
+{
+    return mutation_branch::get( str() );
+}
+
+template<>
+bool string_id<mutation_branch>::is_valid() const
+{
+    return mutation_branch::has( str() );
+}
+
 void mutation_branch::reset_all()
 {
     mutations_category.clear();
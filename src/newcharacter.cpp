@@ -2394,6 +2394,7 @@ void Character::empty_traits()
     }
     my_traits.clear();
     my_mutations.clear();
+    rebuild_trait_bits();
 }
 
 void Character::empty_skills()
@@ -61,6 +61,22 @@ const efftype_id effect_pkill3( "pkill3" );
 const efftype_id effect_pkill_l( "pkill_l" );
 const efftype_id effect_infection( "infection" );
 
+const trait_id trait_BEAUTIFUL( "BEAUTIFUL" );
+const trait_id trait_BEAUTIFUL2( "BEAUTIFUL2" );
+const trait_id trait_BEAUTIFUL3( "BEAUTIFUL3" );
+const trait_id trait_BEE( "BEE" );
+const trait_id trait_CANNIBAL( "CANNIBAL" );
+const trait_id trait_DEBUG_MIND_CONTROL( "DEBUG_MIND_CONTROL" );
+const trait_id trait_DEFORMED( "DEFORMED" );
+const trait_id trait_DEFORMED2( "DEFORMED2" );
+const trait_id trait_DEFORMED3( "DEFORMED3" );
+const trait_id trait_MUTE( "MUTE" );
+const trait_id trait_PRETTY( "PRETTY" );
+const trait_id trait_PSYCHOPATH( "PSYCHOPATH" );
+const trait_id trait_SAPIOVORE( "SAPIOVORE" );
+const trait_id trait_TERRIFYING( "TERRIFYING" );
+const trait_id trait_UGLY( "UGLY" );
+
 void starting_clothes( npc &who, const npc_class_id &type, bool male );
 void starting_inv( npc &who, const npc_class_id &type );
 
@@ -1007,29 +1023,29 @@ void npc::form_opinion( const player &u )
         }
     }
 
-    if (u.has_trait("SAPIOVORE")) {
+    if (u.has_trait( trait_SAPIOVORE )) {
         op_of_u.fear += 10; // Sapiovores = Scary
     }
 
-    if (u.has_trait("PRETTY")) {
+    if (u.has_trait( trait_PRETTY )) {
         op_of_u.fear += 1;
-    } else if (u.has_trait("BEAUTIFUL")) {
+    } else if (u.has_trait( trait_BEAUTIFUL )) {
         op_of_u.fear += 2;
-    } else if (u.has_trait("BEAUTIFUL2")) {
+    } else if (u.has_trait( trait_BEAUTIFUL2 )) {
         op_of_u.fear += 3;
-    } else if (u.has_trait("BEAUTIFUL3")) {
+    } else if (u.has_trait( trait_BEAUTIFUL3 )) {
         op_of_u.fear += 4;
-    } else if (u.has_trait("UGLY")) {
+    } else if (u.has_trait( trait_UGLY )) {
         op_of_u.fear -= 1;
-    } else if (u.has_trait("DEFORMED")) {
+    } else if (u.has_trait( trait_DEFORMED )) {
         op_of_u.fear += 3;
-    } else if (u.has_trait("DEFORMED2")) {
+    } else if (u.has_trait( trait_DEFORMED2 )) {
         op_of_u.fear += 6;
-    } else if (u.has_trait("DEFORMED3")) {
+    } else if (u.has_trait( trait_DEFORMED3 )) {
         op_of_u.fear += 9;
     }
 
-    if (u.has_trait("TERRIFYING")) {
+    if (u.has_trait( trait_TERRIFYING )) {
         op_of_u.fear += 6;
     }
 
@@ -1068,21 +1084,21 @@ void npc::form_opinion( const player &u )
         op_of_u.trust -= 1;
     }
 
-    if (u.has_trait("PRETTY")) {
+    if (u.has_trait( trait_PRETTY )) {
       op_of_u.trust += 1;
-    } else if (u.has_trait("BEAUTIFUL")) {
+    } else if (u.has_trait( trait_BEAUTIFUL )) {
         op_of_u.trust += 3;
-    } else if (u.has_trait("BEAUTIFUL2")) {
+    } else if (u.has_trait( trait_BEAUTIFUL2 )) {
         op_of_u.trust += 5;
-    } else if (u.has_trait("BEAUTIFUL3")) {
+    } else if (u.has_trait( trait_BEAUTIFUL3 )) {
         op_of_u.trust += 7;
-    } else if (u.has_trait("UGLY")) {
+    } else if (u.has_trait( trait_UGLY )) {
         op_of_u.trust -= 1;
-    } else if (u.has_trait("DEFORMED")) {
+    } else if (u.has_trait( trait_DEFORMED )) {
         op_of_u.trust -= 3;
-    } else if (u.has_trait("DEFORMED2")) {
+    } else if (u.has_trait( trait_DEFORMED2 )) {
         op_of_u.trust -= 6;
-    } else if (u.has_trait("DEFORMED3")) {
+    } else if (u.has_trait( trait_DEFORMED3 )) {
         op_of_u.trust -= 9;
     }
 
@@ -1293,7 +1309,7 @@ void npc::say( const std::string line, ... ) const
     std::string formatted_line = vstring_format(line, ap);
     va_end(ap);
     parse_tags( formatted_line, g->u, *this );
-    if( has_trait( "MUTE" ) ) {
+    if( has_trait( trait_MUTE ) ) {
         return;
     }
 
@@ -1883,18 +1899,18 @@ void npc::die(Creature* nkiller) {
     }
     if( killer == &g->u ){
         if (is_friend()) {
-            if (g->u.has_trait("SAPIOVORE")) {
+            if (g->u.has_trait( trait_SAPIOVORE )) {
                 g->u.add_memorial_log(pgettext("memorial_male", "Killed a friendly ape, %s.  Better eaten than eating."),
                                       pgettext("memorial_female", "Killed a friendly ape, %s.  Better eaten than eating."),
                                       name.c_str());
             }
-            else if(!g->u.has_trait("PSYCHOPATH")) {
+            else if(!g->u.has_trait( trait_PSYCHOPATH )) {
                 // Very long duration, about 7d, decay starts after 10h.
                 g->u.add_memorial_log(pgettext("memorial_male", "Killed a friend, %s."),
                                       pgettext("memorial_female", "Killed a friend, %s."),
                                       name.c_str());
                 g->u.add_morale(MORALE_KILLED_FRIEND, -500, 0, 10000, 600);
-            } else if(!g->u.has_trait("CANNIBAL") && g->u.has_trait("PSYCHOPATH")) {
+            } else if(!g->u.has_trait( trait_CANNIBAL ) && g->u.has_trait( trait_PSYCHOPATH )) {
                 g->u.add_memorial_log(pgettext("memorial_male", "Killed someone foolish enough to call you friend, %s. Didn't care."),
                                       pgettext("memorial_female", "Killed someone foolish enough to call you friend, %s. Didn't care."),
                                       name.c_str());
@@ -1904,21 +1920,21 @@ void npc::die(Creature* nkiller) {
                                       name.c_str());
             }
         } else if (!is_enemy() || this->hit_by_player) {
-            if (g->u.has_trait("SAPIOVORE")) {
+            if (g->u.has_trait( trait_SAPIOVORE )) {
                 g->u.add_memorial_log(pgettext("memorial_male", "Caught and killed an ape.  Prey doesn't have a name."),
                                       pgettext("memorial_female", "Caught and killed an ape.  Prey doesn't have a name."));
             }
-            else if(!g->u.has_trait("CANNIBAL") && !g->u.has_trait("PSYCHOPATH")) {
+            else if(!g->u.has_trait( trait_CANNIBAL ) && !g->u.has_trait( trait_PSYCHOPATH )) {
                 // Very long duration, about 3.5d, decay starts after 5h.
                 g->u.add_memorial_log(pgettext("memorial_male","Killed an innocent person, %s, in cold blood and felt terrible afterwards."),
                                       pgettext("memorial_female","Killed an innocent person, %s, in cold blood and felt terrible afterwards."),
                                       name.c_str());
                 g->u.add_morale(MORALE_KILLED_INNOCENT, -100, 0, 5000, 300);
-            } else if(!g->u.has_trait("CANNIBAL") && g->u.has_trait("PSYCHOPATH")) {
+            } else if(!g->u.has_trait( trait_CANNIBAL ) && g->u.has_trait( trait_PSYCHOPATH )) {
                 g->u.add_memorial_log(pgettext("memorial_male", "Killed an innocent, %s, in cold blood. They were weak."),
                                       pgettext("memorial_female", "Killed an innocent, %s, in cold blood. They were weak."),
                                       name.c_str());
-            } else if(g->u.has_trait("CANNIBAL") && !g->u.has_trait("PSYCHOPATH")) {
+            } else if(g->u.has_trait( trait_CANNIBAL ) && !g->u.has_trait( trait_PSYCHOPATH )) {
                 g->u.add_memorial_log(pgettext("memorial_male", "Killed an innocent, %s."),
                                       pgettext("memorial_female", "Killed an innocent, %s."),
                                       name.c_str());
@@ -2292,7 +2308,7 @@ std::ostream& operator<< (std::ostream & os, npc_need need)
 
 bool npc::will_accept_from_player( const item &it ) const
 {
-    if( is_minion() || g->u.has_trait( "DEBUG_MIND_CONTROL" ) || it.has_flag( "NPC_SAFE" ) ) {
+    if( is_minion() || g->u.has_trait( trait_DEBUG_MIND_CONTROL ) || it.has_flag( "NPC_SAFE" ) ) {
         return true;
     }
 
@@ -2349,7 +2365,7 @@ mfaction_id npc::get_monster_faction() const
         return player_fac.id();
     }
 
-    if( has_trait( "BEE" ) ) {
+    if( has_trait( trait_BEE ) ) {
         return bee_fac.id();
     }
 
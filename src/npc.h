@@ -244,6 +244,8 @@ struct npc_short_term_cache
     double my_weapon_value;
 
     std::vector<npc_target> friends;
+    /** Indices (for @ref game::zombie) of the monsters the NPC saw when the cache was made */
+    std::vector<size_t> visible_monsters;
 };
 
 // DO NOT USE! This is old, use strings as talk topic instead, e.g. "TALK_AGREE_FOLLOW" instead of
@@ -697,6 +699,8 @@ public:
     /** rates how dangerous a target is from 0 (harmless) to 1 (max danger) */
     float evaluate_enemy( const Creature &target ) const;
 
+    /** Fills @ref npc_short_term_cache::visible_monsters, which the two below use */
+    void find_visible_monsters();
     void choose_target();
     void assess_danger();
     // Functions which choose an action for a particular goal
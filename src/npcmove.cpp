@@ -17,6 +17,7 @@
 #include "mtype.h"
 #include "field.h"
 #include "sounds.h"
+#include "profiler.h"
 
 #include <algorithm>
 
@@ -174,13 +175,25 @@ float npc::evaluate_enemy( const Creature &target ) const {
     }
 }
 
+void npc::find_visible_monsters()
+{
+    ai_cache.visible_monsters.clear();
+    // Creature::sees rejects anything further away than this, checking the distance
+    // first saves calculating the light dependent range for each monster.
+    const int max_range = std::max( sight_range( DAYLIGHT_LEVEL ), sight_range( 0 ) );
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        const monster &mon = g->zombie( i );
+        if( rl_dist( pos(), mon.pos() ) <= max_range && sees( mon ) ) {
+            ai_cache.visible_monsters.push_back( i );
+        }
+    }
+}
+
 void npc::assess_danger()
 {
     float assessment = 0;
-    for (size_t i = 0; i < g->num_zombies(); i++) {
-        if( sees( g->zombie( i ) ) ) {
-            assessment += g->zombie(i).type->difficulty;
-        }
+    for( const size_t i : ai_cache.visible_monsters ) {
+        assessment += g->zombie( i ).type->difficulty;
     }
     assessment /= 10;
     if (assessment <= 2) {
@@ -250,11 +263,13 @@ float npc::character_danger( const Character &uc ) const
 
 void npc::regen_ai_cache()
 {
+    profiler::scoped_timer timer( profiler::PROF_NPC_AI_CACHE );
     ai_cache.friends.clear();
     ai_cache.target = npc_target::none();
     ai_cache.danger = 0.0f;
     ai_cache.total_danger = 0.0f;
     ai_cache.my_weapon_value = weapon_value( weapon );
+    find_visible_monsters();
     assess_danger();
 
     choose_target();
@@ -750,11 +765,8 @@ void npc::choose_target()
         return true;
     };
 
-    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+    for( const size_t i : ai_cache.visible_monsters ) {
         monster &mon = g->zombie( i );
-        if( !sees( mon ) ) {
-            continue;
-        }
 
         int dist = rl_dist( pos(), mon.pos() );
         // @todo This should include ranged attacks in calculation
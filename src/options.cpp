@@ -876,6 +876,11 @@ void options_manager::init()
         0, 127, 5
         );
 
+    add("MAP_BUFFER_SIZE", "general", _("Submaps kept in memory"),
+        _("Number of submaps kept in memory.  If there are more, the ones that haven't been visited for the longest time are saved and freed.  0 keeps all of them until the game is saved."),
+        0, 1000000, 20000
+        );
+
     mOptionsSort["general"]++;
 
     add("CIRCLEDIST", "general", _("Circular distances"),
@@ -1187,7 +1187,8 @@ int draw_item_info( const int iLeft, const int iWidth, const int iTop, const int
 #ifdef TILES
     clear_window_area( win );
 #endif // TILES
-    wclear( win );
+    // werase instead of wclear: clearing makes curses send the whole screen again
+    werase( win );
     wrefresh( win );
 
     const auto result = draw_item_info( win, sItemName, sTypeName, vItemDisplay, vItemCompare,
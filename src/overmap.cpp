@@ -70,6 +70,8 @@ oter_iid ot_null,
 //@todo Get rid of these and use 'generic_factory' class
 std::unordered_map<string_id<oter_t>, oter_t> otermap;
 std::vector<oter_t> oterlist;
+/** Terrains matching a type (see @ref is_ot_type), by type, filled on demand. */
+static std::unordered_map<std::string, std::vector<oter_id>> oter_ids_by_type;
 
 struct overmap_special_location {
     std::vector<oter_str_id> allowed;
@@ -335,12 +337,29 @@ void load_oter(oter_t &oter)
     oter.loadid = oter_id( oterlist.size() );
     otermap[oter.id] = oter;
     oterlist.push_back(oter);
+    oter_ids_by_type.clear();
 }
 
 void reset_overmap_terrain()
 {
     otermap.clear();
     oterlist.clear();
+    oter_ids_by_type.clear();
+}
+
+static const std::vector<oter_id> &oter_ids_of_type( const std::string &type )
+{
+    auto iter = oter_ids_by_type.find( type );
+    if( iter == oter_ids_by_type.end() ) {
+        std::vector<oter_id> ids;
+        for( size_t i = 0; i < oterlist.size(); i++ ) {
+            if( is_ot_type( type, oter_id( i ) ) ) {
+                ids.push_back( oter_id( i ) );
+            }
+        }
+        iter = oter_ids_by_type.emplace( type, std::move( ids ) ).first;
+    }
+    return iter->second;
 }
 
 /*
@@ -1060,7 +1079,10 @@ oter_id &overmap::ter(const int x, const int y, const int z)
         return ot_null;
     }
 
-    return layer[z + OVERMAP_DEPTH].terrain[x][y];
+    map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+    // The caller might change the terrain through the reference.
+    this_layer.terrain_index_valid = false;
+    return this_layer.terrain[x][y];
 }
 
 const oter_id overmap::get_ter(const int x, const int y, const int z) const
@@ -1693,6 +1715,31 @@ std::vector<point> overmap::find_terrain(const std::string &term, int zlevel)
     return found;
 }
 
+std::vector<point> overmap::find_terrain_of_type( const std::string &type, const int z )
+{
+    std::vector<point> found;
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return found;
+    }
+    map_layer &this_layer = layer[z + OVERMAP_DEPTH];
+    if( !this_layer.terrain_index_valid ) {
+        this_layer.terrain_index.clear();
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                this_layer.terrain_index[this_layer.terrain[x][y].to_i()].push_back( point( x, y ) );
+            }
+        }
+        this_layer.terrain_index_valid = true;
+    }
+    for( const oter_id &id : oter_ids_of_type( type ) ) {
+        const auto iter = this_layer.terrain_index.find( id.to_i() );
+        if( iter != this_layer.terrain_index.end() ) {
+            found.insert( found.end(), iter->second.begin(), iter->second.end() );
+        }
+    }
+    return found;
+}
+
 const city &overmap::get_nearest_city( const tripoint &p ) const
 {
     int distance = 999;
@@ -3959,7 +4006,7 @@ om_direction::type overmap::random_special_rotation( const overmap_special &spec
         }
     }
     // Pick first valid rotation at random.
-    std::random_shuffle( first, last );
+    std::shuffle( first, last, rng_get_engine() );
     const auto rotation = find_if( first, last, [&]( om_direction::type r ) {
         for( const auto &elem : special.terrains ) {
             const tripoint rp = p + om_direction::rotate( elem.p, r );
@@ -4037,7 +4084,7 @@ std::vector<point> overmap::get_sectors() const
             res.emplace_back( x, y );
         }
     }
-    std::random_shuffle( res.begin(), res.end() );
+    std::shuffle( res.begin(), res.end(), rng_get_engine() );
     return res;
 }
 
@@ -4069,7 +4116,7 @@ void overmap::place_specials()
         }
 
         if( elem->flags.count( "UNIQUE" ) > 0 ) {
-            if( rand() % max <= min ) {
+            if( rng( 0, max - 1 ) <= min ) {
                 mandatory.emplace_back( elem, 1 );
             }
         } else {
@@ -4088,8 +4135,8 @@ void overmap::place_specials()
         return; // Nothing to do.
     }
     // Make random permutations.
-    std::random_shuffle( mandatory.begin(), mandatory.end() );
-    std::random_shuffle( optional.begin(), optional.end() );
+    std::shuffle( mandatory.begin(), mandatory.end(), rng_get_engine() );
+    std::shuffle( optional.begin(), optional.end(), rng_get_engine() );
     // Walk over sectors.
     for( const point &sector : get_sectors() ) {
         const int x = sector.x;
@@ -4126,7 +4173,7 @@ void overmap::place_specials()
                     iter = candidates.erase( iter );
                 }
                 // Refresh the permutation.
-                std::random_shuffle( optional.begin(), optional.end() );
+                std::shuffle( optional.begin(), optional.end(), rng_get_engine() );
                 i = attempts; // This takes us out of the outer cycle. I'm really tempted to write 'goto' here :P.
                 break;
             }
@@ -4270,8 +4317,14 @@ void overmap::open()
         for (int i = -1; i <= 1; i += 2) {
             pointers.push_back(overmap_buffer.get_existing(loc.x+i, loc.y));
         }
+        // Generate from a stream of its own derived from the world seed and the position,
+        // so the result only depends on the world and the neighbors, not on when (or for
+        // which reason) the overmap is created. The game continues where it was afterwards.
+        const rng_engine game_engine = rng_get_engine();
+        rng_get_engine().seed( g->get_seed(), ( uint64_t( uint32_t( loc.x ) ) << 32 ) | uint32_t( loc.y ) );
         // pointers looks like (north, south, west, east)
         generate(pointers[0], pointers[3], pointers[1], pointers[2]);
+        rng_get_engine() = game_engine;
     }
 }
 
@@ -4281,13 +4334,27 @@ void overmap::save() const
     std::string const plrfilename = overmapbuffer::player_filename(loc.x, loc.y);
     std::string const terfilename = overmapbuffer::terrain_filename(loc.x, loc.y);
 
-    ofstream_wrapper fout_player( plrfilename );
-    serialize_view( fout_player );
-    fout_player.close();
-
-    ofstream_wrapper_exclusive fout_terrain( terfilename );
-    serialize( fout_terrain );
-    fout_terrain.close();
+    // The terrain, notes, monster groups etc. are changed through too many paths to track
+    // them, so compare the content instead: a file is only written if it changed.
+    std::ostringstream view;
+    serialize_view( view );
+    const size_t view_hash = std::hash<std::string>()( view.str() );
+    if( view_hash != saved_view_hash ) {
+        ofstream_wrapper fout_player( plrfilename );
+        fout_player.stream() << view.str();
+        fout_player.close();
+        saved_view_hash = view_hash;
+    }
+
+    std::ostringstream terrain;
+    serialize( terrain );
+    const size_t terrain_hash = std::hash<std::string>()( terrain.str() );
+    if( terrain_hash != saved_terrain_hash ) {
+        ofstream_wrapper_exclusive fout_terrain( terfilename );
+        fout_terrain.stream() << terrain.str();
+        fout_terrain.close();
+        saved_terrain_hash = terrain_hash;
+    }
 }
 
 
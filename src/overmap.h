@@ -8,8 +8,10 @@
 #include "game_constants.h"
 #include "monster.h"
 #include "weather_gen.h"
+#include "rng.h"
 
 #include <array>
+#include <climits>
 #include <iosfwd>
 #include <list>
 #include <map>
@@ -145,7 +147,7 @@ struct radio_tower {
  int frequency;
 radio_tower(int X = -1, int Y = -1, int S = -1, std::string M = "",
             radio_type T = MESSAGE_BROADCAST) :
-    x (X), y (Y), strength (S), type (T), message (M) {frequency = rand();}
+    x (X), y (Y), strength (S), type (T), message (M) {frequency = rng( 0, INT_MAX );}
 };
 
 struct map_layer {
@@ -153,6 +155,13 @@ struct map_layer {
     bool visible[OMAPX][OMAPY];
     bool explored[OMAPX][OMAPY];
     std::vector<om_note> notes;
+    /**
+     * Places of each terrain on this level, by terrain (int id). Built on demand by
+     * @ref overmap::find_terrain_of_type and invalidated by every access that could
+     * change the terrain (the non-const @ref overmap::ter).
+     */
+    std::unordered_map<int, std::vector<point>> terrain_index;
+    bool terrain_index_valid = false;
 };
 
 class overmap
@@ -184,6 +193,13 @@ class overmap
      * coordinates), or empty vector if no matching terrain is found.
      */
     std::vector<point> find_terrain(const std::string &term, int zlevel);
+    /**
+     * Return all places on the given z level that have a terrain of the given type
+     * (see @ref is_ot_type), in no particular order. Uses an index of the terrain,
+     * so it does not need to look at every place.
+     * @returns Local overmap terrain coordinates.
+     */
+    std::vector<point> find_terrain_of_type( const std::string &type, int z );
 
     oter_id& ter(const int x, const int y, const int z);
     const oter_id get_ter(const int x, const int y, const int z) const;
@@ -307,6 +323,11 @@ public:
     std::unordered_multimap<tripoint, monster> monster_map;
     regional_settings settings;
 
+    // Hashes of the content of the player view and the terrain file as they have been
+    // saved the last time, unchanged files are not written again.
+    mutable size_t saved_view_hash = 0;
+    mutable size_t saved_terrain_hash = 0;
+
   // Initialise
   void init_layers();
   // open existing overmap, or generate a new one
@@ -14,6 +14,7 @@
 #include "vehicle.h"
 #include "filesystem.h"
 #include "cata_utility.h"
+#include "line.h"
 
 #include <algorithm>
 #include <cassert>
@@ -72,6 +73,28 @@ overmap &overmapbuffer::get( const int x, const int y )
     return result;
 }
 
+bool overmapbuffer::prepare_adjacent( const tripoint &p, int const distance )
+{
+    int x = p.x;
+    int y = p.y;
+    const point om = omt_to_om_remain( x, y );
+    const int dx = x < distance ? -1 : x >= OMAPX - distance ? 1 : 0;
+    const int dy = y < distance ? -1 : y >= OMAPY - distance ? 1 : 0;
+    // Near a corner the diagonal neighbor is needed as well.
+    const point candidates[] = { point( dx, 0 ), point( 0, dy ), point( dx, dy ) };
+    for( const point &d : candidates ) {
+        if( d == point( 0, 0 ) ) {
+            continue;
+        }
+        const point neighbor( om.x + d.x, om.y + d.y );
+        if( overmaps.count( neighbor ) == 0 ) {
+            get( neighbor.x, neighbor.y );
+            return true;
+        }
+    }
+    return false;
+}
+
 void overmapbuffer::fix_mongroups(overmap &new_overmap)
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -514,53 +537,63 @@ bool overmapbuffer::check_ot_type(const std::string& type, int x, int y, int z)
     return om.check_ot_type(type, x, y, z);
 }
 
-tripoint overmapbuffer::find_closest(const tripoint& origin, const std::string& type, int const radius, bool must_be_seen)
+std::vector<std::pair<int, point>> overmapbuffer::overmaps_in_square( const tripoint &origin,
+                                                                    int const dist )
 {
-    int max = (radius == 0 ? OMAPX : radius);
-    const int z = origin.z;
-    // expanding box
-    for( int dist = 0; dist <= max; dist++) {
-        // each edge length is 2*dist-2, because corners belong to one edge
-        // south is +y, north is -y
-        for (int i = 0; i < dist*2-1; i++) {
-            //start at northwest, scan north edge
-            int x = origin.x - dist + i;
-            int y = origin.y - dist;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
-            }
+    const point om_min = omt_to_om_copy( origin.x - dist, origin.y - dist );
+    const point om_max = omt_to_om_copy( origin.x + dist, origin.y + dist );
+    std::vector<std::pair<int, point>> in_range;
+    for( int x = om_min.x; x <= om_max.x; x++ ) {
+        for( int y = om_min.y; y <= om_max.y; y++ ) {
+            // Distance from the origin to the nearest place on that overmap.
+            const int dx = std::max( std::max( x * OMAPX - origin.x, origin.x - ( x + 1 ) * OMAPX + 1 ), 0 );
+            const int dy = std::max( std::max( y * OMAPY - origin.y, origin.y - ( y + 1 ) * OMAPY + 1 ), 0 );
+            in_range.emplace_back( std::max( dx, dy ), point( x, y ) );
+        }
+    }
+    std::sort( in_range.begin(), in_range.end() );
+    return in_range;
+}
 
-            //start at southeast, scan south
-            x = origin.x + dist - i;
-            y = origin.y + dist;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
-            }
+tripoint overmapbuffer::find_closest(const tripoint& origin, const std::string& type, int const radius, bool must_be_seen)
+{
+    const std::vector<tripoint> found = find_closest( origin, type, radius, must_be_seen, 1 );
+    return found.empty() ? overmap::invalid_tripoint : found.front();
+}
 
-            //start at southwest, scan west
-            x = origin.x - dist;
-            y = origin.y + dist - i;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
+std::vector<tripoint> overmapbuffer::find_closest( const tripoint &origin, const std::string &type,
+                                                   int const radius, bool must_be_seen, size_t const count )
+{
+    const int max = radius == 0 ? OMAPX : radius;
+    std::vector<std::pair<int, tripoint>> found;
+    for( const auto &om_entry : overmaps_in_square( origin, max ) ) {
+        // Overmaps come nearest first, once the farthest of the places found so far is not
+        // farther than this overmap, no other overmap can have anything closer.
+        if( count > 0 && found.size() >= count && found[count - 1].first <= om_entry.first ) {
+            break;
+        }
+        const point &om_pos = om_entry.second;
+        const point om_base( om_pos.x * OMAPX, om_pos.y * OMAPY );
+        overmap &om = get( om_pos.x, om_pos.y );
+        for( const point &p : om.find_terrain_of_type( type, origin.z ) ) {
+            const tripoint pos( om_base.x + p.x, om_base.y + p.y, origin.z );
+            const int dist = square_dist( origin, pos );
+            // The origin itself is not a result.
+            if( dist == 0 || dist > max ) {
+                continue;
             }
-
-            //start at northeast, scan east
-            x = origin.x + dist;
-            y = origin.y - dist + i;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
+            if( must_be_seen && !om.seen( p.x, p.y, origin.z ) ) {
+                continue;
             }
+            found.emplace_back( dist, pos );
         }
+        std::sort( found.begin(), found.end() );
     }
-    return overmap::invalid_tripoint;
+    std::vector<tripoint> result;
+    for( size_t i = 0; i < found.size() && ( count == 0 || i < count ); i++ ) {
+        result.push_back( found[i].second );
+    }
+    return result;
 }
 
 std::vector<tripoint> overmapbuffer::find_all( const tripoint& origin, const std::string& type,
@@ -569,16 +602,22 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint& origin, const std
     std::vector<tripoint> result;
     // dist == 0 means search a whole overmap diameter.
     dist = dist ? dist : OMAPX;
-    for (int x = origin.x - dist; x <= origin.x + dist; x++) {
-        for (int y = origin.y - dist; y <= origin.y + dist; y++) {
-            if (must_be_seen && !seen(x, y, origin.z)) {
+    for( const auto &om_entry : overmaps_in_square( origin, dist ) ) {
+        const point &om_pos = om_entry.second;
+        overmap &om = get( om_pos.x, om_pos.y );
+        for( const point &p : om.find_terrain_of_type( type, origin.z ) ) {
+            const tripoint pos( om_pos.x * OMAPX + p.x, om_pos.y * OMAPY + p.y, origin.z );
+            if( square_dist( origin, pos ) > dist ) {
                 continue;
             }
-            if (check_ot_type(type, x, y, origin.z)) {
-                result.push_back( tripoint( x, y, origin.z ) );
+            if( must_be_seen && !om.seen( p.x, p.y, origin.z ) ) {
+                continue;
             }
+            result.push_back( pos );
         }
     }
+    // Same order as going through the square column by column.
+    std::sort( result.begin(), result.end() );
     return result;
 }
 
@@ -65,6 +65,17 @@ public:
      * compared with the position of the overmap.
      */
     overmap &get( const int x, const int y );
+    /**
+     * Creates (generates or loads) the overmaps next to the one containing the given
+     * point if it is less than distance overmap terrains away from their shared edge
+     * or corner. Called while the player moves, so new overmaps are prepared on a
+     * turn of their own instead of when the reality bubble reaches them together
+     * with the submaps that need to be generated then. At most one overmap is
+     * created per call, as generating one takes some time.
+     * @param p Global overmap terrain coordinates.
+     * @return Whether an overmap has been created.
+     */
+    bool prepare_adjacent( const tripoint &p, int distance );
     void save();
     void clear();
 
@@ -219,6 +230,14 @@ public:
      * should be searched.
      */
     tripoint find_closest(const tripoint& origin, const std::string& type, int radius, bool must_be_seen);
+    /**
+     * Returns up to count closest points of terrain type, the closest first (distance
+     * as in @ref square_dist). A count of 0 returns all within the radius.
+     * The other parameters are as for the function above. Only overmaps that might
+     * contain a closer point than the ones found so far are looked at (and created).
+     */
+    std::vector<tripoint> find_closest( const tripoint &origin, const std::string &type, int radius,
+                                        bool must_be_seen, size_t count );
 
     /* These 4 functions return the overmap that contains the given
      * overmap terrain coordinate.
@@ -346,6 +365,12 @@ private:
      */
     std::vector<overmap *> get_overmaps_near( const point &location, int radius );
     std::vector<overmap *> get_overmaps_near( const tripoint &location, int radius );
+    /**
+     * Positions of the overmaps that overlap the square of the given half size around origin
+     * (in overmap terrain coordinates), paired with the distance from origin to their nearest
+     * place and sorted by it.
+     */
+    std::vector<std::pair<int, point>> overmaps_in_square( const tripoint &origin, int dist );
 };
 
 extern overmapbuffer overmap_buffer;
@@ -56,6 +56,7 @@
 #include "vitamin.h"
 #include "fault.h"
 #include "recipe_dictionary.h"
+#include "profiler.h"
 
 #include <map>
 #include <iterator>
@@ -158,6 +159,211 @@ const efftype_id effect_winded( "winded" );
 const efftype_id effect_nausea( "nausea" );
 const efftype_id effect_cough_suppress( "cough_suppress" );
 
+const trait_id trait_ACIDBLOOD( "ACIDBLOOD" );
+const trait_id trait_ACIDPROOF( "ACIDPROOF" );
+const trait_id trait_ADDICTIVE( "ADDICTIVE" );
+const trait_id trait_ADRENALINE( "ADRENALINE" );
+const trait_id trait_ALBINO( "ALBINO" );
+const trait_id trait_AMORPHOUS( "AMORPHOUS" );
+const trait_id trait_ANTENNAE( "ANTENNAE" );
+const trait_id trait_ANTLERS( "ANTLERS" );
+const trait_id trait_ARACHNID_ARMS( "ARACHNID_ARMS" );
+const trait_id trait_ARACHNID_ARMS_OK( "ARACHNID_ARMS_OK" );
+const trait_id trait_ASTHMA( "ASTHMA" );
+const trait_id trait_BADBACK( "BADBACK" );
+const trait_id trait_BADCARDIO( "BADCARDIO" );
+const trait_id trait_BADHEARING( "BADHEARING" );
+const trait_id trait_BADKNEES( "BADKNEES" );
+const trait_id trait_BARK( "BARK" );
+const trait_id trait_BEAUTIFUL( "BEAUTIFUL" );
+const trait_id trait_BEAUTIFUL2( "BEAUTIFUL2" );
+const trait_id trait_BEAUTIFUL3( "BEAUTIFUL3" );
+const trait_id trait_BIRD_EYE( "BIRD_EYE" );
+const trait_id trait_CANINE_EARS( "CANINE_EARS" );
+const trait_id trait_CANNIBAL( "CANNIBAL" );
+const trait_id trait_CENOBITE( "CENOBITE" );
+const trait_id trait_CEPH_EYES( "CEPH_EYES" );
+const trait_id trait_CF_HAIR( "CF_HAIR" );
+const trait_id trait_CHAOTIC( "CHAOTIC" );
+const trait_id trait_CHEMIMBALANCE( "CHEMIMBALANCE" );
+const trait_id trait_CHITIN2( "CHITIN2" );
+const trait_id trait_CHITIN3( "CHITIN3" );
+const trait_id trait_CHITIN_FUR( "CHITIN_FUR" );
+const trait_id trait_CHITIN_FUR2( "CHITIN_FUR2" );
+const trait_id trait_CHITIN_FUR3( "CHITIN_FUR3" );
+const trait_id trait_CHLOROMORPH( "CHLOROMORPH" );
+const trait_id trait_CLUMSY( "CLUMSY" );
+const trait_id trait_COLDBLOOD( "COLDBLOOD" );
+const trait_id trait_COLDBLOOD2( "COLDBLOOD2" );
+const trait_id trait_COLDBLOOD3( "COLDBLOOD3" );
+const trait_id trait_COLDBLOOD4( "COLDBLOOD4" );
+const trait_id trait_COMPOUND_EYES( "COMPOUND_EYES" );
+const trait_id trait_DEBUG_CLOAK( "DEBUG_CLOAK" );
+const trait_id trait_DEBUG_HS( "DEBUG_HS" );
+const trait_id trait_DEBUG_LS( "DEBUG_LS" );
+const trait_id trait_DEBUG_NODMG( "DEBUG_NODMG" );
+const trait_id trait_DEBUG_NOTEMP( "DEBUG_NOTEMP" );
+const trait_id trait_DEFORMED( "DEFORMED" );
+const trait_id trait_DEFORMED2( "DEFORMED2" );
+const trait_id trait_DEFORMED3( "DEFORMED3" );
+const trait_id trait_DISIMMUNE( "DISIMMUNE" );
+const trait_id trait_DISRESISTANT( "DISRESISTANT" );
+const trait_id trait_DOWN( "DOWN" );
+const trait_id trait_EAGLEEYED( "EAGLEEYED" );
+const trait_id trait_EASYSLEEPER( "EASYSLEEPER" );
+const trait_id trait_EATHEALTH( "EATHEALTH" );
+const trait_id trait_FASTHEALER( "FASTHEALER" );
+const trait_id trait_FASTHEALER2( "FASTHEALER2" );
+const trait_id trait_FASTLEARNER( "FASTLEARNER" );
+const trait_id trait_FASTREADER( "FASTREADER" );
+const trait_id trait_FAT( "FAT" );
+const trait_id trait_FELINE_EARS( "FELINE_EARS" );
+const trait_id trait_FELINE_FUR( "FELINE_FUR" );
+const trait_id trait_FLEET( "FLEET" );
+const trait_id trait_FLEET2( "FLEET2" );
+const trait_id trait_FLIMSY( "FLIMSY" );
+const trait_id trait_FLIMSY2( "FLIMSY2" );
+const trait_id trait_FLIMSY3( "FLIMSY3" );
+const trait_id trait_FLOWERS( "FLOWERS" );
+const trait_id trait_FORGETFUL( "FORGETFUL" );
+const trait_id trait_FUR( "FUR" );
+const trait_id trait_GILLS( "GILLS" );
+const trait_id trait_GILLS_CEPH( "GILLS_CEPH" );
+const trait_id trait_GOODCARDIO( "GOODCARDIO" );
+const trait_id trait_GOODHEARING( "GOODHEARING" );
+const trait_id trait_GOODMEMORY( "GOODMEMORY" );
+const trait_id trait_HEAVYSLEEPER( "HEAVYSLEEPER" );
+const trait_id trait_HEAVYSLEEPER2( "HEAVYSLEEPER2" );
+const trait_id trait_HIBERNATE( "HIBERNATE" );
+const trait_id trait_HOARDER( "HOARDER" );
+const trait_id trait_HOLLOW_BONES( "HOLLOW_BONES" );
+const trait_id trait_HOOVES( "HOOVES" );
+const trait_id trait_HORNS_POINTED( "HORNS_POINTED" );
+const trait_id trait_HUGE( "HUGE" );
+const trait_id trait_HUGE_OK( "HUGE_OK" );
+const trait_id trait_HYPEROPIC( "HYPEROPIC" );
+const trait_id trait_ILLITERATE( "ILLITERATE" );
+const trait_id trait_INFIMMUNE( "INFIMMUNE" );
+const trait_id trait_INFRESIST( "INFRESIST" );
+const trait_id trait_INSECT_ARMS( "INSECT_ARMS" );
+const trait_id trait_INSECT_ARMS_OK( "INSECT_ARMS_OK" );
+const trait_id trait_INSOMNIA( "INSOMNIA" );
+const trait_id trait_INT_SLIME( "INT_SLIME" );
+const trait_id trait_JITTERY( "JITTERY" );
+const trait_id trait_LARGE( "LARGE" );
+const trait_id trait_LARGE_OK( "LARGE_OK" );
+const trait_id trait_LEAVES( "LEAVES" );
+const trait_id trait_LEG_TENTACLES( "LEG_TENTACLES" );
+const trait_id trait_LEG_TENT_BRACE( "LEG_TENT_BRACE" );
+const trait_id trait_LIGHTFUR( "LIGHTFUR" );
+const trait_id trait_LIGHTSTEP( "LIGHTSTEP" );
+const trait_id trait_LIGHT_BONES( "LIGHT_BONES" );
+const trait_id trait_LUPINE_EARS( "LUPINE_EARS" );
+const trait_id trait_LUPINE_FUR( "LUPINE_FUR" );
+const trait_id trait_MEMBRANE( "MEMBRANE" );
+const trait_id trait_MET_RAT( "MET_RAT" );
+const trait_id trait_MOODSWINGS( "MOODSWINGS" );
+const trait_id trait_MYOPIC( "MYOPIC" );
+const trait_id trait_M_BLOSSOMS( "M_BLOSSOMS" );
+const trait_id trait_M_IMMUNE( "M_IMMUNE" );
+const trait_id trait_M_SKIN2( "M_SKIN2" );
+const trait_id trait_M_SPORES( "M_SPORES" );
+const trait_id trait_NAUSEA( "NAUSEA" );
+const trait_id trait_NONADDICTIVE( "NONADDICTIVE" );
+const trait_id trait_NOPAIN( "NOPAIN" );
+const trait_id trait_PACIFIST( "PACIFIST" );
+const trait_id trait_PADDED_FEET( "PADDED_FEET" );
+const trait_id trait_PAINREC1( "PAINREC1" );
+const trait_id trait_PAINREC2( "PAINREC2" );
+const trait_id trait_PAINREC3( "PAINREC3" );
+const trait_id trait_PAINRESIST( "PAINRESIST" );
+const trait_id trait_PAINRESIST_TROGLO( "PAINRESIST_TROGLO" );
+const trait_id trait_PARAIMMUNE( "PARAIMMUNE" );
+const trait_id trait_PARKOUR( "PARKOUR" );
+const trait_id trait_PAWS( "PAWS" );
+const trait_id trait_PAWS_LARGE( "PAWS_LARGE" );
+const trait_id trait_PER_SLIME( "PER_SLIME" );
+const trait_id trait_PER_SLIME_OK( "PER_SLIME_OK" );
+const trait_id trait_PLANTSKIN( "PLANTSKIN" );
+const trait_id trait_PONDEROUS1( "PONDEROUS1" );
+const trait_id trait_PONDEROUS2( "PONDEROUS2" );
+const trait_id trait_PONDEROUS3( "PONDEROUS3" );
+const trait_id trait_PRED2( "PRED2" );
+const trait_id trait_PRED3( "PRED3" );
+const trait_id trait_PRED4( "PRED4" );
+const trait_id trait_PRETTY( "PRETTY" );
+const trait_id trait_PSYCHOPATH( "PSYCHOPATH" );
+const trait_id trait_QUICK( "QUICK" );
+const trait_id trait_QUILLS( "QUILLS" );
+const trait_id trait_RADIOACTIVE1( "RADIOACTIVE1" );
+const trait_id trait_RADIOACTIVE2( "RADIOACTIVE2" );
+const trait_id trait_RADIOACTIVE3( "RADIOACTIVE3" );
+const trait_id trait_RADIOGENIC( "RADIOGENIC" );
+const trait_id trait_REGEN( "REGEN" );
+const trait_id trait_REGEN_LIZ( "REGEN_LIZ" );
+const trait_id trait_ROOTS2( "ROOTS2" );
+const trait_id trait_ROOTS3( "ROOTS3" );
+const trait_id trait_ROT2( "ROT2" );
+const trait_id trait_ROT3( "ROT3" );
+const trait_id trait_SAPIOVORE( "SAPIOVORE" );
+const trait_id trait_SAVANT( "SAVANT" );
+const trait_id trait_SCHIZOPHRENIC( "SCHIZOPHRENIC" );
+const trait_id trait_SELFAWARE( "SELFAWARE" );
+const trait_id trait_SHOUT1( "SHOUT1" );
+const trait_id trait_SHOUT2( "SHOUT2" );
+const trait_id trait_SHOUT3( "SHOUT3" );
+const trait_id trait_SLEEK_SCALES( "SLEEK_SCALES" );
+const trait_id trait_SLEEPY( "SLEEPY" );
+const trait_id trait_SLEEPY2( "SLEEPY2" );
+const trait_id trait_SLIMESPAWNER( "SLIMESPAWNER" );
+const trait_id trait_SLIMY( "SLIMY" );
+const trait_id trait_SLOWHEALER( "SLOWHEALER" );
+const trait_id trait_SLOWLEARNER( "SLOWLEARNER" );
+const trait_id trait_SLOWREADER( "SLOWREADER" );
+const trait_id trait_SLOWRUNNER( "SLOWRUNNER" );
+const trait_id trait_SMELLY( "SMELLY" );
+const trait_id trait_SMELLY2( "SMELLY2" );
+const trait_id trait_SORES( "SORES" );
+const trait_id trait_SPINES( "SPINES" );
+const trait_id trait_SPIRITUAL( "SPIRITUAL" );
+const trait_id trait_SQUEAMISH( "SQUEAMISH" );
+const trait_id trait_STRONGSTOMACH( "STRONGSTOMACH" );
+const trait_id trait_SUNBURN( "SUNBURN" );
+const trait_id trait_SUNLIGHT_DEPENDENT( "SUNLIGHT_DEPENDENT" );
+const trait_id trait_TAIL_FIN( "TAIL_FIN" );
+const trait_id trait_THICK_SCALES( "THICK_SCALES" );
+const trait_id trait_THIRST( "THIRST" );
+const trait_id trait_THIRST2( "THIRST2" );
+const trait_id trait_THIRST3( "THIRST3" );
+const trait_id trait_THORNS( "THORNS" );
+const trait_id trait_THRESH_FELINE( "THRESH_FELINE" );
+const trait_id trait_THRESH_MYCUS( "THRESH_MYCUS" );
+const trait_id trait_THRESH_SPIDER( "THRESH_SPIDER" );
+const trait_id trait_TOUGH_FEET( "TOUGH_FEET" );
+const trait_id trait_TROGLO( "TROGLO" );
+const trait_id trait_TROGLO2( "TROGLO2" );
+const trait_id trait_TROGLO3( "TROGLO3" );
+const trait_id trait_UGLY( "UGLY" );
+const trait_id trait_UNSTABLE( "UNSTABLE" );
+const trait_id trait_URSINE_EARS( "URSINE_EARS" );
+const trait_id trait_URSINE_EYE( "URSINE_EYE" );
+const trait_id trait_URSINE_FUR( "URSINE_FUR" );
+const trait_id trait_VISCOUS( "VISCOUS" );
+const trait_id trait_VOMITOUS( "VOMITOUS" );
+const trait_id trait_WAKEFUL( "WAKEFUL" );
+const trait_id trait_WAKEFUL2( "WAKEFUL2" );
+const trait_id trait_WAKEFUL3( "WAKEFUL3" );
+const trait_id trait_WEAKSCENT( "WEAKSCENT" );
+const trait_id trait_WEAKSTOMACH( "WEAKSTOMACH" );
+const trait_id trait_WEBBED( "WEBBED" );
+const trait_id trait_WEB_SPINNER( "WEB_SPINNER" );
+const trait_id trait_WEB_WALKER( "WEB_WALKER" );
+const trait_id trait_WEB_WEAVER( "WEB_WEAVER" );
+const trait_id trait_WHISKERS( "WHISKERS" );
+const trait_id trait_WHISKERS_RAT( "WHISKERS_RAT" );
+const trait_id trait_WINGS_BUTTERFLY( "WINGS_BUTTERFLY" );
+const trait_id trait_WOOLALLERGY( "WOOLALLERGY" );
+
 const matype_id style_none( "style_none" );
 
 const vitamin_id vitamin_iron( "iron" );
@@ -221,13 +427,13 @@ static stat_mod get_pain_penalty( const player &p )
 
     int stat_penalty = std::floor( std::pow( pain, 0.8f ) / 10.0f );
 
-    bool ceno = p.has_trait( "CENOBITE" );
+    bool ceno = p.has_trait( trait_CENOBITE );
     if( !ceno ) {
         ret.strength = stat_penalty;
         ret.dexterity = stat_penalty;
     }
 
-    if( !p.has_trait( "INT_SLIME" ) ) {
+    if( !p.has_trait( trait_INT_SLIME ) ) {
         ret.intelligence = 1 + stat_penalty;
     } else {
         ret.intelligence = 1 + pain / 5;
@@ -378,19 +584,19 @@ void player::reset_stats()
     clear_miss_reasons();
 
     // Trait / mutation buffs
-    if( has_trait( "THICK_SCALES" ) ) {
+    if( has_trait( trait_THICK_SCALES ) ) {
         add_miss_reason( _( "Your thick scales get in the way." ), 2 );
     }
-    if( has_trait( "CHITIN2" ) || has_trait( "CHITIN3" ) || has_trait( "CHITIN_FUR3" ) ) {
+    if( has_trait( trait_CHITIN2 ) || has_trait( trait_CHITIN3 ) || has_trait( trait_CHITIN_FUR3 ) ) {
         add_miss_reason( _( "Your chitin gets in the way." ), 1 );
     }
-    if( has_trait( "COMPOUND_EYES" ) && !wearing_something_on( bp_eyes ) ) {
+    if( has_trait( trait_COMPOUND_EYES ) && !wearing_something_on( bp_eyes ) ) {
         mod_per_bonus( 1 );
     }
-    if( has_trait( "INSECT_ARMS" ) ) {
+    if( has_trait( trait_INSECT_ARMS ) ) {
         add_miss_reason( _( "Your insect limbs get in the way." ), 2 );
     }
-    if( has_trait( "INSECT_ARMS_OK" ) ) {
+    if( has_trait( trait_INSECT_ARMS_OK ) ) {
         if( !wearing_something_on( bp_torso ) ) {
             mod_dex_bonus( 1 );
         } else {
@@ -398,13 +604,13 @@ void player::reset_stats()
             add_miss_reason( _( "Your clothing restricts your insect arms." ), 1 );
         }
     }
-    if( has_trait( "WEBBED" ) ) {
+    if( has_trait( trait_WEBBED ) ) {
         add_miss_reason( _( "Your webbed hands get in the way." ), 1 );
     }
-    if( has_trait( "ARACHNID_ARMS" ) ) {
+    if( has_trait( trait_ARACHNID_ARMS ) ) {
         add_miss_reason( _( "Your arachnid limbs get in the way." ), 4 );
     }
-    if( has_trait( "ARACHNID_ARMS_OK" ) ) {
+    if( has_trait( trait_ARACHNID_ARMS_OK ) ) {
         if( !wearing_something_on( bp_torso ) ) {
             mod_dex_bonus( 2 );
         } else if( !exclusive_flag_coverage( "OVERSIZE" )[bp_torso] ) {
@@ -484,14 +690,14 @@ void player::reset_stats()
                      ( encumb( bp_leg_l ) + encumb( bp_leg_r ) ) / 20.0f -
                      ( encumb( bp_torso ) / 10.0f ) );
     // Whiskers don't work so well if they're covered
-    if( has_trait( "WHISKERS" ) && !wearing_something_on( bp_mouth ) ) {
+    if( has_trait( trait_WHISKERS ) && !wearing_something_on( bp_mouth ) ) {
         mod_dodge_bonus( 1 );
     }
-    if( has_trait( "WHISKERS_RAT" ) && !wearing_something_on( bp_mouth ) ) {
+    if( has_trait( trait_WHISKERS_RAT ) && !wearing_something_on( bp_mouth ) ) {
         mod_dodge_bonus( 2 );
     }
     // Spider hair is basically a full-body set of whiskers, once you get the brain for it
-    if( has_trait( "CHITIN_FUR3" ) ) {
+    if( has_trait( trait_CHITIN_FUR3 ) ) {
         static const std::array<body_part, 5> parts {{bp_head, bp_arm_r, bp_arm_l, bp_leg_r, bp_leg_l}};
         for( auto bp : parts ) {
             if( !wearing_something_on( bp ) ) {
@@ -518,15 +724,12 @@ void player::reset_stats()
     recalc_speed_bonus();
 
     // Effects
-    for( auto maps : effects ) {
-        for( auto i : maps.second ) {
-            const auto &it = i.second;
-            bool reduced = resists_effect( it );
-            mod_str_bonus( it.get_mod( "STR", reduced ) );
-            mod_dex_bonus( it.get_mod( "DEX", reduced ) );
-            mod_per_bonus( it.get_mod( "PER", reduced ) );
-            mod_int_bonus( it.get_mod( "INT", reduced ) );
-        }
+    for( const effect &it : effects ) {
+        bool reduced = resists_effect( it );
+        mod_str_bonus( it.get_mod( "STR", reduced ) );
+        mod_dex_bonus( it.get_mod( "DEX", reduced ) );
+        mod_per_bonus( it.get_mod( "PER", reduced ) );
+        mod_int_bonus( it.get_mod( "INT", reduced ) );
     }
 
     Character::reset_stats();
@@ -534,6 +737,7 @@ void player::reset_stats()
 
 void player::process_turn()
 {
+    profiler::scoped_timer timer( profiler::PROF_CHAR_TURN );
     Character::process_turn();
 
     // Didn't just pick something up
@@ -554,25 +758,25 @@ void player::process_turn()
 
     // Set our scent towards the norm
     int norm_scent = 500;
-    if( has_trait( "WEAKSCENT" ) ) {
+    if( has_trait( trait_WEAKSCENT ) ) {
         norm_scent = 300;
     }
-    if( has_trait( "SMELLY" ) ) {
+    if( has_trait( trait_SMELLY ) ) {
         norm_scent = 800;
     }
-    if( has_trait( "SMELLY2" ) ) {
+    if( has_trait( trait_SMELLY2 ) ) {
         norm_scent = 1200;
     }
     // Not so much that you don't have a scent
     // but that you smell like a plant, rather than
     // a human. When was the last time you saw a critter
     // attack a bluebell or an apple tree?
-    if( ( has_trait( "FLOWERS" ) ) && ( !( has_trait( "CHLOROMORPH" ) ) ) ) {
+    if( ( has_trait( trait_FLOWERS ) ) && ( !( has_trait( trait_CHLOROMORPH ) ) ) ) {
         norm_scent -= 200;
     }
     // You *are* a plant.  Unless someone hunts triffids by scent,
     // you don't smell like prey.
-    if( has_trait( "CHLOROMORPH" ) ) {
+    if( has_trait( trait_CHLOROMORPH ) ) {
         norm_scent = 0;
     }
 
@@ -624,7 +828,7 @@ void player::update_morale()
 void player::apply_persistent_morale()
 {
     // Hoarders get a morale penalty if they're not carrying a full inventory.
-    if( has_trait( "HOARDER" ) ) {
+    if( has_trait( trait_HOARDER ) ) {
         int pen = ( volume_capacity() - volume_carried() ) / 125_ml;
         if( pen > 70 ) {
             pen = 70;
@@ -700,7 +904,7 @@ int player::calc_focus_equilibrium() const
     int eff_morale = get_morale_level();
     // Factor in perceived pain, since it's harder to rest your mind while your body hurts.
     // Cenobites don't mind, though
-    if( !has_trait( "CENOBITE" ) ) {
+    if( !has_trait( trait_CENOBITE ) ) {
         eff_morale = eff_morale - get_perceived_pain();
     }
 
@@ -783,7 +987,7 @@ HURRICANE : 185 mph (880 hPa) [Ref: Hurricane Wilma]
 
 void player::update_bodytemp()
 {
-    if( has_trait( "DEBUG_NOTEMP" ) ) {
+    if( has_trait( trait_DEBUG_NOTEMP ) ) {
         for( int i = 0 ; i < num_bp ; i++ ) {
             temp_cur[i] = BODYTEMP_NORM;
             temp_conv[i] = BODYTEMP_NORM;
@@ -806,7 +1010,7 @@ void player::update_bodytemp()
     int total_windpower = get_local_windpower( weather.windpower + vehwindspeed, omtername, sheltered );
 
     // Let's cache this not to check it num_bp times
-    const bool has_bark = has_trait( "BARK" );
+    const bool has_bark = has_trait( trait_BARK );
     const bool has_sleep = has_effect( effect_sleep );
     const bool has_sleep_state = has_sleep || in_sleep_state();
     const bool has_heatsink = has_bionic( "bio_heatsink" ) || is_wearing( "rm13_armor_on" );
@@ -1355,7 +1559,7 @@ int player::floor_warmth( const tripoint &pos ) const
     int floor_mut_warmth = bodytemp_modifier_traits_floor();
     // DOWN doesn't provide floor insulation, though.
     // Better-than-light fur or being in one's shell does.
-    if( ( !( has_trait( "DOWN" ) ) ) && ( floor_mut_warmth >= 200 ) ) {
+    if( ( !( has_trait( trait_DOWN ) ) ) && ( floor_mut_warmth >= 200 ) ) {
         bedding_warmth = std::max( 0, bedding_warmth );
     }
     return ( item_warmth + bedding_warmth + floor_mut_warmth );
@@ -1575,11 +1779,9 @@ void player::recalc_speed_bonus()
 
     mod_speed_bonus( stim > 10 ? 10 : stim / 4 );
 
-    for( auto maps : effects ) {
-        for( auto i : maps.second ) {
-            bool reduced = resists_effect( i.second );
-            mod_speed_bonus( i.second.get_mod( "SPEED", reduced ) );
-        }
+    for( const effect &it : effects ) {
+        bool reduced = resists_effect( it );
+        mod_speed_bonus( it.get_mod( "SPEED", reduced ) );
     }
 
     // add martial arts speed bonus
@@ -1589,19 +1791,19 @@ void player::recalc_speed_bonus()
     // Ectothermic/COLDBLOOD4 is intended to buff folks in the Summer
     // Threshold-crossing has its charms ;-)
     if( g != NULL ) {
-        if( has_trait( "SUNLIGHT_DEPENDENT" ) && !g->is_in_sunlight( pos() ) ) {
+        if( has_trait( trait_SUNLIGHT_DEPENDENT ) && !g->is_in_sunlight( pos() ) ) {
             mod_speed_bonus( -( g->light_level( posz() ) >= 12 ? 5 : 10 ) );
         }
-        if( has_trait( "COLDBLOOD4" ) || ( has_trait( "COLDBLOOD3" ) && g->get_temperature() < 65 ) ) {
+        if( has_trait( trait_COLDBLOOD4 ) || ( has_trait( trait_COLDBLOOD3 ) && g->get_temperature() < 65 ) ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 2 );
-        } else if( has_trait( "COLDBLOOD2" ) && g->get_temperature() < 65 ) {
+        } else if( has_trait( trait_COLDBLOOD2 ) && g->get_temperature() < 65 ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 3 );
-        } else if( has_trait( "COLDBLOOD" ) && g->get_temperature() < 65 ) {
+        } else if( has_trait( trait_COLDBLOOD ) && g->get_temperature() < 65 ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 5 );
         }
     }
 
-    if( has_trait( "M_SKIN2" ) ) {
+    if( has_trait( trait_M_SKIN2 ) ) {
         mod_speed_bonus( -20 ); // Could be worse--you've got the armor from a (sessile!) Spire
     }
 
@@ -1612,7 +1814,7 @@ void player::recalc_speed_bonus()
         mod_speed_bonus( -20 );
     }
 
-    if( has_trait( "QUICK" ) ) { // multiply by 1.1
+    if( has_trait( trait_QUICK ) ) { // multiply by 1.1
         set_speed_bonus( int( get_speed() * 1.1 ) - get_speed_base() );
     }
     if( has_bionic( "bio_speed" ) ) { // multiply by 1.1
@@ -1637,13 +1839,13 @@ int player::run_cost( int base_cost, bool diag ) const
     // The "FLAT" tag includes soft surfaces, so not a good fit.
     const bool on_road = flatground && g->m.has_flag( "ROAD", pos() );
 
-    if( has_trait( "PARKOUR" ) && movecost > 100 ) {
+    if( has_trait( trait_PARKOUR ) && movecost > 100 ) {
         movecost *= .5f;
         if( movecost < 100 ) {
             movecost = 100;
         }
     }
-    if( has_trait( "BADKNEES" ) && movecost > 100 ) {
+    if( has_trait( trait_BADKNEES ) && movecost > 100 ) {
         movecost *= 1.25f;
         if( movecost < 100 ) {
             movecost = 100;
@@ -1662,46 +1864,46 @@ int player::run_cost( int base_cost, bool diag ) const
         movecost += 25;
     }
 
-    if( has_trait( "FLEET" ) && flatground ) {
+    if( has_trait( trait_FLEET ) && flatground ) {
         movecost *= .85f;
     }
-    if( has_trait( "FLEET2" ) && flatground ) {
+    if( has_trait( trait_FLEET2 ) && flatground ) {
         movecost *= .7f;
     }
-    if( has_trait( "SLOWRUNNER" ) && flatground ) {
+    if( has_trait( trait_SLOWRUNNER ) && flatground ) {
         movecost *= 1.15f;
     }
-    if( has_trait( "PADDED_FEET" ) && !footwear_factor() ) {
+    if( has_trait( trait_PADDED_FEET ) && !footwear_factor() ) {
         movecost *= .9f;
     }
-    if( has_trait( "LIGHT_BONES" ) ) {
+    if( has_trait( trait_LIGHT_BONES ) ) {
         movecost *= .9f;
     }
-    if( has_trait( "HOLLOW_BONES" ) ) {
+    if( has_trait( trait_HOLLOW_BONES ) ) {
         movecost *= .8f;
     }
     if( has_active_mutation( "WINGS_INSECT" ) ) {
         movecost *= .75f;
     }
-    if( has_trait( "WINGS_BUTTERFLY" ) ) {
+    if( has_trait( trait_WINGS_BUTTERFLY ) ) {
         movecost -= 10; // You can't fly, but you can make life easier on your legs
     }
-    if( has_trait( "LEG_TENTACLES" ) ) {
+    if( has_trait( trait_LEG_TENTACLES ) ) {
         movecost += 20;
     }
-    if( has_trait( "FAT" ) ) {
+    if( has_trait( trait_FAT ) ) {
         movecost *= 1.05f;
     }
-    if( has_trait( "PONDEROUS1" ) ) {
+    if( has_trait( trait_PONDEROUS1 ) ) {
         movecost *= 1.1f;
     }
-    if( has_trait( "PONDEROUS2" ) ) {
+    if( has_trait( trait_PONDEROUS2 ) ) {
         movecost *= 1.2f;
     }
-    if( has_trait( "AMORPHOUS" ) ) {
+    if( has_trait( trait_AMORPHOUS ) ) {
         movecost *= 1.25f;
     }
-    if( has_trait( "PONDEROUS3" ) ) {
+    if( has_trait( trait_PONDEROUS3 ) ) {
         movecost *= 1.3f;
     }
     if( is_wearing( "stillsuit" ) ) {
@@ -1734,8 +1936,8 @@ int player::run_cost( int base_cost, bool diag ) const
     // ROOTS3 does slow you down as your roots are probing around for nutrients,
     // whether you want them to or not.  ROOTS1 is just too squiggly without shoes
     // to give you some stability.  Plants are a bit of a slow-mover.  Deal.
-    const bool mutfeet = has_trait( "LEG_TENTACLES" ) || has_trait( "PADDED_FEET" ) ||
-                         has_trait( "HOOVES" ) || has_trait( "TOUGH_FEET" ) || has_trait( "ROOTS2" );
+    const bool mutfeet = has_trait( trait_LEG_TENTACLES ) || has_trait( trait_PADDED_FEET ) ||
+                         has_trait( trait_HOOVES ) || has_trait( trait_TOUGH_FEET ) || has_trait( trait_ROOTS2 );
     if( !is_wearing_shoes( "left" ) && !mutfeet ) {
         movecost += 8;
     }
@@ -1743,7 +1945,7 @@ int player::run_cost( int base_cost, bool diag ) const
         movecost += 8;
     }
 
-    if( !footwear_factor() && has_trait( "ROOTS3" ) &&
+    if( !footwear_factor() && has_trait( trait_ROOTS3 ) &&
         g->m.has_flag( "DIGGABLE", pos() ) ) {
         movecost += 10 * footwear_factor();
     }
@@ -1771,11 +1973,11 @@ int player::swim_speed() const
     float hand_bonus_mult = ( usable.test( bp_hand_l ) ? 0.5f : 0.0f ) +
                             ( usable.test( bp_hand_r ) ? 0.5f : 0.0f );
     ///\EFFECT_STR increases swim speed bonus from PAWS
-    if( has_trait( "PAWS" ) ) {
+    if( has_trait( trait_PAWS ) ) {
         ret -= hand_bonus_mult * ( 20 + str_cur * 3 );
     }
     ///\EFFECT_STR increases swim speed bonus from PAWS_LARGE
-    if( has_trait( "PAWS_LARGE" ) ) {
+    if( has_trait( trait_PAWS_LARGE ) ) {
         ret -= hand_bonus_mult * ( 20 + str_cur * 4 );
     }
     ///\EFFECT_STR increases swim speed bonus from swim_fins
@@ -1783,20 +1985,20 @@ int player::swim_speed() const
         ret -= ( 15 * str_cur ) / ( 3 - shoe_type_count( "swim_fins" ) );
     }
     ///\EFFECT_STR increases swim speed bonus from WEBBED
-    if( has_trait( "WEBBED" ) ) {
+    if( has_trait( trait_WEBBED ) ) {
         ret -= hand_bonus_mult * ( 60 + str_cur * 5 );
     }
     ///\EFFECT_STR increases swim speed bonus from TAIL_FIN
-    if( has_trait( "TAIL_FIN" ) ) {
+    if( has_trait( trait_TAIL_FIN ) ) {
         ret -= 100 + str_cur * 10;
     }
-    if( has_trait( "SLEEK_SCALES" ) ) {
+    if( has_trait( trait_SLEEK_SCALES ) ) {
         ret -= 100;
     }
-    if( has_trait( "LEG_TENTACLES" ) ) {
+    if( has_trait( trait_LEG_TENTACLES ) ) {
         ret -= 60;
     }
-    if( has_trait( "FAT" ) ) {
+    if( has_trait( trait_FAT ) ) {
         ret -= 30;
     }
     ///\EFFECT_SWIMMING increases swim speed
@@ -1844,15 +2046,15 @@ bool player::is_elec_immune() const
 bool player::is_immune_effect( const efftype_id &eff ) const
 {
     if( eff == effect_downed ) {
-        return is_throw_immune() || ( has_trait( "LEG_TENT_BRACE" ) && footwear_factor() == 0 );
+        return is_throw_immune() || ( has_trait( trait_LEG_TENT_BRACE ) && footwear_factor() == 0 );
     } else if( eff == effect_onfire ) {
         return is_immune_damage( DT_HEAT );
     } else if( eff == effect_deaf ) {
         return worn_with_flag( "DEAF" ) || has_bionic( "bio_ears" ) || is_wearing( "rm13_armor_on" );
     } else if( eff == effect_corroding ) {
-        return is_immune_damage( DT_ACID ) || has_trait( "SLIMY" ) || has_trait( "VISCOUS" );
+        return is_immune_damage( DT_ACID ) || has_trait( trait_SLIMY ) || has_trait( trait_VISCOUS );
     } else if( eff == effect_nausea ) {
-        return has_trait( "STRONGSTOMACH" );
+        return has_trait( trait_STRONGSTOMACH );
     }
 
     return false;
@@ -1884,11 +2086,11 @@ bool player::is_immune_damage( const damage_type dt ) const
         case DT_CUT:
             return false;
         case DT_ACID:
-            return has_trait( "ACIDPROOF" );
+            return has_trait( trait_ACIDPROOF );
         case DT_STAB:
             return false;
         case DT_HEAT:
-            return has_trait( "M_SKIN2" );
+            return has_trait( trait_M_SKIN2 );
         case DT_COLD:
             return false;
         case DT_ELECTRIC:
@@ -1955,7 +2157,7 @@ nc_color player::basic_symbol_color() const
         return c_blue;
     }
     if( has_active_bionic( "bio_cloak" ) || has_artifact_with( AEP_INVISIBLE ) ||
-        has_active_optcloak() || has_trait( "DEBUG_CLOAK" ) ) {
+        has_active_optcloak() || has_trait( trait_DEBUG_CLOAK ) ) {
         return c_dkgray;
     }
     return c_white;
@@ -2406,13 +2608,11 @@ void player::disp_info()
     std::vector<std::string> effect_name;
     std::vector<std::string> effect_text;
     std::string tmp = "";
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            tmp = _effect_it.second.disp_name();
-            if( tmp != "" ) {
-                effect_name.push_back( tmp );
-                effect_text.push_back( _effect_it.second.disp_desc() );
-            }
+    for( const effect &it : effects ) {
+        tmp = it.disp_name();
+        if( tmp != "" ) {
+            effect_name.push_back( tmp );
+            effect_text.push_back( it.disp_desc() );
         }
     }
     if( abs( get_morale_level() ) >= 100 ) {
@@ -2489,18 +2689,18 @@ void player::disp_info()
         effect_text.push_back( stim_text.str() );
     }
 
-    if( ( has_trait( "TROGLO" ) && g->is_in_sunlight( pos() ) &&
+    if( ( has_trait( trait_TROGLO ) && g->is_in_sunlight( pos() ) &&
           g->weather == WEATHER_SUNNY ) ||
-        ( has_trait( "TROGLO2" ) && g->is_in_sunlight( pos() ) &&
+        ( has_trait( trait_TROGLO2 ) && g->is_in_sunlight( pos() ) &&
           g->weather != WEATHER_SUNNY ) ) {
         effect_name.push_back( _( "In Sunlight" ) );
         effect_text.push_back( _( "The sunlight irritates you.\n\
 Strength - 1;    Dexterity - 1;    Intelligence - 1;    Perception - 1" ) );
-    } else if( has_trait( "TROGLO2" ) && g->is_in_sunlight( pos() ) ) {
+    } else if( has_trait( trait_TROGLO2 ) && g->is_in_sunlight( pos() ) ) {
         effect_name.push_back( _( "In Sunlight" ) );
         effect_text.push_back( _( "The sunlight irritates you badly.\n\
 Strength - 2;    Dexterity - 2;    Intelligence - 2;    Perception - 2" ) );
-    } else if( has_trait( "TROGLO3" ) && g->is_in_sunlight( pos() ) ) {
+    } else if( has_trait( trait_TROGLO3 ) && g->is_in_sunlight( pos() ) ) {
         effect_name.push_back( _( "In Sunlight" ) );
         effect_text.push_back( _( "The sunlight irritates you terribly.\n\
 Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4" ) );
@@ -2854,24 +3054,24 @@ Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4" ) );
                    ( pen < 10 ? " " : "" ), pen );
         line++;
     }
-    if( has_trait( "SUNLIGHT_DEPENDENT" ) && !g->is_in_sunlight( pos() ) ) {
+    if( has_trait( trait_SUNLIGHT_DEPENDENT ) && !g->is_in_sunlight( pos() ) ) {
         pen = ( g->light_level( posz() ) >= 12 ? 5 : 10 );
         mvwprintz( w_speed, line, 1, c_red, _( "Out of Sunlight     -%s%d%%" ),
                    ( pen < 10 ? " " : "" ), pen );
         line++;
     }
-    if( has_trait( "COLDBLOOD4" ) && g->get_temperature() > 65 ) {
+    if( has_trait( trait_COLDBLOOD4 ) && g->get_temperature() > 65 ) {
         pen = ( g->get_temperature() - 65 ) / 2;
         mvwprintz( w_speed, line, 1, c_green, _( "Cold-Blooded        +%s%d%%" ),
                    ( pen < 10 ? " " : "" ), pen );
         line++;
     }
-    if( ( has_trait( "COLDBLOOD" ) || has_trait( "COLDBLOOD2" ) ||
-          has_trait( "COLDBLOOD3" ) || has_trait( "COLDBLOOD4" ) ) &&
+    if( ( has_trait( trait_COLDBLOOD ) || has_trait( trait_COLDBLOOD2 ) ||
+          has_trait( trait_COLDBLOOD3 ) || has_trait( trait_COLDBLOOD4 ) ) &&
         g->get_temperature() < 65 ) {
-        if( has_trait( "COLDBLOOD3" ) || has_trait( "COLDBLOOD4" ) ) {
+        if( has_trait( trait_COLDBLOOD3 ) || has_trait( trait_COLDBLOOD4 ) ) {
             pen = ( 65 - g->get_temperature() ) / 2;
-        } else if( has_trait( "COLDBLOOD2" ) ) {
+        } else if( has_trait( trait_COLDBLOOD2 ) ) {
             pen = ( 65 - g->get_temperature() ) / 3;
         } else {
             pen = ( 65 - g->get_temperature() ) / 5;
@@ -2883,15 +3083,12 @@ Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4" ) );
 
     std::map<std::string, int> speed_effects;
     std::string dis_text = "";
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = resists_effect( it );
-            int move_adjust = it.get_mod( "SPEED", reduced );
-            if( move_adjust != 0 ) {
-                dis_text = it.get_speed_name();
-                speed_effects[dis_text] += move_adjust;
-            }
+    for( const effect &it : effects ) {
+        bool reduced = resists_effect( it );
+        int move_adjust = it.get_mod( "SPEED", reduced );
+        if( move_adjust != 0 ) {
+            dis_text = it.get_speed_name();
+            speed_effects[dis_text] += move_adjust;
         }
     }
 
@@ -2906,11 +3103,11 @@ Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4" ) );
 
     int quick_bonus = int( newmoves - ( newmoves / 1.1 ) );
     int bio_speed_bonus = quick_bonus;
-    if( has_trait( "QUICK" ) && has_bionic( "bio_speed" ) ) {
+    if( has_trait( trait_QUICK ) && has_bionic( "bio_speed" ) ) {
         bio_speed_bonus = int( newmoves / 1.1 - ( newmoves / 1.1 / 1.1 ) );
         std::swap( quick_bonus, bio_speed_bonus );
     }
-    if( has_trait( "QUICK" ) ) {
+    if( has_trait( trait_QUICK ) ) {
         mvwprintz( w_speed, line, 1, c_green, _( "Quick               +%s%d%%" ),
                    ( quick_bonus < 10 ? " " : "" ), quick_bonus );
         line++;
@@ -3618,9 +3815,9 @@ void player::disp_status( WINDOW *w, WINDOW *w2 )
         morale_str = "8D";
     } else if( morale_cur >= 100 ) {
         morale_str = ":D";
-    } else if( has_trait( "THRESH_FELINE" ) && morale_cur >= 10 ) {
+    } else if( has_trait( trait_THRESH_FELINE ) && morale_cur >= 10 ) {
         morale_str = ":3";
-    } else if( !has_trait( "THRESH_FELINE" ) && morale_cur >= 10 ) {
+    } else if( !has_trait( trait_THRESH_FELINE ) && morale_cur >= 10 ) {
         morale_str = ":)";
     } else if( morale_cur > -10 ) {
         morale_str = ":|";
@@ -4074,11 +4271,11 @@ int player::overmap_sight_range( int light_level ) const
     if( sight <= SEEX * 4 ) {
         return ( sight / ( SEEX / 2 ) );
     }
-    sight = has_trait( "BIRD_EYE" ) ? 15 : 10;
+    sight = has_trait( trait_BIRD_EYE ) ? 15 : 10;
     bool has_optic = ( has_item_with_flag( "ZOOM" ) || has_bionic( "bio_eye_optic" ) );
-    if( has_optic && has_trait( "EAGLEEYED" ) ) {
+    if( has_optic && has_trait( trait_EAGLEEYED ) ) {
         sight += 15;
-    } else if( has_optic != has_trait( "EAGLEEYED" ) ) {
+    } else if( has_optic != has_trait( trait_EAGLEEYED ) ) {
         sight += 10;
     }
     return sight;
@@ -4101,17 +4298,17 @@ int player::clairvoyance() const
 bool player::sight_impaired() const
 {
     return ( ( ( has_effect( effect_boomered ) || has_effect( effect_darkness ) ) &&
-               ( !( has_trait( "PER_SLIME_OK" ) ) ) ) ||
-             ( underwater && !has_bionic( "bio_membrane" ) && !has_trait( "MEMBRANE" ) &&
-               !worn_with_flag( "SWIM_GOGGLES" ) && !has_trait( "PER_SLIME_OK" ) &&
-               !has_trait( "CEPH_EYES" ) ) ||
-             ( ( has_trait( "MYOPIC" ) || has_trait( "URSINE_EYE" ) ) &&
+               ( !( has_trait( trait_PER_SLIME_OK ) ) ) ) ||
+             ( underwater && !has_bionic( "bio_membrane" ) && !has_trait( trait_MEMBRANE ) &&
+               !worn_with_flag( "SWIM_GOGGLES" ) && !has_trait( trait_PER_SLIME_OK ) &&
+               !has_trait( trait_CEPH_EYES ) ) ||
+             ( ( has_trait( trait_MYOPIC ) || has_trait( trait_URSINE_EYE ) ) &&
                !is_wearing( "glasses_eye" ) &&
                !is_wearing( "glasses_monocle" ) &&
                !is_wearing( "glasses_bifocal" ) &&
                !has_effect( effect_contacts ) &&
                !has_bionic( "bio_eye_optic") ) ||
-                has_trait( "PER_SLIME" ) );
+                has_trait( trait_PER_SLIME ) );
 }
 
 bool player::has_two_arms() const
@@ -4135,11 +4332,11 @@ bool player::avoid_trap( const tripoint &pos, const trap &tr ) const
         traproll = dice( 6, tr.get_avoidance() );
     }
 
-    if( has_trait( "LIGHTSTEP" ) ) {
+    if( has_trait( trait_LIGHTSTEP ) ) {
         myroll += dice( 2, 6 );
     }
 
-    if( has_trait( "CLUMSY" ) ) {
+    if( has_trait( trait_CLUMSY ) ) {
         myroll -= dice( 2, 6 );
     }
 
@@ -4266,7 +4463,7 @@ void player::shout( std::string msg )
     int shout_multiplier = 2;
 
     // Mutations make shouting louder, they also define the defualt message
-    if ( has_trait("SHOUT2") ) {
+    if ( has_trait( trait_SHOUT2 ) ) {
         base = 15;
         shout_multiplier = 3;
         if ( msg.empty() ) {
@@ -4274,7 +4471,7 @@ void player::shout( std::string msg )
         }
     }
 
-    if ( has_trait("SHOUT3") ) {
+    if ( has_trait( trait_SHOUT3 ) ) {
         shout_multiplier = 4;
         base = 20;
         if ( msg.empty() ) {
@@ -4304,7 +4501,7 @@ void player::shout( std::string msg )
 
     // Screaming underwater is not good for oxygen and harder to do overall
     if ( underwater ) {
-        if ( !has_trait("GILLS") && !has_trait("GILLS_CEPH") ) {
+        if ( !has_trait( trait_GILLS ) && !has_trait( trait_GILLS_CEPH ) ) {
             mod_stat( "oxygen", -noise );
         }
 
@@ -4396,11 +4593,11 @@ int player::read_speed(bool return_stat_effect) const
     const int intel = get_int();
     ///\EFFECT_INT increases reading speed
     int ret = 1000 - 50 * (intel - 8);
-    if( has_trait("FASTREADER") ) {
+    if( has_trait( trait_FASTREADER ) ) {
         ret *= .8;
     }
 
-    if( has_trait("SLOWREADER") ) {
+    if( has_trait( trait_SLOWREADER ) ) {
         ret *= 1.3;
     }
 
@@ -4422,11 +4619,11 @@ int player::rust_rate(bool return_stat_effect) const
     ///\EFFECT_INT reduces skill rust
     int ret = ((get_option<std::string>( "SKILL_RUST" ) == "vanilla" || get_option<std::string>( "SKILL_RUST" ) == "capped") ? 500 : 500 - 35 * (intel - 8));
 
-    if (has_trait("FORGETFUL")) {
+    if (has_trait( trait_FORGETFUL )) {
         ret *= 1.33;
     }
 
-    if (has_trait("GOODMEMORY")) {
+    if (has_trait( trait_GOODMEMORY )) {
         ret *= .66;
     }
 
@@ -4446,23 +4643,23 @@ int player::talk_skill() const
 
     ///\EFFECT_SPEECH increases talking skill
     int ret = get_int() + get_per() + get_skill_level( skill_id( "speech" ) ) * 3;
-    if (has_trait("SAPIOVORE")) {
+    if (has_trait( trait_SAPIOVORE )) {
         ret -= 20; // Friendly convo with your prey? unlikely
-    } else if (has_trait("UGLY")) {
+    } else if (has_trait( trait_UGLY )) {
         ret -= 3;
-    } else if (has_trait("DEFORMED")) {
+    } else if (has_trait( trait_DEFORMED )) {
         ret -= 6;
-    } else if (has_trait("DEFORMED2")) {
+    } else if (has_trait( trait_DEFORMED2 )) {
         ret -= 12;
-    } else if (has_trait("DEFORMED3")) {
+    } else if (has_trait( trait_DEFORMED3 )) {
         ret -= 18;
-    } else if (has_trait("PRETTY")) {
+    } else if (has_trait( trait_PRETTY )) {
         ret += 1;
-    } else if (has_trait("BEAUTIFUL")) {
+    } else if (has_trait( trait_BEAUTIFUL )) {
         ret += 2;
-    } else if (has_trait("BEAUTIFUL2")) {
+    } else if (has_trait( trait_BEAUTIFUL2 )) {
         ret += 4;
-    } else if (has_trait("BEAUTIFUL3")) {
+    } else if (has_trait( trait_BEAUTIFUL3 )) {
         ret += 6;
     }
     return ret;
@@ -4480,15 +4677,15 @@ int player::intimidation() const
         weapon.damage_melee( DT_STAB ) >= 12 ) {
         ret += 5;
     }
-    if (has_trait("SAPIOVORE")) {
+    if (has_trait( trait_SAPIOVORE )) {
         ret += 5; // Scaring one's prey, on the other claw...
-    } else if (has_trait("DEFORMED2")) {
+    } else if (has_trait( trait_DEFORMED2 )) {
         ret += 3;
-    } else if (has_trait("DEFORMED3")) {
+    } else if (has_trait( trait_DEFORMED3 )) {
         ret += 6;
-    } else if (has_trait("PRETTY")) {
+    } else if (has_trait( trait_PRETTY )) {
         ret -= 1;
-    } else if (has_trait("BEAUTIFUL") || has_trait("BEAUTIFUL2") || has_trait("BEAUTIFUL3")) {
+    } else if (has_trait( trait_BEAUTIFUL ) || has_trait( trait_BEAUTIFUL2 ) || has_trait( trait_BEAUTIFUL3 )) {
         ret -= 4;
     }
     if (stim > 20) {
@@ -4555,24 +4752,24 @@ void player::on_hit( Creature *source, body_part bp_hit,
         ods_shock_damage.add_damage(DT_ELECTRIC, rng(10,40));
         source->deal_damage(this, bp_torso, ods_shock_damage);
     }
-    if ((!(wearing_something_on(bp_hit))) && (has_trait("SPINES") || has_trait("QUILLS"))) {
-        int spine = rng(1, (has_trait("QUILLS") ? 20 : 8));
+    if ((!(wearing_something_on(bp_hit))) && (has_trait( trait_SPINES ) || has_trait( trait_QUILLS ))) {
+        int spine = rng(1, (has_trait( trait_QUILLS ) ? 20 : 8));
         if (!is_player()) {
             if( u_see ) {
                 add_msg(_("%1$s's %2$s puncture %3$s in mid-attack!"), name.c_str(),
-                            (has_trait("QUILLS") ? _("quills") : _("spines")),
+                            (has_trait( trait_QUILLS ) ? _("quills") : _("spines")),
                             source->disp_name().c_str());
             }
         } else {
             add_msg(m_good, _("Your %1$s puncture %2$s in mid-attack!"),
-                            (has_trait("QUILLS") ? _("quills") : _("spines")),
+                            (has_trait( trait_QUILLS ) ? _("quills") : _("spines")),
                             source->disp_name().c_str());
         }
         damage_instance spine_damage;
         spine_damage.add_damage(DT_STAB, spine);
         source->deal_damage(this, bp_torso, spine_damage);
     }
-    if ((!(wearing_something_on(bp_hit))) && (has_trait("THORNS")) && (!(source->has_weapon()))) {
+    if ((!(wearing_something_on(bp_hit))) && (has_trait( trait_THORNS )) && (!(source->has_weapon()))) {
         if (!is_player()) {
             if( u_see ) {
                 add_msg(_("%1$s's %2$s scrape %3$s in mid-attack!"), name.c_str(),
@@ -4588,7 +4785,7 @@ void player::on_hit( Creature *source, body_part bp_hit,
         // so safer to target the torso
         source->deal_damage(this, bp_torso, thorn_damage);
     }
-    if ((!(wearing_something_on(bp_hit))) && (has_trait("CF_HAIR"))) {
+    if ((!(wearing_something_on(bp_hit))) && (has_trait( trait_CF_HAIR ))) {
         if (!is_player()) {
             if( u_see ) {
                 add_msg(_("%1$s gets a load of %2$s's %3$s stuck in!"), source->disp_name().c_str(),
@@ -4606,7 +4803,7 @@ void player::on_hit( Creature *source, body_part bp_hit,
 
 void player::on_hurt( Creature *source, bool disturb /*= true*/ )
 {
-    if( has_trait("ADRENALINE") && !has_effect( effect_adrenaline ) &&
+    if( has_trait( trait_ADRENALINE ) && !has_effect( effect_adrenaline ) &&
         (hp_cur[hp_head] < 25 || hp_cur[hp_torso] < 15) ) {
         add_effect( effect_adrenaline, 200 );
     }
@@ -4634,7 +4831,7 @@ bool player::immune_to( body_part bp, damage_unit dam ) const
     if( dam.type == DT_HEAT ) {
         return false; // No one is immune to fire
     }
-    if( has_trait( "DEBUG_NODMG" ) || is_immune_damage( dam.type ) ) {
+    if( has_trait( trait_DEBUG_NODMG ) || is_immune_damage( dam.type ) ) {
         return true;
     }
 
@@ -4651,7 +4848,7 @@ bool player::immune_to( body_part bp, damage_unit dam ) const
 
 dealt_damage_instance player::deal_damage(Creature* source, body_part bp, const damage_instance& d)
 {
-    if( has_trait( "DEBUG_NODMG" ) ) {
+    if( has_trait( trait_DEBUG_NODMG ) ) {
         return dealt_damage_instance();
     }
 
@@ -4701,7 +4898,7 @@ dealt_damage_instance player::deal_damage(Creature* source, body_part bp, const
     }
 
     // And slimespawners too
-    if ((has_trait("SLIMESPAWNER")) && (dam >= 10) && one_in(20 - dam)) {
+    if ((has_trait( trait_SLIMESPAWNER )) && (dam >= 10) && one_in(20 - dam)) {
         std::vector<tripoint> valid;
         for (int x = posx() - 1; x <= posx() + 1; x++) {
             for (int y = posy() - 1; y <= posy() + 1; y++) {
@@ -4725,7 +4922,7 @@ dealt_damage_instance player::deal_damage(Creature* source, body_part bp, const
     //Acid blood effects.
     bool u_see = g->u.sees(*this);
     int cut_dam = dealt_dams.type_damage(DT_CUT);
-    if( source && has_trait("ACIDBLOOD") && !one_in(3) &&
+    if( source && has_trait( trait_ACIDBLOOD ) && !one_in(3) &&
         (dam >= 4 || cut_dam > 0) && (rl_dist(g->u.pos(), source->pos()) <= 1)) {
         if (is_player()) {
             add_msg(m_good, _("Your acidic blood splashes %s in mid-attack!"),
@@ -4819,14 +5016,14 @@ dealt_damage_instance player::deal_damage(Creature* source, body_part bp, const
 
 void player::mod_pain(int npain) {
     if( npain > 0 ) {
-        if( has_trait( "NOPAIN" ) ) {
+        if( has_trait( trait_NOPAIN ) ) {
             return;
         }
         if( npain > 1 ) {
             // if it's 1 it'll just become 0, which is bad
-            if( has_trait( "PAINRESIST_TROGLO" ) ) {
+            if( has_trait( trait_PAINRESIST_TROGLO ) ) {
                 npain = roll_remainder( npain * 0.5f );
-            } else if( has_trait( "PAINRESIST" ) ) {
+            } else if( has_trait( trait_PAINRESIST ) ) {
                 npain = roll_remainder( npain * 0.67f );
             }
         }
@@ -4893,9 +5090,9 @@ void player::react_to_felt_pain( int intensity )
     if( in_sleep_state() ) {
         int pain_thresh = rng( 3, 5 );
 
-        if( has_trait( "HEAVYSLEEPER" ) ) {
+        if( has_trait( trait_HEAVYSLEEPER ) ) {
             pain_thresh += 2;
-        } else if ( has_trait( "HEAVYSLEEPER2" ) ) {
+        } else if ( has_trait( trait_HEAVYSLEEPER2 ) ) {
             pain_thresh += 5;
         }
 
@@ -4911,7 +5108,7 @@ void player::react_to_felt_pain( int intensity )
  */
 void player::apply_damage(Creature *source, body_part hurt, int dam)
 {
-    if( is_dead_state() || has_trait( "DEBUG_NODMG" ) ) {
+    if( is_dead_state() || has_trait( trait_DEBUG_NODMG ) ) {
         // don't do any more damage if we're already dead
         // Or if we're debugging and don't want to die
         return;
@@ -5001,7 +5198,7 @@ void player::healall(int dam)
 
 void player::hurtall(int dam, Creature *source, bool disturb /*= true*/)
 {
-    if( is_dead_state() || has_trait( "DEBUG_NODMG" ) || dam <= 0 ) {
+    if( is_dead_state() || has_trait( trait_DEBUG_NODMG ) || dam <= 0 ) {
         return;
     }
 
@@ -5050,7 +5247,7 @@ float player::fall_damage_mod() const
     // 100% damage at 0, 75% at 10, 50% at 20 and so on
     ret *= (100.0f - (dex_dodge * 4.0f)) / 100.0f;
 
-    if( has_trait("PARKOUR") ) {
+    if( has_trait( trait_PARKOUR ) ) {
         ret *= 2.0f / 3.0f;
     }
 
@@ -5353,7 +5550,7 @@ void player::update_body( int from, int to )
 
     if( ticks_between( from, to, HOURS(6) ) ) {
         // Radiation kills health even at low doses
-        update_health( has_trait( "RADIOGENIC" ) ? 0 : -radiation );
+        update_health( has_trait( trait_RADIOGENIC ) ? 0 : -radiation );
     }
 }
 
@@ -5392,7 +5589,7 @@ void player::update_vitamins( const vitamin_id& vit )
 void player::get_sick()
 {
     // NPCs are too dumb to handle infections now
-    if( is_npc() || has_trait("DISIMMUNE") ) {
+    if( is_npc() || has_trait( trait_DISIMMUNE ) ) {
         // In a shocking twist, disease immunity prevents diseases.
         return;
     }
@@ -5405,7 +5602,7 @@ void player::get_sick()
 
     // Normal people get sick about 2-4 times/year.
     int base_diseases_per_year = 3;
-    if (has_trait("DISRESISTANT")) {
+    if (has_trait( trait_DISRESISTANT )) {
         // Disease resistant people only get sick once a year.
         base_diseases_per_year = 1;
     }
@@ -5459,7 +5656,7 @@ void player::check_needs_extremes()
                            pgettext("memorial_female", "Died of a drug overdose."));
         hp_cur[hp_torso] = 0;
     } else if( has_effect( effect_jetinjector ) && get_effect_dur( effect_jetinjector ) > 400 ) {
-        if (!(has_trait("NOPAIN"))) {
+        if (!(has_trait( trait_NOPAIN ))) {
             add_msg_if_player(m_bad, _("Your heart spasms painfully and stops."));
         } else {
             add_msg_if_player(_("Your heart spasms and stops."));
@@ -5555,7 +5752,7 @@ void player::update_needs( int rate_multiplier )
     // Hunger, thirst, & fatigue up every 5 minutes
     effect &sleep = get_effect( effect_sleep );
     // No food/thirst/fatigue clock at all
-    const bool debug_ls = has_trait( "DEBUG_LS" );
+    const bool debug_ls = has_trait( trait_DEBUG_LS );
     // No food/thirst, capped fatigue clock (only up to tired)
     const bool npc_no_food = is_npc() && get_world_option<bool>( "NO_NPC_FOOD" );
     const bool foodless = debug_ls || npc_no_food;
@@ -5567,18 +5764,18 @@ void player::update_needs( int rate_multiplier )
     add_msg_if_player( m_debug, "Metabolic rate: %.2f", hunger_rate );
 
     float thirst_rate = 1.0f;
-    if( has_trait("PLANTSKIN") ) {
+    if( has_trait( trait_PLANTSKIN ) ) {
         thirst_rate -= 0.2f;
     }
     if( is_wearing("stillsuit") ) {
         thirst_rate -= 0.3f;
     }
 
-    if( has_trait("THIRST") ) {
+    if( has_trait( trait_THIRST ) ) {
         thirst_rate += 0.5f;
-    } else if( has_trait("THIRST2") ) {
+    } else if( has_trait( trait_THIRST2 ) ) {
         thirst_rate += 1.0f;
-    } else if( has_trait("THIRST3") ) {
+    } else if( has_trait( trait_THIRST3 ) ) {
         thirst_rate += 2.0f;
     }
 
@@ -5617,27 +5814,27 @@ void player::update_needs( int rate_multiplier )
     if( get_fatigue() < 1050 && !asleep && !debug_ls ) {
         float fatigue_rate = 1.0f;
         // Wakeful folks don't always gain fatigue!
-        if( has_trait("WAKEFUL") ) {
+        if( has_trait( trait_WAKEFUL ) ) {
             fatigue_rate -= (1.0f / 6.0f);
-        } else if( has_trait("WAKEFUL2") ) {
+        } else if( has_trait( trait_WAKEFUL2 ) ) {
             fatigue_rate -= 0.25f;
-        } else if( has_trait("WAKEFUL3") ) {
+        } else if( has_trait( trait_WAKEFUL3 ) ) {
             // You're looking at over 24 hours to hit Tired here
             fatigue_rate -= 0.5f;
         }
         // Sleepy folks gain fatigue faster; Very Sleepy is twice as fast as typical
-        if( has_trait("SLEEPY") ) {
+        if( has_trait( trait_SLEEPY ) ) {
             fatigue_rate += (1.0f / 3.0f);
-        } else if( has_trait("SLEEPY2") ) {
+        } else if( has_trait( trait_SLEEPY2 ) ) {
             fatigue_rate += 1.0f;
         }
 
-        if( has_trait("MET_RAT") ) {
+        if( has_trait( trait_MET_RAT ) ) {
             fatigue_rate += 0.5f;
         }
 
         // Freakishly Huge folks tire quicker
-        if( has_trait("HUGE") ) {
+        if( has_trait( trait_HUGE ) ) {
             fatigue_rate += (1.0f / 6.0f);
         }
 
@@ -5657,14 +5854,14 @@ void player::update_needs( int rate_multiplier )
 
         // You fatigue & recover faster with Sleepy
         // Very Sleepy, you just fatigue faster
-        if( !hibernating && ( has_trait("SLEEPY") || has_trait("MET_RAT") ) ) {
+        if( !hibernating && ( has_trait( trait_SLEEPY ) || has_trait( trait_MET_RAT ) ) ) {
             recovery_rate += (1.0f + accelerated_recovery_rate) / 2.0f;
         }
 
         // Tireless folks recover fatigue really fast
         // as well as gaining it really slowly
         // (Doesn't speed healing any, though...)
-        if( !hibernating && has_trait("WAKEFUL3") ) {
+        if( !hibernating && has_trait( trait_WAKEFUL3 ) ) {
             recovery_rate += (1.0f + accelerated_recovery_rate) / 2.0f;
         }
 
@@ -5706,7 +5903,7 @@ void player::update_needs( int rate_multiplier )
     }
 
     // Huge folks take penalties for cramming themselves in vehicles
-    if( in_vehicle && (has_trait("HUGE") || has_trait("HUGE_OK")) ) {
+    if( in_vehicle && (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) ) {
         // TODO: Make NPCs complain
         add_msg_if_player(m_bad, _("You're cramping up from stuffing yourself in this vehicle."));
         mod_pain_noresist( 2 * rng(2, 3) );
@@ -5730,9 +5927,9 @@ void player::regen( int rate_multiplier )
 
     float heal_rate = 0.0f;
     // Mutation healing effects
-    if( has_trait("FASTHEALER2") ) {
+    if( has_trait( trait_FASTHEALER2 ) ) {
         heal_rate += 0.2f;
-    } else if( has_trait("REGEN") ) {
+    } else if( has_trait( trait_REGEN ) ) {
         heal_rate += 0.5f;
     }
 
@@ -5742,9 +5939,9 @@ void player::regen( int rate_multiplier )
     }
 
     float hurt_rate = 0.0f;
-    if( has_trait("ROT2") ) {
+    if( has_trait( trait_ROT2 ) ) {
         hurt_rate += 0.2f;
-    } else if( has_trait("ROT3") ) {
+    } else if( has_trait( trait_ROT3 ) ) {
         hurt_rate += 0.5f;
     }
 
@@ -5815,13 +6012,13 @@ bool player::is_hibernating() const
 void player::sleep_hp_regen( int rate_multiplier )
 {
     float heal_chance = get_healthy() / 400.0f;
-    if( has_trait("FASTHEALER") || has_trait("MET_RAT") ) {
+    if( has_trait( trait_FASTHEALER ) || has_trait( trait_MET_RAT ) ) {
         heal_chance += 1.0f;
-    } else if (has_trait("FASTHEALER2")) {
+    } else if (has_trait( trait_FASTHEALER2 )) {
         heal_chance += 1.5f;
-    } else if (has_trait("REGEN")) {
+    } else if (has_trait( trait_REGEN )) {
         heal_chance += 2.0f;
-    } else if (has_trait("SLOWHEALER")) {
+    } else if (has_trait( trait_SLOWHEALER )) {
         heal_chance += 0.13f;
     } else {
         heal_chance += 0.25f;
@@ -5831,11 +6028,11 @@ void player::sleep_hp_regen( int rate_multiplier )
         heal_chance /= 7.0f;
     }
 
-    if( has_trait("FLIMSY") ) {
+    if( has_trait( trait_FLIMSY ) ) {
         heal_chance /= (4.0f / 3.0f);
-    } else if( has_trait("FLIMSY2") ) {
+    } else if( has_trait( trait_FLIMSY2 ) ) {
         heal_chance /= 2.0f;
-    } else if( has_trait("FLIMSY3") ) {
+    } else if( has_trait( trait_FLIMSY3 ) ) {
         heal_chance /= 4.0f;
     }
 
@@ -5851,10 +6048,10 @@ void player::add_addiction(add_type type, int strength)
         return;
     }
     int timer = HOURS( 2 );
-    if( has_trait( "ADDICTIVE" ) ) {
+    if( has_trait( trait_ADDICTIVE ) ) {
         strength *= 2;
         timer = HOURS( 1 );
-    } else if( has_trait( "NONADDICTIVE" ) ) {
+    } else if( has_trait( trait_NONADDICTIVE ) ) {
         strength /= 2;
         timer = HOURS( 6 );
     }
@@ -5972,7 +6169,7 @@ void player::cough(bool harmful, int loudness)
 
 void player::add_pain_msg(int val, body_part bp) const
 {
-    if (has_trait("NOPAIN")) {
+    if (has_trait( trait_NOPAIN )) {
         return;
     }
     if (bp == num_bp) {
@@ -6013,7 +6210,7 @@ void player::print_health() const
         return;
     }
     int current_health = get_healthy();
-    if( has_trait( "SELFAWARE" ) ) {
+    if( has_trait( trait_SELFAWARE ) ) {
         add_msg_if_player( "Your current health value is: %d", current_health );
     }
 
@@ -6117,12 +6314,12 @@ void player::process_effects() {
     if (has_effect( effect_darkness ) && g->is_in_sunlight(pos())) {
         remove_effect( effect_darkness );
     }
-    if (has_trait("M_IMMUNE") && has_effect( effect_fungus )) {
+    if (has_trait( trait_M_IMMUNE ) && has_effect( effect_fungus )) {
         vomit();
         remove_effect( effect_fungus );
         add_msg_if_player(m_bad,  _("We have mistakenly colonized a local guide!  Purging now."));
     }
-    if (has_trait("PARAIMMUNE") && (has_effect( effect_dermatik ) || has_effect( effect_tapeworm ) ||
+    if (has_trait( trait_PARAIMMUNE ) && (has_effect( effect_dermatik ) || has_effect( effect_tapeworm ) ||
           has_effect( effect_bloodworms ) || has_effect( effect_brainworms ) || has_effect( effect_paincysts )) ) {
         remove_effect( effect_dermatik );
         remove_effect( effect_tapeworm );
@@ -6131,17 +6328,17 @@ void player::process_effects() {
         remove_effect( effect_paincysts );
         add_msg_if_player(m_good, _("Something writhes and inside of you as it dies."));
     }
-    if (has_trait("ACIDBLOOD") && (has_effect( effect_dermatik ) || has_effect( effect_bloodworms ) ||
+    if (has_trait( trait_ACIDBLOOD ) && (has_effect( effect_dermatik ) || has_effect( effect_bloodworms ) ||
           has_effect( effect_brainworms ))) {
         remove_effect( effect_dermatik );
         remove_effect( effect_bloodworms );
         remove_effect( effect_brainworms );
     }
-    if (has_trait("EATHEALTH") && has_effect( effect_tapeworm ) ) {
+    if (has_trait( trait_EATHEALTH ) && has_effect( effect_tapeworm ) ) {
         remove_effect( effect_tapeworm );
         add_msg_if_player(m_good, _("Your bowels gurgle as something inside them dies."));
     }
-    if (has_trait("INFIMMUNE") && (has_effect( effect_bite ) || has_effect( effect_infected ) ||
+    if (has_trait( trait_INFIMMUNE ) && (has_effect( effect_bite ) || has_effect( effect_infected ) ||
           has_effect( effect_recover ) ) ) {
         remove_effect( effect_bite );
         remove_effect( effect_infected );
@@ -6152,214 +6349,211 @@ void player::process_effects() {
     }
 
     //Human only effects
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = resists_effect(it);
-            double mod = 1;
-            body_part bp = it.get_bp();
-            int val = 0;
-
-            // Still hardcoded stuff, do this first since some modify their other traits
-            hardcoded_effects(it);
-
-            // Handle miss messages
-            auto msgs = it.get_miss_msgs();
-            if (!msgs.empty()) {
-                for (auto i : msgs) {
-                    add_miss_reason(_(i.first.c_str()), unsigned(i.second));
-                }
+    effects.for_each_safe( [this]( effect & it ) {
+        bool reduced = resists_effect(it);
+        double mod = 1;
+        body_part bp = it.get_bp();
+        int val = 0;
+
+        // Still hardcoded stuff, do this first since some modify their other traits
+        hardcoded_effects(it);
+
+        // Handle miss messages
+        auto msgs = it.get_miss_msgs();
+        if (!msgs.empty()) {
+            for (auto i : msgs) {
+                add_miss_reason(_(i.first.c_str()), unsigned(i.second));
             }
+        }
 
-            // Handle health mod
-            val = it.get_mod("H_MOD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
-                    int bounded = bound_mod_to_vals(
-                            get_healthy_mod(), val, it.get_max_val("H_MOD", reduced),
-                            it.get_min_val("H_MOD", reduced));
-                    // This already applies bounds, so we pass them through.
-                    mod_healthy_mod(bounded, get_healthy_mod() + bounded);
-                }
+        // Handle health mod
+        val = it.get_mod("H_MOD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
+                int bounded = bound_mod_to_vals(
+                        get_healthy_mod(), val, it.get_max_val("H_MOD", reduced),
+                        it.get_min_val("H_MOD", reduced));
+                // This already applies bounds, so we pass them through.
+                mod_healthy_mod(bounded, get_healthy_mod() + bounded);
             }
+        }
 
-            // Handle health
-            val = it.get_mod("HEALTH", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
-                    mod_healthy(bound_mod_to_vals(get_healthy(), val,
-                                it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
-                }
+        // Handle health
+        val = it.get_mod("HEALTH", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
+                mod_healthy(bound_mod_to_vals(get_healthy(), val,
+                            it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
             }
+        }
 
-            // Handle stim
-            val = it.get_mod("STIM", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
-                    stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
-                                                it.get_min_val("STIM", reduced));
-                }
+        // Handle stim
+        val = it.get_mod("STIM", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
+                stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
+                                            it.get_min_val("STIM", reduced));
             }
+        }
 
-            // Handle hunger
-            val = it.get_mod("HUNGER", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
-                    mod_hunger(bound_mod_to_vals(get_hunger(), val, it.get_max_val("HUNGER", reduced),
-                                                it.get_min_val("HUNGER", reduced)));
-                }
+        // Handle hunger
+        val = it.get_mod("HUNGER", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
+                mod_hunger(bound_mod_to_vals(get_hunger(), val, it.get_max_val("HUNGER", reduced),
+                                            it.get_min_val("HUNGER", reduced)));
             }
+        }
 
-            // Handle thirst
-            val = it.get_mod("THIRST", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
-                    mod_thirst(bound_mod_to_vals(get_thirst(), val, it.get_max_val("THIRST", reduced),
-                                                it.get_min_val("THIRST", reduced)));
-                }
+        // Handle thirst
+        val = it.get_mod("THIRST", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
+                mod_thirst(bound_mod_to_vals(get_thirst(), val, it.get_max_val("THIRST", reduced),
+                                            it.get_min_val("THIRST", reduced)));
             }
+        }
 
-            // Handle fatigue
-            val = it.get_mod("FATIGUE", reduced);
-            // Prevent ongoing fatigue effects while asleep.
-            // These are meant to change how fast you get tired, not how long you sleep.
-            if (val != 0 && !in_sleep_state()) {
-                mod = 1;
-                if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
-                    mod_fatigue(bound_mod_to_vals(get_fatigue(), val, it.get_max_val("FATIGUE", reduced),
-                                                it.get_min_val("FATIGUE", reduced)));
-                }
+        // Handle fatigue
+        val = it.get_mod("FATIGUE", reduced);
+        // Prevent ongoing fatigue effects while asleep.
+        // These are meant to change how fast you get tired, not how long you sleep.
+        if (val != 0 && !in_sleep_state()) {
+            mod = 1;
+            if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
+                mod_fatigue(bound_mod_to_vals(get_fatigue(), val, it.get_max_val("FATIGUE", reduced),
+                                            it.get_min_val("FATIGUE", reduced)));
             }
+        }
 
-            // Handle Radiation
-            val = it.get_mod("RAD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
-                    radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
-                    // Radiation can't go negative
-                    if (radiation < 0) {
-                        radiation = 0;
-                    }
+        // Handle Radiation
+        val = it.get_mod("RAD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
+                radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
+                // Radiation can't go negative
+                if (radiation < 0) {
+                    radiation = 0;
                 }
             }
+        }
 
-            // Handle Pain
-            val = it.get_mod("PAIN", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("PAIN")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+        // Handle Pain
+        val = it.get_mod("PAIN", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("PAIN")) {
+                if (has_trait( trait_FAT )) {
+                    mod *= 1.5;
                 }
-                if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
-                    int pain_inc = bound_mod_to_vals(get_pain(), val, it.get_max_val("PAIN", reduced), 0);
-                    mod_pain(pain_inc);
-                    if (pain_inc > 0) {
-                        add_pain_msg(val, bp);
-                    }
+                if (has_trait( trait_LARGE ) || has_trait( trait_LARGE_OK )) {
+                    mod *= 2;
                 }
-            }
-
-            // Handle Damage
-            val = it.get_mod("HURT", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("HURT")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+                if (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) {
+                    mod *= 3;
                 }
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    if (bp == num_bp) {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
-                        }
-                        apply_damage(nullptr, bp_torso, val);
-                    } else {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
-                        }
-                        apply_damage(nullptr, bp, val);
-                    }
+            }
+            if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
+                int pain_inc = bound_mod_to_vals(get_pain(), val, it.get_max_val("PAIN", reduced), 0);
+                mod_pain(pain_inc);
+                if (pain_inc > 0) {
+                    add_pain_msg(val, bp);
                 }
             }
+        }
 
-            // Handle Sleep
-            val = it.get_mod("SLEEP", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
-                    add_msg_if_player(_("You pass out!"));
-                    fall_asleep(val);
+        // Handle Damage
+        val = it.get_mod("HURT", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("HURT")) {
+                if (has_trait( trait_FAT )) {
+                    mod *= 1.5;
+                }
+                if (has_trait( trait_LARGE ) || has_trait( trait_LARGE_OK )) {
+                    mod *= 2;
+                }
+                if (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) {
+                    mod *= 3;
                 }
             }
-
-            // Handle painkillers
-            val = it.get_mod("PKILL", reduced);
-            if (val != 0) {
-                mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
-                if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
-                    mod_painkiller(bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0));
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                if (bp == num_bp) {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
+                    }
+                    apply_damage(nullptr, bp_torso, val);
+                } else {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
+                    }
+                    apply_damage(nullptr, bp, val);
                 }
             }
+        }
 
-            // Handle coughing
+        // Handle Sleep
+        val = it.get_mod("SLEEP", reduced);
+        if (val != 0) {
             mod = 1;
-            val = 0;
-            if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
-                cough(it.get_harmful_cough());
+            if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
+                add_msg_if_player(_("You pass out!"));
+                fall_asleep(val);
             }
+        }
 
-            // Handle vomiting
-            mod = vomit_mod();
-            val = 0;
-            if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
-                vomit();
+        // Handle painkillers
+        val = it.get_mod("PKILL", reduced);
+        if (val != 0) {
+            mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
+            if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
+                mod_painkiller(bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0));
             }
+        }
 
-            // Handle stamina
-            val = it.get_mod("STAMINA", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "STAMINA", val, reduced, mod)) {
-                    stamina += bound_mod_to_vals( stamina, val,
-                                                  it.get_max_val("STAMINA", reduced),
-                                                  it.get_min_val("STAMINA", reduced) );
-                    if( stamina < 0 ) {
-                        // TODO: Make it drain fatigue and/or oxygen?
-                        stamina = 0;
-                    } else if( stamina > get_stamina_max() ) {
-                        stamina = get_stamina_max();
-                    }
+        // Handle coughing
+        mod = 1;
+        val = 0;
+        if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
+            cough(it.get_harmful_cough());
+        }
+
+        // Handle vomiting
+        mod = vomit_mod();
+        val = 0;
+        if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
+            vomit();
+        }
+
+        // Handle stamina
+        val = it.get_mod("STAMINA", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "STAMINA", val, reduced, mod)) {
+                stamina += bound_mod_to_vals( stamina, val,
+                                              it.get_max_val("STAMINA", reduced),
+                                              it.get_min_val("STAMINA", reduced) );
+                if( stamina < 0 ) {
+                    // TODO: Make it drain fatigue and/or oxygen?
+                    stamina = 0;
+                } else if( stamina > get_stamina_max() ) {
+                    stamina = get_stamina_max();
                 }
             }
-
-            // Speed and stats are handled in recalc_speed_bonus and reset_stats respectively
         }
-    }
+
+        // Speed and stats are handled in recalc_speed_bonus and reset_stats respectively
+    } );
 
     Creature::process_effects();
 }
@@ -6385,7 +6579,7 @@ void player::hardcoded_effects(effect &it)
         deal_damage( nullptr, bp, damage_instance( DT_HEAT, rng( intense, intense * 2 ) ) );
     } else if( id == effect_spores ) {
         // Equivalent to X in 150000 + health * 100
-        if ((!has_trait("M_IMMUNE")) && (one_in(100) && x_in_y(intense, 150 + get_healthy() / 10)) ) {
+        if ((!has_trait( trait_M_IMMUNE )) && (one_in(100) && x_in_y(intense, 150 + get_healthy() / 10)) ) {
             add_effect( effect_fungus, 1, num_bp, true );
         }
     } else if( id == effect_fungus ) {
@@ -7135,7 +7329,7 @@ void player::hardcoded_effects(effect &it)
             }
         }
         if (one_in(10000)) {
-            if (!has_trait("M_IMMUNE")) {
+            if (!has_trait( trait_M_IMMUNE )) {
                 add_effect( effect_fungus, 1, num_bp, true );
             } else {
                 add_msg_if_player(m_info, _("We have many colonists awaiting passage."));
@@ -7276,7 +7470,7 @@ void player::hardcoded_effects(effect &it)
         }
 
         if( dur > 18000 && one_in( MINUTES( 5 ) * 512 ) ) {
-            if( !has_trait( "NOPAIN" ) ) {
+            if( !has_trait( trait_NOPAIN ) ) {
                 add_msg_if_player(m_bad, _("Your heart spasms painfully and stops, dragging you back to reality as you die."));
             } else {
                 add_msg_if_player(_("You dissolve into beautiful paroxysms of energy.  Life fades from your nebulae and you are no more."));
@@ -7326,7 +7520,7 @@ void player::hardcoded_effects(effect &it)
             if (has_effect( effect_recover )) {
                 recover_factor -= get_effect_dur( effect_recover ) / 600;
             }
-            if (has_trait("INFRESIST")) {
+            if (has_trait( trait_INFRESIST )) {
                 recover_factor += 200;
             }
             recover_factor += get_healthy() / 10;
@@ -7359,7 +7553,7 @@ void player::hardcoded_effects(effect &it)
             if (has_effect( effect_recover )) {
                 recover_factor -= get_effect_dur( effect_recover ) / 600;
             }
-            if (has_trait("INFRESIST")) {
+            if (has_trait( trait_INFRESIST )) {
                 recover_factor += 200;
             }
             recover_factor += get_healthy() / 10;
@@ -7445,7 +7639,7 @@ void player::hardcoded_effects(effect &it)
         }
 
         // TODO: Move this to update_needs when NPCs can mutate
-        if( calendar::once_every(MINUTES(10)) && has_trait("CHLOROMORPH") &&
+        if( calendar::once_every(MINUTES(10)) && has_trait( trait_CHLOROMORPH ) &&
             g->is_in_sunlight(pos()) ) {
             // Hunger and thirst fall before your Chloromorphic physiology!
             if (get_hunger() >= -30) {
@@ -7482,7 +7676,7 @@ void player::hardcoded_effects(effect &it)
                     add_msg_if_player( "%s", dream.c_str() );
                 }
                 // Mycus folks upgrade in their sleep.
-                if (has_trait("THRESH_MYCUS")) {
+                if (has_trait( trait_THRESH_MYCUS )) {
                     if (one_in(8)) {
                         mutate_category("MUTCAT_MYCUS");
                         mod_hunger(10);
@@ -7496,7 +7690,7 @@ void player::hardcoded_effects(effect &it)
         bool woke_up = false;
         int tirednessVal = rng(5, 200) + rng(0, abs(get_fatigue() * 2 * 5));
         if( !is_blind() ) {
-            if (has_trait("HEAVYSLEEPER2") && !has_trait("HIBERNATE")) {
+            if (has_trait( trait_HEAVYSLEEPER2 ) && !has_trait( trait_HIBERNATE )) {
                 // So you can too sleep through noon
                 if ((tirednessVal * 1.25) < g->m.ambient_light_at(pos()) && (get_fatigue() < 10 || one_in(get_fatigue() / 2))) {
                     add_msg_if_player(_("It's too bright to sleep."));
@@ -7505,7 +7699,7 @@ void player::hardcoded_effects(effect &it)
                     woke_up = true;
                 }
              // Ursine hibernators would likely do so indoors.  Plants, though, might be in the sun.
-            } else if (has_trait("HIBERNATE")) {
+            } else if (has_trait( trait_HIBERNATE )) {
                 if ((tirednessVal * 5) < g->m.ambient_light_at(pos()) && (get_fatigue() < 10 || one_in(get_fatigue() / 2))) {
                     add_msg_if_player(_("It's too bright to sleep."));
                     // Set ourselves up for removal
@@ -7568,10 +7762,10 @@ void player::hardcoded_effects(effect &it)
                     // It's much harder to ignore an alarm inside your own skull,
                     // so this uses an effective volume of 20.
                     const int volume = 20;
-                    if ( (!(has_trait("HEAVYSLEEPER") || has_trait("HEAVYSLEEPER2")) &&
+                    if ( (!(has_trait( trait_HEAVYSLEEPER ) || has_trait( trait_HEAVYSLEEPER2 )) &&
                           dice(2, 15) < volume) ||
-                          (has_trait("HEAVYSLEEPER") && dice(3, 15) < volume) ||
-                          (has_trait("HEAVYSLEEPER2") && dice(6, 15) < volume) ) {
+                          (has_trait( trait_HEAVYSLEEPER ) && dice(3, 15) < volume) ||
+                          (has_trait( trait_HEAVYSLEEPER2 ) && dice(6, 15) < volume) ) {
                         wake_up();
                         add_msg_if_player(_("Your internal chronometer wakes you up."));
                     } else {
@@ -7598,16 +7792,16 @@ double player::vomit_mod()
     if (has_effect( effect_weed_high )) {
         mod *= .1;
     }
-    if (has_trait("STRONGSTOMACH")) {
+    if (has_trait( trait_STRONGSTOMACH )) {
         mod *= .5;
     }
-    if (has_trait("WEAKSTOMACH")) {
+    if (has_trait( trait_WEAKSTOMACH )) {
         mod *= 2;
     }
-    if (has_trait("NAUSEA")) {
+    if (has_trait( trait_NAUSEA )) {
         mod *= 3;
     }
-    if (has_trait("VOMITOUS")) {
+    if (has_trait( trait_VOMITOUS )) {
         mod *= 3;
     }
     // If you're already nauseous, any food in your stomach greatly
@@ -7670,7 +7864,7 @@ void player::suffer()
     }
 
     if (underwater) {
-        if (!has_trait("GILLS") && !has_trait("GILLS_CEPH")) {
+        if (!has_trait( trait_GILLS ) && !has_trait( trait_GILLS_CEPH )) {
             oxygen--;
         }
         if (oxygen < 12 && worn_with_flag("REBREATHER")) {
@@ -7693,7 +7887,7 @@ void player::suffer()
     }
 
     double shoe_factor = footwear_factor();
-    if( has_trait("ROOTS3") && g->m.has_flag("DIGGABLE", pos()) && !shoe_factor) {
+    if( has_trait( trait_ROOTS3 ) && g->m.has_flag("DIGGABLE", pos()) && !shoe_factor) {
         if (one_in(100)) {
             add_msg_if_player(m_good, _("This soil is delicious!"));
             if (get_hunger() > -20) {
@@ -7729,9 +7923,9 @@ void player::suffer()
             }
         }
         int timer = -HOURS( 6 );
-        if( has_trait( "ADDICTIVE" ) ) {
+        if( has_trait( trait_ADDICTIVE ) ) {
             timer = -HOURS( 10 );
-        } else if( has_trait( "NONADDICTIVE" ) ) {
+        } else if( has_trait( trait_NONADDICTIVE ) ) {
             timer = -HOURS( 3 );
         }
         for( size_t i = 0; i < addictions.size(); i++ ) {
@@ -7752,8 +7946,8 @@ void player::suffer()
                 }
             }
         }
-        if (has_trait("CHEMIMBALANCE")) {
-            if (one_in(3600) && (!(has_trait("NOPAIN")))) {
+        if (has_trait( trait_CHEMIMBALANCE )) {
+            if (one_in(3600) && (!(has_trait( trait_NOPAIN )))) {
                 add_msg_if_player(m_bad, _("You suddenly feel sharp pain for no reason."));
                 mod_pain( 3 * rng(1, 3) );
             }
@@ -7761,7 +7955,7 @@ void player::suffer()
                 int pkilladd = 5 * rng(-1, 2);
                 if (pkilladd > 0) {
                     add_msg_if_player(m_bad, _("You suddenly feel numb."));
-                } else if ((pkilladd < 0) && (!(has_trait("NOPAIN")))) {
+                } else if ((pkilladd < 0) && (!(has_trait( trait_NOPAIN )))) {
                     add_msg_if_player(m_bad, _("You suddenly ache."));
                 }
                 mod_painkiller(pkilladd);
@@ -7821,7 +8015,7 @@ void player::suffer()
                 }
             }
         }
-        if ((has_trait("SCHIZOPHRENIC") || has_artifact_with(AEP_SCHIZO)) &&
+        if ((has_trait( trait_SCHIZOPHRENIC ) || has_artifact_with(AEP_SCHIZO)) &&
             one_in(2400)) { // Every 4 hours or so
             monster phantasm;
             int i;
@@ -7876,7 +8070,7 @@ void player::suffer()
                     break;
             }
         }
-        if (has_trait("JITTERY") && !has_effect( effect_shakes )) {
+        if (has_trait( trait_JITTERY ) && !has_effect( effect_shakes )) {
             if (stim > 50 && one_in(300 - stim)) {
                 add_effect( effect_shakes, 300 + stim );
             } else if (get_hunger() > 80 && one_in(500 - get_hunger())) {
@@ -7884,7 +8078,7 @@ void player::suffer()
             }
         }
 
-        if (has_trait("MOODSWINGS") && one_in(3600)) {
+        if (has_trait( trait_MOODSWINGS ) && one_in(3600)) {
             if (rng(1, 20) > 9) { // 55% chance
                 add_morale(MORALE_MOODSWING, -100, -500);
             } else {  // 45% chance
@@ -7892,28 +8086,28 @@ void player::suffer()
             }
         }
 
-        if (has_trait("VOMITOUS") && one_in(4200)) {
+        if (has_trait( trait_VOMITOUS ) && one_in(4200)) {
             vomit();
         }
 
-        if (has_trait("SHOUT1") && one_in(3600)) {
+        if (has_trait( trait_SHOUT1 ) && one_in(3600)) {
             shout();
         }
-        if (has_trait("SHOUT2") && one_in(2400)) {
+        if (has_trait( trait_SHOUT2 ) && one_in(2400)) {
             shout();
         }
-        if (has_trait("SHOUT3") && one_in(1800)) {
+        if (has_trait( trait_SHOUT3 ) && one_in(1800)) {
             shout();
         }
-        if (has_trait("M_SPORES") && one_in(2400)) {
+        if (has_trait( trait_M_SPORES ) && one_in(2400)) {
             spores();
         }
-        if (has_trait("M_BLOSSOMS") && one_in(1800)) {
+        if (has_trait( trait_M_BLOSSOMS ) && one_in(1800)) {
             blossoms();
         }
     } // Done with while-awake-only effects
 
-    if( has_trait("ASTHMA") && one_in(3600 - stim * 50) &&
+    if( has_trait( trait_ASTHMA ) && one_in(3600 - stim * 50) &&
         !has_effect( effect_adrenaline ) & !has_effect( effect_datura ) ) {
         bool auto_use = has_charges("inhaler", 1);
         if (underwater) {
@@ -7948,23 +8142,23 @@ void player::suffer()
         }
     }
 
-    if (has_trait("LEAVES") && g->is_in_sunlight(pos()) && one_in(600)) {
+    if (has_trait( trait_LEAVES ) && g->is_in_sunlight(pos()) && one_in(600)) {
         mod_hunger(-1);
     }
 
     if (get_pain() > 0) {
-        if (has_trait("PAINREC1") && one_in(600)) {
+        if (has_trait( trait_PAINREC1 ) && one_in(600)) {
             mod_pain( -1 );
         }
-        if (has_trait("PAINREC2") && one_in(300)) {
+        if (has_trait( trait_PAINREC2 ) && one_in(300)) {
             mod_pain( -1 );
         }
-        if (has_trait("PAINREC3") && one_in(150)) {
+        if (has_trait( trait_PAINREC3 ) && one_in(150)) {
             mod_pain( -1 );
         }
     }
 
-    if( ( has_trait( "ALBINO" ) || has_effect( effect_datura ) ) &&
+    if( ( has_trait( trait_ALBINO ) || has_effect( effect_datura ) ) &&
         g->is_in_sunlight( pos() ) && one_in(10) ) {
         // Umbrellas can keep the sun off the skin and sunglasses - off the eyes.
         if( !weapon.has_flag( "RAIN_PROTECT" ) ) {
@@ -7986,7 +8180,7 @@ void player::suffer()
         }
     }
 
-    if (has_trait("SUNBURN") && g->is_in_sunlight(pos()) && one_in(10)) {
+    if (has_trait( trait_SUNBURN ) && g->is_in_sunlight(pos()) && one_in(10)) {
         if( !( weapon.has_flag( "RAIN_PROTECT" ) ) ) {
         add_msg(m_bad, _("The sunlight burns your skin!"));
         if (in_sleep_state()) {
@@ -7997,7 +8191,7 @@ void player::suffer()
         }
     }
 
-    if((has_trait("TROGLO") || has_trait("TROGLO2")) &&
+    if((has_trait( trait_TROGLO ) || has_trait( trait_TROGLO2 )) &&
         g->is_in_sunlight(pos()) && g->weather == WEATHER_SUNNY) {
         mod_str_bonus(-1);
         mod_dex_bonus(-1);
@@ -8005,14 +8199,14 @@ void player::suffer()
         mod_int_bonus(-1);
         mod_per_bonus(-1);
     }
-    if (has_trait("TROGLO2") && g->is_in_sunlight(pos())) {
+    if (has_trait( trait_TROGLO2 ) && g->is_in_sunlight(pos())) {
         mod_str_bonus(-1);
         mod_dex_bonus(-1);
         add_miss_reason(_("The sunlight distracts you."), 1);
         mod_int_bonus(-1);
         mod_per_bonus(-1);
     }
-    if (has_trait("TROGLO3") && g->is_in_sunlight(pos())) {
+    if (has_trait( trait_TROGLO3 ) && g->is_in_sunlight(pos())) {
         mod_str_bonus(-4);
         mod_dex_bonus(-4);
         add_miss_reason(_("You can't stand the sunlight!"), 4);
@@ -8020,7 +8214,7 @@ void player::suffer()
         mod_per_bonus(-4);
     }
 
-    if (has_trait("SORES")) {
+    if (has_trait( trait_SORES )) {
         for (int i = bp_head; i < num_bp; i++) {
             int sores_pain = 5 + (int)(0.4 * abs( encumb( body_part( i ) ) ) );
             if (get_pain() < sores_pain) {
@@ -8036,7 +8230,7 @@ void player::suffer()
 
     // Blind/Deaf for brief periods about once an hour,
     // and visuals about once every 30 min.
-    if (has_trait("PER_SLIME")) {
+    if (has_trait( trait_PER_SLIME )) {
         if (one_in(600) && !has_effect( effect_deaf )) {
             add_msg_if_player(m_bad, _("Suddenly, you can't hear anything!"));
             add_effect( effect_deaf, 100 * rng ( 2, 6 ) ) ;
@@ -8053,14 +8247,14 @@ void player::suffer()
         }
     }
 
-    if (has_trait("WEB_SPINNER") && !in_vehicle && one_in(3)) {
+    if (has_trait( trait_WEB_SPINNER ) && !in_vehicle && one_in(3)) {
         g->m.add_field( pos(), fd_web, 1, 0 ); //this adds density to if its not already there.
     }
 
-    if (has_trait("UNSTABLE") && one_in(28800)) { // Average once per 2 days
+    if (has_trait( trait_UNSTABLE ) && one_in(28800)) { // Average once per 2 days
         mutate();
     }
-    if (has_trait("CHAOTIC") && one_in(7200)) { // Should be once every 12 hours
+    if (has_trait( trait_CHAOTIC ) && one_in(7200)) { // Should be once every 12 hours
         mutate();
     }
     if (has_artifact_with(AEP_MUTAGENIC) && one_in(28800)) {
@@ -8076,11 +8270,11 @@ void player::suffer()
     const int map_radiation = g->m.get_radiation( pos() );
 
     int rad_mut = 0;
-    if( has_trait("RADIOACTIVE3") ) {
+    if( has_trait( trait_RADIOACTIVE3 ) ) {
         rad_mut = 3;
-    } else if( has_trait("RADIOACTIVE2") ) {
+    } else if( has_trait( trait_RADIOACTIVE2 ) ) {
         rad_mut = 2;
-    } else if( has_trait("RADIOACTIVE1") ) {
+    } else if( has_trait( trait_RADIOACTIVE1 ) ) {
         rad_mut = 1;
     }
 
@@ -8194,7 +8388,7 @@ void player::suffer()
         }
     }
 
-    const bool radiogenic = has_trait("RADIOGENIC");
+    const bool radiogenic = has_trait( trait_RADIOGENIC );
     if( radiogenic && int(calendar::turn) % MINUTES(30) == 0 && radiation > 0 ) {
         // At 200 irradiation, twice as fast as REGEN
         if( x_in_y( radiation, 200 ) ) {
@@ -8390,7 +8584,7 @@ void player::mend( int rate_multiplier )
         healing_factor *= 0.5;
     }
 
-    if( radiation > 0 && !has_trait( "RADIOGENIC" ) ) {
+    if( radiation > 0 && !has_trait( trait_RADIOGENIC ) ) {
         healing_factor *= std::max( 0.0f, (1000.0f - radiation) / 1000.0f );
     }
 
@@ -8415,17 +8609,17 @@ void player::mend( int rate_multiplier )
     }
 
     // Mutagenic healing factor!
-    if( has_trait("REGEN") ) {
+    if( has_trait( trait_REGEN ) ) {
         healing_factor *= 16.0;
-    } else if( has_trait("FASTHEALER2") ) {
+    } else if( has_trait( trait_FASTHEALER2 ) ) {
         healing_factor *= 4.0;
-    } else if( has_trait("FASTHEALER") ) {
+    } else if( has_trait( trait_FASTHEALER ) ) {
         healing_factor *= 2.0;
-    } else if( has_trait("SLOWHEALER") ) {
+    } else if( has_trait( trait_SLOWHEALER ) ) {
         healing_factor *= 0.5;
     }
 
-    if( has_trait("REGEN_LIZ") ) {
+    if( has_trait( trait_REGEN_LIZ ) ) {
         healing_factor = 20.0;
     }
 
@@ -8462,7 +8656,7 @@ void player::mend( int rate_multiplier )
                     // No mending for you!
                     continue;
             }
-            if( mended == false && has_trait("REGEN_LIZ") ) {
+            if( mended == false && has_trait( trait_REGEN_LIZ ) ) {
                 // Splints aren't *strictly* necessary for your anatomy
                 mended = x_in_y(healing_factor * 0.2, mending_odds);
             }
@@ -8516,14 +8710,11 @@ void player::vomit()
     }
 
     moves -= 100;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            if( it.get_id() == effect_foodpoison ) {
-                it.mod_duration(-300);
-            } else if( it.get_id() == effect_drunk ) {
-                it.mod_duration(rng(-100, -500));
-            }
+    for( effect &it : effects ) {
+        if( it.get_id() == effect_foodpoison ) {
+            it.mod_duration(-300);
+        } else if( it.get_id() == effect_drunk ) {
+            it.mod_duration(rng(-100, -500));
         }
     }
     remove_effect( effect_pkill1 );
@@ -8542,7 +8733,7 @@ void player::drench( int saturation, int flags, bool ignore_waterproof )
     }
 
     // OK, water gets in your AEP suit or whatever.  It wasn't built to keep you dry.
-    if( has_trait("DEBUG_NOTEMP") || has_active_mutation("SHELL2") ||
+    if( has_trait( trait_DEBUG_NOTEMP ) || has_active_mutation("SHELL2") ||
         ( !ignore_waterproof && is_waterproof(flags) ) ) {
         return;
     }
@@ -8694,12 +8885,12 @@ void player::update_body_wetness( const w_point &weather )
     delay += ( weather.humidity - 66 ) / 100.0;
     delay = std::max( 0.1, delay );
     // Fur/slime retains moisture
-    if( has_trait("LIGHTFUR") || has_trait("FUR") || has_trait("FELINE_FUR") ||
-        has_trait("LUPINE_FUR") || has_trait("CHITIN_FUR") || has_trait("CHITIN_FUR2") ||
-        has_trait("CHITIN_FUR3")) {
+    if( has_trait( trait_LIGHTFUR ) || has_trait( trait_FUR ) || has_trait( trait_FELINE_FUR ) ||
+        has_trait( trait_LUPINE_FUR ) || has_trait( trait_CHITIN_FUR ) || has_trait( trait_CHITIN_FUR2 ) ||
+        has_trait( trait_CHITIN_FUR3 )) {
         delay = delay * 6 / 5;
     }
-    if( has_trait( "URSINE_FUR" ) || has_trait( "SLIMY" ) ) {
+    if( has_trait( trait_URSINE_FUR ) || has_trait( trait_SLIMY ) ) {
         delay = delay * 3 / 2;
     }
 
@@ -8791,11 +8982,8 @@ void player::check_and_recover_morale()
         test_morale.on_mutation_gain( mut.first );
     }
 
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            const effect &e = _effect_it.second;
-            test_morale.on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
-        }
+    for( const effect &e : effects ) {
+        test_morale.on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
     }
 
     test_morale.on_stat_change( "hunger", get_hunger() );
@@ -9488,7 +9676,7 @@ bool player::consume(int target_position)
 
 void player::rooted_message() const
 {
-    if( (has_trait("ROOTS2") || has_trait("ROOTS3") ) &&
+    if( (has_trait( trait_ROOTS2 ) || has_trait( trait_ROOTS3 ) ) &&
         g->m.has_flag("DIGGABLE", pos()) &&
         !footwear_factor() ) {
         add_msg(m_info, _("You sink your roots into the soil."));
@@ -9500,7 +9688,7 @@ void player::rooted()
 // Overfiling triggered hibernation checks, so capping.
 {
     double shoe_factor = footwear_factor();
-    if( (has_trait("ROOTS2") || has_trait("ROOTS3")) &&
+    if( (has_trait( trait_ROOTS2 ) || has_trait( trait_ROOTS3 )) &&
         g->m.has_flag("DIGGABLE", pos()) && shoe_factor != 1.0 ) {
         if( one_in(20.0 / (1.0 - shoe_factor)) ) {
             if (get_hunger() > -20) {
@@ -9831,14 +10019,14 @@ bool player::can_wear( const item& it, bool alert ) const
         return false;
     }
 
-    if( has_trait( "WOOLALLERGY" ) && ( it.made_of( material_id( "wool" ) ) || it.item_tags.count( "wooled" ) ) ) {
+    if( has_trait( trait_WOOLALLERGY ) && ( it.made_of( material_id( "wool" ) ) || it.item_tags.count( "wooled" ) ) ) {
         if( alert ) {
             add_msg_if_player( m_info, _( "You can't wear that, it's made of wool!" ) );
         }
         return false;
     }
 
-    if( it.is_filthy() && has_trait( "SQUEAMISH" ) ) {
+    if( it.is_filthy() && has_trait( trait_SQUEAMISH ) ) {
         if( alert ) {
             add_msg_if_player( m_info, _( "You can't wear that, it's filthy!" ) );
         }
@@ -9860,11 +10048,11 @@ bool player::can_wear( const item& it, bool alert ) const
         if( it.covers(bp_head) &&
             !it.made_of( material_id( "wool" ) ) && !it.made_of( material_id( "cotton" ) ) &&
             !it.made_of( material_id( "nomex" ) ) && !it.made_of( material_id( "leather" ) ) &&
-            ( has_trait( "HORNS_POINTED" ) || has_trait( "ANTENNAE" ) || has_trait( "ANTLERS" ) ) ) {
+            ( has_trait( trait_HORNS_POINTED ) || has_trait( trait_ANTENNAE ) || has_trait( trait_ANTLERS ) ) ) {
             if( alert ) {
                 add_msg_if_player( m_info, _( "You cannot wear a helmet over your %s." ),
-                            ( has_trait( "HORNS_POINTED" ) ? _( "horns" ) :
-                            ( has_trait( "ANTENNAE" ) ? _( "antennae" ) : _( "antlers" ) ) ) );
+                            ( has_trait( trait_HORNS_POINTED ) ? _( "horns" ) :
+                            ( has_trait( trait_ANTENNAE ) ? _( "antennae" ) : _( "antlers" ) ) ) );
             }
             return false;
         }
@@ -10219,7 +10407,7 @@ bool player::dispose_item( item_location &&obj, const std::string& prompt )
 
 void player::mend_item( item_location&& obj, bool interactive )
 {
-    if( g->u.has_trait( "DEBUG_HS" ) ) {
+    if( g->u.has_trait( trait_DEBUG_HS ) ) {
         uimenu menu( true, _( "Toggle which fault?" ) );
         std::vector<std::pair<fault_id, bool>> opts;
         for( const auto& f : obj->faults_potential() ) {
@@ -11053,7 +11241,7 @@ bool player::gunmod_remove( item &gun, item& mod )
 std::pair<int, int> player::gunmod_installation_odds( const item& gun, const item& mod ) const
 {
     // Mods with INSTALL_DIFFICULT have a chance to fail, potentially damaging the gun
-    if( !mod.has_flag( "INSTALL_DIFFICULT" ) || has_trait( "DEBUG_HS" ) ) {
+    if( !mod.has_flag( "INSTALL_DIFFICULT" ) || has_trait( trait_DEBUG_HS ) ) {
         return std::make_pair( 100, 0 );
     }
 
@@ -11096,7 +11284,7 @@ void player::gunmod_add( item &gun, item &mod )
     }
 
     // first check at least the minimum requirements are met
-    if( !has_trait( "DEBUG_HS" ) && !can_use( mod, gun ) ) {
+    if( !has_trait( trait_DEBUG_HS ) && !can_use( mod, gun ) ) {
         return;
     }
 
@@ -11157,7 +11345,7 @@ void player::gunmod_add( item &gun, item &mod )
         actions[ prompt.ret ]();
     }
 
-    int turns = !has_trait( "DEBUG_HS" ) ? mod.type->gunmod->install_time : 0;
+    int turns = !has_trait( trait_DEBUG_HS ) ? mod.type->gunmod->install_time : 0;
 
     assign_activity( activity_id( "ACT_GUNMOD_ADD" ), turns, -1, get_item_position( &gun ), tool );
     activity.values.push_back( get_item_position( &mod ) );
@@ -11206,9 +11394,9 @@ const player *player::get_book_reader( const item &book, std::vector<std::string
     }
 
     // Check for conditions tha disqualify us only if no NPCs can read to us
-    if( type->intel > 0 && has_trait( "ILLITERATE" ) ) {
+    if( type->intel > 0 && has_trait( trait_ILLITERATE ) ) {
         reasons.push_back( _( "You're illiterate!" ) );
-    } else if( has_trait( "HYPEROPIC" ) && !is_wearing( "glasses_reading" ) &&
+    } else if( has_trait( trait_HYPEROPIC ) && !is_wearing( "glasses_reading" ) &&
                !is_wearing( "glasses_bifocal" ) && !has_effect( effect_contacts ) && !has_bionic( "bio_eye_optic") ) {
         reasons.push_back( _( "Your eyes won't focus without reading glasses." ) );
     } else if( fine_detail_vision_mod() > 4 ) {
@@ -11231,14 +11419,14 @@ const player *player::get_book_reader( const item &book, std::vector<std::string
 
     for( const npc *elem : candidates ) {
         // Check for disqualifying factors:
-        if( type->intel > 0 && elem->has_trait( "ILLITERATE" ) ) {
+        if( type->intel > 0 && elem->has_trait( trait_ILLITERATE ) ) {
             reasons.push_back( string_format( _( "%s is illiterate!" ),
                                               elem->disp_name().c_str() ) );
         } else if( skill && elem->get_skill_level( skill ) < type->req &&
                    has_identified( book.typeId() ) ) {
             reasons.push_back( string_format( _( "%s doesn't know enough about %s to understand the jargon!" ),
                                               elem->disp_name().c_str(), skill.obj().name().c_str() ) );
-        } else if( elem->has_trait( "HYPEROPIC" ) && !elem->is_wearing( "glasses_reading" ) &&
+        } else if( elem->has_trait( trait_HYPEROPIC ) && !elem->is_wearing( "glasses_reading" ) &&
                    !elem->is_wearing( "glasses_bifocal" ) && !elem->has_effect( effect_contacts ) ) {
             reasons.push_back( string_format( _( "%s needs reading glasses!" ),
                                               elem->disp_name().c_str() ) );
@@ -11293,10 +11481,10 @@ int player::time_to_read( const item &book, const player &reader, const player *
 bool player::fun_to_read( const item &book ) const
 {
     // If you don't have a problem with eating humans, To Serve Man becomes rewarding
-    if( ( has_trait( "CANNIBAL" ) || has_trait( "PSYCHOPATH" ) || has_trait( "SAPIOVORE" ) ) &&
+    if( ( has_trait( trait_CANNIBAL ) || has_trait( trait_PSYCHOPATH ) || has_trait( trait_SAPIOVORE ) ) &&
         book.typeId() == "cookbook_human" ) {
         return true;
-    } else if( has_trait( "SPIRITUAL" ) && book.has_flag( "INSPIRATIONAL" ) ) {
+    } else if( has_trait( trait_SPIRITUAL ) && book.has_flag( "INSPIRATIONAL" ) ) {
         return true;
     } else {
         return book.type->book.get()->fun > 0;
@@ -11547,11 +11735,11 @@ bool player::read( int inventory_position, const bool continuous )
     }
     for( player *elem : apply_morale ) {
         // If you don't have a problem with eating humans, To Serve Man becomes rewarding
-        if( ( elem->has_trait( "CANNIBAL" ) || elem->has_trait( "PSYCHOPATH" ) ||
-              elem->has_trait( "SAPIOVORE" ) ) &&
+        if( ( elem->has_trait( trait_CANNIBAL ) || elem->has_trait( trait_PSYCHOPATH ) ||
+              elem->has_trait( trait_SAPIOVORE ) ) &&
             it.typeId() == "cookbook_human" ) {
             elem->add_morale( MORALE_BOOK, 0, 75, minutes + 30, minutes, false, it.type );
-        } else if( elem->has_trait( "SPIRITUAL" ) && it.has_flag( "INSPIRATIONAL" ) ) {
+        } else if( elem->has_trait( trait_SPIRITUAL ) && it.has_flag( "INSPIRATIONAL" ) ) {
             elem->add_morale( MORALE_BOOK, 15, 90, minutes + 60, minutes, false, it.type );
         } else {
             elem->add_morale( MORALE_BOOK, 0, type->fun * 15, minutes + 30, minutes, false, it.type );
@@ -11651,12 +11839,12 @@ void player::do_read( item *book )
                 fun_bonus = reading->fun * 5;
             }
             // If you don't have a problem with eating humans, To Serve Man becomes rewarding
-            if( ( learner->has_trait( "CANNIBAL" ) || learner->has_trait( "PSYCHOPATH" ) ||
-                  learner->has_trait( "SAPIOVORE" ) ) &&
+            if( ( learner->has_trait( trait_CANNIBAL ) || learner->has_trait( trait_PSYCHOPATH ) ||
+                  learner->has_trait( trait_SAPIOVORE ) ) &&
                 book->typeId() == "cookbook_human" ) {
                 fun_bonus = 25;
                 learner->add_morale( MORALE_BOOK, fun_bonus, fun_bonus * 3, 60, 30, true, book->type );
-            } else if( learner->has_trait( "SPIRITUAL" ) && book->has_flag( "INSPIRATIONAL" ) ) {
+            } else if( learner->has_trait( trait_SPIRITUAL ) && book->has_flag( "INSPIRATIONAL" ) ) {
                 fun_bonus = 15;
                 learner->add_morale( MORALE_BOOK, fun_bonus, fun_bonus * 5, 90, 90, true, book->type );
             } else {
@@ -11865,7 +12053,7 @@ void player::try_to_sleep()
     bool webforce = false;
     bool websleeping = false;
     bool in_shell = false;
-    if (has_trait("CHLOROMORPH")) {
+    if (has_trait( trait_CHLOROMORPH )) {
         plantsleep = true;
         if( (ter_at_pos == t_dirt || ter_at_pos == t_pit ||
               ter_at_pos == t_dirtmound || ter_at_pos == t_pit_shallow ||
@@ -11880,11 +12068,11 @@ void player::try_to_sleep()
             add_msg_if_player(m_bad, _("Your roots scrabble ineffectively at the unyielding surface."));
         }
     }
-    if (has_trait("WEB_WALKER")) {
+    if (has_trait( trait_WEB_WALKER )) {
         websleep = true;
     }
     // Not sure how one would get Arachnid w/o web-making, but Just In Case
-    if (has_trait("THRESH_SPIDER") && (has_trait("WEB_SPINNER") || (has_trait("WEB_WEAVER"))) ) {
+    if (has_trait( trait_THRESH_SPIDER ) && (has_trait( trait_WEB_SPINNER ) || (has_trait( trait_WEB_WEAVER ))) ) {
         webforce = true;
     }
     if (websleep || webforce) {
@@ -11940,23 +12128,23 @@ int player::sleep_spot( const tripoint &p ) const
     if (has_addiction(ADD_SLEEP)) {
         sleepy -= 4;
     }
-    if (has_trait("INSOMNIA")) {
+    if (has_trait( trait_INSOMNIA )) {
         // 12.5 points is the difference between "tired" and "dead tired"
         sleepy -= 12;
     }
-    if (has_trait("EASYSLEEPER")) {
+    if (has_trait( trait_EASYSLEEPER )) {
         // Low fatigue (being rested) has a much stronger effect than high fatigue
         // so it's OK for the value to be that much higher
         sleepy += 24;
     }
-    if (has_trait("CHLOROMORPH")) {
+    if (has_trait( trait_CHLOROMORPH )) {
         plantsleep = true;
     }
-    if (has_trait("WEB_WALKER")) {
+    if (has_trait( trait_WEB_WALKER )) {
         websleep = true;
     }
     // Not sure how one would get Arachnid w/o web-making, but Just In Case
-    if (has_trait("THRESH_SPIDER") && (has_trait("WEB_SPINNER") || (has_trait("WEB_WEAVER"))) ) {
+    if (has_trait( trait_THRESH_SPIDER ) && (has_trait( trait_WEB_SPINNER ) || (has_trait( trait_WEB_WEAVER ))) ) {
         webforce = true;
     }
     if (has_active_mutation("SHELL2")) {
@@ -12041,7 +12229,7 @@ int player::sleep_spot( const tripoint &p ) const
         sleepy += int((get_fatigue() - TIRED + 1) / 16);
     }
 
-    if( stim > 0 || !has_trait("INSOMNIA") ) {
+    if( stim > 0 || !has_trait( trait_INSOMNIA ) ) {
         sleepy -= 2 * stim;
     } else {
         // Make it harder for insomniac to get around the trait
@@ -12144,7 +12332,7 @@ float player::fine_detail_vision_mod() const
     // that you can generaly see.  There'll still be the haze, but
     // it's annoying rather than limiting.
     if( is_blind() ||
-         ( ( has_effect( effect_boomered ) || has_effect( effect_darkness ) ) && !has_trait( "PER_SLIME_OK" ) ) ) {
+         ( ( has_effect( effect_boomered ) || has_effect( effect_darkness ) ) && !has_trait( trait_PER_SLIME_OK ) ) ) {
         return 11.0;
     }
     // Scale linearly as light level approaches LIGHT_AMBIENT_LIT.
@@ -12573,10 +12761,10 @@ void player::absorb_hit(body_part bp, damage_instance &dam) {
         passive_absorb_hit( bp, elem );
 
         if( elem.type == DT_BASH ) {
-            if( has_trait( "LIGHT_BONES" ) ) {
+            if( has_trait( trait_LIGHT_BONES ) ) {
                 elem.amount *= 1.4;
             }
-            if( has_trait( "HOLLOW_BONES" ) ) {
+            if( has_trait( trait_HOLLOW_BONES ) ) {
                 elem.amount *= 1.8;
             }
         }
@@ -12715,11 +12903,11 @@ bool player::is_wearing_power_armor(bool *hasHelmet) const {
 int player::adjust_for_focus(int amount) const
 {
     int effective_focus = focus_pool;
-    if (has_trait("FASTLEARNER"))
+    if (has_trait( trait_FASTLEARNER ))
     {
         effective_focus += 15;
     }
-    if (has_trait("SLOWLEARNER"))
+    if (has_trait( trait_SLOWLEARNER ))
     {
         effective_focus -= 15;
     }
@@ -12751,7 +12939,7 @@ void player::practice( const skill_id &id, int amount, int cap )
         return;
     }
 
-    bool isSavant = has_trait("SAVANT");
+    bool isSavant = has_trait( trait_SAVANT );
 
     skill_id savantSkill( NULL_ID );
     SkillLevel savantSkillLevel = SkillLevel();
@@ -12767,21 +12955,21 @@ void player::practice( const skill_id &id, int amount, int cap )
 
     amount = adjust_for_focus(amount);
 
-    if (has_trait("PACIFIST") && skill.is_combat_skill()) {
+    if (has_trait( trait_PACIFIST ) && skill.is_combat_skill()) {
         if(!one_in(3)) {
           amount = 0;
         }
     }
-    if (has_trait("PRED2") && skill.is_combat_skill()) {
+    if (has_trait( trait_PRED2 ) && skill.is_combat_skill()) {
         if(one_in(3)) {
           amount *= 2;
         }
     }
-    if (has_trait("PRED3") && skill.is_combat_skill()) {
+    if (has_trait( trait_PRED3 ) && skill.is_combat_skill()) {
         amount *= 2;
     }
 
-    if (has_trait("PRED4") && skill.is_combat_skill()) {
+    if (has_trait( trait_PRED4 ) && skill.is_combat_skill()) {
         amount *= 3;
     }
 
@@ -12818,7 +13006,7 @@ void player::practice( const skill_id &id, int amount, int cap )
         focus_pool -= chance_to_drop / 100;
         // Apex Predators don't think about much other than killing.
         // They don't lose Focus when practicing combat skills.
-        if ((rng(1, 100) <= (chance_to_drop % 100)) && (!(has_trait("PRED4") &&
+        if ((rng(1, 100) <= (chance_to_drop % 100)) && (!(has_trait( trait_PRED4 ) &&
                                                           skill.is_combat_skill()))) {
             focus_pool--;
         }
@@ -13191,7 +13379,7 @@ bool player::is_invisible() const
         has_active_bionic(str_bio_cloak) ||
         has_active_bionic(str_bio_night) ||
         has_active_optcloak() ||
-        has_trait("DEBUG_CLOAK") ||
+        has_trait( trait_DEBUG_CLOAK ) ||
         has_artifact_with(AEP_INVISIBLE)
     );
 }
@@ -13306,9 +13494,9 @@ int player::get_hp_max( hp_part bp ) const
 
 int player::get_stamina_max() const
 {
-    if (has_trait("BADCARDIO"))
+    if (has_trait( trait_BADCARDIO ))
         return 750;
-    if (has_trait("GOODCARDIO"))
+    if (has_trait( trait_GOODCARDIO ))
         return 1250;
     return 1000;
 }
@@ -13332,7 +13520,7 @@ void player::burn_move_stamina( int moves )
     mod_stat( "stamina", -((moves * burn_ratio) / 100) );
     // Chance to suffer pain if overburden and stamina runs out or has trait BADBACK
     // Starts at 1 in 25, goes down by 5 for every 50% more carried
-    if ((current_weight > max_weight) && (has_trait("BADBACK") || stamina == 0) && one_in(35 - 5 * current_weight / (max_weight / 2))) {
+    if ((current_weight > max_weight) && (has_trait( trait_BADBACK ) || stamina == 0) && one_in(35 - 5 * current_weight / (max_weight / 2))) {
         add_msg_if_player(m_bad, _("Your body strains under the weight!"));
         // 1 more pain for every 800 grams more (5 per extra STR needed)
         if ( ((current_weight - max_weight) / 800 > get_pain() && get_pain() < 100)) {
@@ -13411,7 +13599,7 @@ bool player::sees( const Creature &critter ) const
 {
     // This handles only the player/npc specific stuff (monsters don't have traits or bionics).
     const int dist = rl_dist( pos(), critter.pos() );
-    if (dist <= 3 && has_trait("ANTENNAE")) {
+    if (dist <= 3 && has_trait( trait_ANTENNAE )) {
         return true;
     }
     if( critter.digging() && has_active_bionic( "bio_ground_sonar" ) ) {
@@ -13542,25 +13730,25 @@ float player::hearing_ability() const
     if( has_active_bionic("bio_ears") && !has_active_bionic("bio_earplugs") ) {
         volume_multiplier *= 3.5;
     }
-    if( has_trait("PER_SLIME") ) {
+    if( has_trait( trait_PER_SLIME ) ) {
         // Random hearing :-/
         // (when it's working at all, see player.cpp)
         // changed from 0.5 to fix Mac compiling error
         volume_multiplier *= (rng(1, 2));
     }
-    if( has_trait("BADHEARING") ) {
+    if( has_trait( trait_BADHEARING ) ) {
         volume_multiplier *= .5;
     }
-    if( has_trait("GOODHEARING") ) {
+    if( has_trait( trait_GOODHEARING ) ) {
         volume_multiplier *= 1.25;
     }
-    if( has_trait("CANINE_EARS") ) {
+    if( has_trait( trait_CANINE_EARS ) ) {
         volume_multiplier *= 1.5;
     }
-    if( has_trait("URSINE_EARS") || has_trait("FELINE_EARS") ) {
+    if( has_trait( trait_URSINE_EARS ) || has_trait( trait_FELINE_EARS ) ) {
         volume_multiplier *= 1.25;
     }
-    if( has_trait("LUPINE_EARS") ) {
+    if( has_trait( trait_LUPINE_EARS ) ) {
         volume_multiplier *= 1.75;
     }
 
@@ -13679,8 +13867,13 @@ std::vector<std::string> player::get_overlay_ids() const
 
 
     // first get effects
-    for( const auto &eff_pr : effects ) {
-        rval.push_back( "effect_" + eff_pr.first.str() );
+    // effects of the same type are adjacent, one overlay per type
+    const effect *prev = nullptr;
+    for( const effect &eff : effects ) {
+        if( prev == nullptr || prev->get_id() != eff.get_id() ) {
+            rval.push_back( "effect_" + eff.get_id().str() );
+        }
+        prev = &eff;
     }
 
     // then get mutations
@@ -13760,7 +13953,7 @@ float player::power_rating() const
     } else if( dmg > 12 ) {
         ret = 3; // Melee weapon or weapon-y tool
     }
-    if( has_trait("HUGE") || has_trait("HUGE_OK") ) {
+    if( has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK ) ) {
         ret += 1;
     }
     if( is_wearing_power_armor( nullptr ) ) {
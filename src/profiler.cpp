@@ -0,0 +1,151 @@
+#include "profiler.h"
+
+#include "cata_utility.h"
+#include "json.h"
+#include "output.h"
+#include "path_info.h"
+#include "translations.h"
+#include "turn_arena.h"
+
+#include <algorithm>
+
+namespace profiler
+{
+
+bool enabled = false;
+
+static std::array<section_stats, NUM_PROF_SECTIONS> all_stats;
+static long turns_recorded = 0;
+
+static const std::array<const char *, NUM_PROF_SECTIONS> section_names = {{
+        "scent_update",
+        "vehmove",
+        "process_fields",
+        "process_active_items",
+        "process_sounds",
+        "build_map_cache",
+        "generate_lightmap",
+        "update_pathfinding_cache",
+        "monmove",
+        "npcmove",
+        "player_process_turn",
+        "npc_regen_ai_cache",
+        "vehicle_collision"
+    }
+};
+
+void record( section sec, std::chrono::steady_clock::duration elapsed )
+{
+    section_stats &st = all_stats[sec];
+    st.turn_calls++;
+    st.turn_time += elapsed;
+}
+
+void end_turn()
+{
+    if( !enabled ) {
+        return;
+    }
+    turns_recorded++;
+    for( auto &st : all_stats ) {
+        if( st.turn_calls == 0 ) {
+            continue;
+        }
+        const double us = std::chrono::duration<double, std::micro>( st.turn_time ).count();
+        int bucket = 0;
+        while( bucket < histogram_buckets - 1 && us >= double( 1L << bucket ) ) {
+            bucket++;
+        }
+        st.histogram[bucket]++;
+        st.calls += st.turn_calls;
+        st.turns++;
+        st.total_us += us;
+        st.max_us = std::max( st.max_us, us );
+        st.turn_calls = 0;
+        st.turn_time = std::chrono::steady_clock::duration::zero();
+    }
+}
+
+void reset()
+{
+    all_stats.fill( section_stats() );
+    turns_recorded = 0;
+    turn_arena::reset_stats();
+}
+
+long turns()
+{
+    return turns_recorded;
+}
+
+const char *name( section sec )
+{
+    return section_names[sec];
+}
+
+const section_stats &get_stats( section sec )
+{
+    return all_stats[sec];
+}
+
+std::string summary()
+{
+    std::string ret = string_format( "%-26s %8s %12s %12s %12s\n", _( "Section" ), _( "Calls" ),
+                                     _( "Total (ms)" ), _( "Mean (us)" ), _( "Max (us)" ) );
+    for( int i = 0; i < NUM_PROF_SECTIONS; i++ ) {
+        const section_stats &st = all_stats[i];
+        ret += string_format( "%-26s %8ld %12.2f %12.1f %12.1f\n", section_names[i], st.calls,
+                              st.total_us / 1000.0, st.turns > 0 ? st.total_us / st.turns : 0.0,
+                              st.max_us );
+    }
+    const turn_arena::arena_stats &arena = turn_arena::get_stats();
+    ret += string_format( _( "Turn arena: %.1f allocations per turn (max %ld, %ld KiB), %ld from the heap, "
+                             "%ld KiB reserved\n" ),
+                          arena.turns > 0 ? double( arena.allocations ) / arena.turns : 0.0,
+                          arena.max_turn_allocations, long( arena.max_turn_bytes / 1024 ),
+                          arena.heap_allocations, long( turn_arena::capacity() / 1024 ) );
+    return ret;
+}
+
+void serialize( JsonOut &json )
+{
+    json.start_object();
+    json.member( "turns", turns_recorded );
+    json.member( "sections" );
+    json.start_object();
+    for( int i = 0; i < NUM_PROF_SECTIONS; i++ ) {
+        const section_stats &st = all_stats[i];
+        json.member( section_names[i] );
+        json.start_object();
+        json.member( "calls", st.calls );
+        json.member( "turns", st.turns );
+        json.member( "total_us", st.total_us );
+        json.member( "max_us", st.max_us );
+        json.member( "histogram_log2_us", st.histogram );
+        json.end_object();
+    }
+    json.end_object();
+    const turn_arena::arena_stats &arena = turn_arena::get_stats();
+    json.member( "turn_arena" );
+    json.start_object();
+    json.member( "turns", arena.turns );
+    json.member( "allocations", arena.allocations );
+    json.member( "max_turn_allocations", arena.max_turn_allocations );
+    json.member( "max_turn_bytes", long( arena.max_turn_bytes ) );
+    json.member( "heap_allocations", arena.heap_allocations );
+    json.end_object();
+    json.end_object();
+}
+
+void write()
+{
+    if( turns_recorded == 0 ) {
+        return;
+    }
+    write_to_file( FILENAMES["profile"], [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        serialize( jsout );
+    }, _( "turn profile" ) );
+}
+
+} // namespace profiler
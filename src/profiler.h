@@ -0,0 +1,100 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <string>
+
+class JsonOut;
+
+/**
+ * Attributes wall clock time to the phases of @ref game::do_turn.
+ *
+ * A @ref profiler::scoped_timer at the top of a function adds the time spent in it to the
+ * current turn; @ref profiler::end_turn folds the totals of the finished turn into per-section
+ * histograms. While the profiler is disabled a timer costs a single branch.
+ */
+namespace profiler
+{
+
+enum section : int {
+    PROF_SCENT,
+    PROF_VEHMOVE,
+    PROF_FIELDS,
+    PROF_ACTIVE_ITEMS,
+    PROF_SOUNDS,
+    PROF_MAP_CACHE,
+    PROF_LIGHTMAP,
+    PROF_PATHFINDING_CACHE,
+    PROF_MONMOVE,
+    PROF_NPCMOVE,
+    PROF_CHAR_TURN,
+    PROF_NPC_AI_CACHE,
+    PROF_VEH_COLLISION,
+    NUM_PROF_SECTIONS
+};
+
+/** Bucket n counts the turns in which a section took less than 2^n microseconds */
+constexpr int histogram_buckets = 24;
+
+struct section_stats {
+    /** Calls and time during the turn in progress */
+    int turn_calls = 0;
+    std::chrono::steady_clock::duration turn_time = std::chrono::steady_clock::duration::zero();
+
+    /** Totals over all finished turns in which the section was entered */
+    long calls = 0;
+    long turns = 0;
+    double total_us = 0.0;
+    double max_us = 0.0;
+    std::array<long, histogram_buckets> histogram = {{}};
+};
+
+/** Whether timers record anything, toggled from the debug menu or by --benchmark */
+extern bool enabled;
+
+void record( section sec, std::chrono::steady_clock::duration elapsed );
+
+/** Adds the time until it goes out of scope to the given section */
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( section sec ) : sec( sec ), active( enabled ) {
+            if( active ) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        ~scoped_timer() {
+            if( active ) {
+                record( sec, std::chrono::steady_clock::now() - start );
+            }
+        }
+
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        section sec;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** Called once at the end of every turn */
+void end_turn();
+/** Discards everything recorded so far */
+void reset();
+
+/** Number of turns finished while the profiler was enabled */
+long turns();
+const char *name( section sec );
+const section_stats &get_stats( section sec );
+
+/** Human readable table of all sections */
+std::string summary();
+void serialize( JsonOut &json );
+/** Writes the profile to FILENAMES["profile"] if any turns were recorded */
+void write();
+
+} // namespace profiler
+
+#endif
@@ -0,0 +1,445 @@
+#include "replay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "calendar.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "input.h"
+#include "json.h"
+#include "options.h"
+#include "output.h"
+#include "path_info.h"
+#include "player.h"
+#include "profiler.h"
+#include "rng.h"
+#include "worldfactory.h"
+
+namespace
+{
+
+enum class replay_mode : int {
+    none,
+    record_pending,
+    recording,
+    playing
+};
+
+struct recorded_event {
+    input_event evt;
+    long pressed_key;
+};
+
+struct replay_data {
+    replay_mode mode = replay_mode::none;
+    std::string path;
+    std::ofstream out;
+    replay::header hdr;
+
+    std::vector<recorded_event> events;
+    size_t next_event = 0;
+    /** Recorded state after each turn, see @ref current_state */
+    std::map<int, std::string> states;
+
+    int verify_interval = 1;
+    int turns_played = 0;
+    int verified = 0;
+    int mismatched = 0;
+    /** Description of the first turn that differed from the recording */
+    std::string first_mismatch;
+};
+
+replay_data &data()
+{
+    static replay_data instance;
+    return instance;
+}
+
+/**
+ * The parts of the game state that drift apart first when a replay no longer follows the
+ * recording. It is kept readable, so the first difference tells where to start looking.
+ */
+std::string current_state()
+{
+    const tripoint pos = g->u.global_square_location();
+    return string_format( "%d %d %d %d %s", pos.x, pos.y, pos.z, static_cast<int>( g->num_zombies() ),
+                          rng_get_engine().serialize().c_str() );
+}
+
+/** Writes one JSON value per line, flushed right away so a crash leaves a usable recording */
+void write_line( const std::function<void( JsonOut & )> &writer )
+{
+    auto &d = data();
+    JsonOut jsout( d.out );
+    writer( jsout );
+    d.out << std::endl;
+}
+
+void write_event( JsonOut &jsout, const input_event &evt, long pressed_key )
+{
+    jsout.start_object();
+    jsout.member( "event" );
+    jsout.start_array();
+    jsout.write( static_cast<int>( evt.type ) );
+    jsout.write( pressed_key );
+    jsout.write( evt.mouse_x );
+    jsout.write( evt.mouse_y );
+    jsout.write( evt.sequence );
+    jsout.write( evt.modifiers );
+    jsout.write( evt.text );
+    jsout.end_array();
+    jsout.end_object();
+}
+
+recorded_event read_event( JsonArray ja )
+{
+    recorded_event rec;
+    rec.evt.type = static_cast<input_event_t>( ja.next_int() );
+    rec.pressed_key = ja.next_long();
+    rec.evt.mouse_x = ja.next_int();
+    rec.evt.mouse_y = ja.next_int();
+    JsonArray sequence = ja.next_array();
+    while( sequence.has_more() ) {
+        rec.evt.sequence.push_back( sequence.next_long() );
+    }
+    JsonArray modifiers = ja.next_array();
+    while( modifiers.has_more() ) {
+        rec.evt.modifiers.push_back( modifiers.next_long() );
+    }
+    rec.evt.text = ja.next_string();
+    return rec;
+}
+
+} // namespace
+
+namespace replay
+{
+
+void record_to( const std::string &path )
+{
+    auto &d = data();
+    d.mode = replay_mode::record_pending;
+    d.path = path;
+}
+
+void begin_recording( const std::string &world, const std::string &save )
+{
+    auto &d = data();
+    if( d.mode != replay_mode::record_pending ) {
+        return;
+    }
+    d.mode = replay_mode::none;
+
+    // Old map files in the copy would be loaded instead of generating the same maps again.
+    const std::string world_copy = d.path + ".world";
+    if( file_exist( world_copy ) ) {
+        debugmsg( "%s already exists, the game is not recorded.", world_copy.c_str() );
+        return;
+    }
+    if( !copy_directory( world_generator->all_worlds[world]->world_path, world_copy ) ) {
+        debugmsg( "Could not copy the world to %s, the game is not recorded.", world_copy.c_str() );
+        return;
+    }
+    d.out.open( d.path.c_str(), std::ios::binary | std::ios::trunc );
+    if( !d.out ) {
+        debugmsg( "Could not open %s, the game is not recorded.", d.path.c_str() );
+        return;
+    }
+
+    d.hdr.world = world;
+    d.hdr.save = save;
+    d.hdr.rng_state = rng_get_engine().serialize();
+    d.hdr.turn = calendar::turn;
+    d.hdr.width = TERMX;
+    d.hdr.height = TERMY;
+    write_line( [&d]( JsonOut & jsout ) {
+        jsout.start_object();
+        jsout.member( "world", d.hdr.world );
+        jsout.member( "save", d.hdr.save );
+        jsout.member( "rng_state", d.hdr.rng_state );
+        jsout.member( "turn", d.hdr.turn );
+        jsout.member( "width", d.hdr.width );
+        jsout.member( "height", d.hdr.height );
+        jsout.end_object();
+    } );
+    d.mode = replay_mode::recording;
+}
+
+void end_recording()
+{
+    auto &d = data();
+    if( d.mode == replay_mode::recording ) {
+        d.out.close();
+        d.mode = replay_mode::none;
+    }
+}
+
+bool load( const std::string &path )
+{
+    auto &d = data();
+    std::ifstream fin( path.c_str(), std::ios::binary );
+    if( !fin ) {
+        std::cerr << "Could not open the recording " << path << std::endl;
+        return false;
+    }
+    d.path = path;
+    d.events.clear();
+    d.states.clear();
+
+    std::string line;
+    bool first = true;
+    try {
+        while( std::getline( fin, line ) ) {
+            if( line.empty() ) {
+                continue;
+            }
+            JsonIn jsin( line );
+            JsonObject jo = jsin.get_object();
+            if( first ) {
+                first = false;
+                d.hdr.world = jo.get_string( "world" );
+                d.hdr.save = jo.get_string( "save" );
+                d.hdr.rng_state = jo.get_string( "rng_state" );
+                d.hdr.turn = jo.get_int( "turn" );
+                d.hdr.width = jo.get_int( "width" );
+                d.hdr.height = jo.get_int( "height" );
+            } else if( jo.has_array( "event" ) ) {
+                d.events.push_back( read_event( jo.get_array( "event" ) ) );
+            } else {
+                d.states[jo.get_int( "turn" )] = jo.get_string( "state" );
+            }
+        }
+    } catch( const JsonError &err ) {
+        std::cerr << path << ": " << err.what() << std::endl;
+        return false;
+    }
+    if( first ) {
+        std::cerr << path << " is empty" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const header &loaded_header()
+{
+    return data().hdr;
+}
+
+bool playing()
+{
+    return data().mode == replay_mode::playing;
+}
+
+void start_playing( int verify_interval )
+{
+    auto &d = data();
+    d.mode = replay_mode::playing;
+    d.verify_interval = std::max( verify_interval, 1 );
+    d.next_event = 0;
+    d.turns_played = 0;
+    d.verified = 0;
+    d.mismatched = 0;
+    d.first_mismatch.clear();
+}
+
+void stop_playing()
+{
+    auto &d = data();
+    if( d.mode == replay_mode::playing ) {
+        d.mode = replay_mode::none;
+    }
+}
+
+bool next_input_event( input_event &evt, long &pressed_key )
+{
+    auto &d = data();
+    if( d.mode != replay_mode::playing ) {
+        return false;
+    }
+    if( d.next_event >= d.events.size() ) {
+        throw end_of_recording();
+    }
+    const recorded_event &rec = d.events[d.next_event++];
+    evt = rec.evt;
+    pressed_key = rec.pressed_key;
+    return true;
+}
+
+void record_input_event( const input_event &evt, long pressed_key )
+{
+    if( data().mode != replay_mode::recording ) {
+        return;
+    }
+    write_line( [&]( JsonOut & jsout ) {
+        write_event( jsout, evt, pressed_key );
+    } );
+}
+
+void end_turn()
+{
+    auto &d = data();
+    if( d.mode == replay_mode::recording ) {
+        const std::string state = current_state();
+        write_line( [&state]( JsonOut & jsout ) {
+            jsout.start_object();
+            jsout.member( "turn", static_cast<int>( calendar::turn ) );
+            jsout.member( "state", state );
+            jsout.end_object();
+        } );
+        return;
+    }
+    if( d.mode != replay_mode::playing || ++d.turns_played % d.verify_interval != 0 ) {
+        return;
+    }
+    const auto recorded = d.states.find( calendar::turn );
+    if( recorded == d.states.end() ) {
+        return;
+    }
+    d.verified++;
+    const std::string state = current_state();
+    if( state != recorded->second ) {
+        if( d.mismatched == 0 ) {
+            d.first_mismatch = string_format( "turn %d\n  recorded: %s\n  replayed: %s",
+                                              static_cast<int>( calendar::turn ),
+                                              recorded->second.c_str(), state.c_str() );
+        }
+        d.mismatched++;
+    }
+}
+
+int events_played()
+{
+    return data().next_event;
+}
+
+int turns_verified()
+{
+    return data().verified;
+}
+
+int turns_mismatched()
+{
+    return data().mismatched;
+}
+
+WINDOW *open_screen()
+{
+#if (defined TILES || defined _WIN32 || defined WINDOWS)
+    return initscr();
+#else
+    const header &hdr = loaded_header();
+    // Without a real terminal to ask, curses takes the size from the environment.
+    setenv( "LINES", std::to_string( hdr.height ).c_str(), 1 );
+    setenv( "COLUMNS", std::to_string( hdr.width ).c_str(), 1 );
+    FILE *nowhere = fopen( "/dev/null", "w" );
+    if( nowhere == nullptr ) {
+        return nullptr;
+    }
+    SCREEN *screen = newterm( "xterm", nowhere, stdin );
+    if( screen == nullptr ) {
+        return nullptr;
+    }
+    set_term( screen );
+    return stdscr;
+#endif
+}
+
+} // namespace replay
+
+bool game::run_replay( const std::string &path, int verify_interval )
+{
+    const replay::header &hdr = replay::loaded_header();
+    // The copy is played in a world of its own, the recorded one stays untouched.
+    const std::string replay_world = hdr.world + "-replay";
+    const std::string world_path = FILENAMES["savedir"] + replay_world;
+    if( file_exist( world_path ) ) {
+        endwin();
+        std::cerr << world_path << " already exists, remove it to replay " << path << std::endl;
+        return false;
+    }
+    if( !copy_directory( path + ".world", world_path ) ) {
+        endwin();
+        std::cerr << "Could not copy " << path << ".world to " << world_path << std::endl;
+        return false;
+    }
+
+    world_generator->get_all_worlds();
+    const auto world = world_generator->all_worlds.find( replay_world );
+    bool loaded = false;
+    if( world != world_generator->all_worlds.end() ) {
+        try {
+            world_generator->set_active_world( world->second );
+            setup();
+            load( replay_world, hdr.save );
+            loaded = true;
+        } catch( const std::exception &err ) {
+            debugmsg( "cannot load world '%s': %s", replay_world.c_str(), err.what() );
+        }
+    }
+    if( !loaded ) {
+        endwin();
+        std::cerr << "Could not load the recorded save" << std::endl;
+        return false;
+    }
+    const bool same_start = rng_get_engine().serialize() == hdr.rng_state;
+    rng_get_engine().deserialize( hdr.rng_state );
+
+    // Sleeping for animations and saving depend on the wall clock, not on the recording.
+    get_options().get_option( "ANIMATION_DELAY" ).setValue( 0 );
+    get_options().get_option( "AUTOSAVE" ).setValue( "false" );
+
+    replay::start_playing( verify_interval );
+    profiler::reset();
+    profiler::enabled = true;
+
+    int turns = 0;
+    double slowest_us = 0.0;
+    int slowest_turn = 0;
+    bool session_ended = false;
+    const auto replay_start = std::chrono::steady_clock::now();
+    try {
+        while( !session_ended ) {
+            const auto turn_start = std::chrono::steady_clock::now();
+            session_ended = do_turn();
+            const auto turn_end = std::chrono::steady_clock::now();
+            const double us = std::chrono::duration<double, std::micro>( turn_end - turn_start ).count();
+            if( us > slowest_us ) {
+                slowest_us = us;
+                slowest_turn = calendar::turn;
+            }
+            turns++;
+        }
+    } catch( const replay::end_of_recording & ) {
+        // The recorded session was cut short, everything up to there was replayed.
+    }
+    const auto replay_end = std::chrono::steady_clock::now();
+    replay::stop_playing();
+    const double total_ms = std::chrono::duration<double, std::milli>( replay_end - replay_start ).count();
+    endwin();
+
+    printf( "Replayed %d input events over %d turns from turn %d\n", replay::events_played(), turns,
+            hdr.turn );
+    if( !same_start ) {
+        printf( "The loaded save did not start with the recorded random numbers\n" );
+    }
+    printf( "%-22s %12.2f ms\n", "Total", total_ms );
+    printf( "%-22s %12.1f us\n", "Mean per turn", turns > 0 ? total_ms * 1000.0 / turns : 0.0 );
+    printf( "%-22s %12.1f us (turn %d)\n", "Slowest turn", slowest_us, slowest_turn );
+    printf( "State compared on %d turns, %d differed\n", replay::turns_verified(),
+            replay::turns_mismatched() );
+    if( replay::turns_mismatched() > 0 ) {
+        printf( "First difference at %s\n", data().first_mismatch.c_str() );
+    }
+    printf( "\n%s", profiler::summary().c_str() );
+
+    delete_world( replay_world, true );
+    return replay::turns_mismatched() == 0;
+}
@@ -0,0 +1,85 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdexcept>
+#include <string>
+
+#include "cursesdef.h"
+
+struct input_event;
+
+/**
+ * Records a play session so it can be run again later, see doc/BENCHMARK.md.
+ *
+ * A recording starts when a save is loaded: the world is copied next to the recording and
+ * every input event consumed by @ref input_context::handle_input is written down together
+ * with a short description of the game state after each turn. Replaying loads the copy,
+ * feeds the recorded events back and compares the game state every few turns.
+ */
+namespace replay
+{
+
+/** Thrown when the game wants input after all recorded events were replayed */
+class end_of_recording : public std::runtime_error
+{
+    public:
+        end_of_recording() : std::runtime_error( "end of recording" ) {}
+};
+
+/** What a recording starts from, written as its first line */
+struct header {
+    std::string world;
+    /** Name of the loaded save, as used by @ref game::load */
+    std::string save;
+    std::string rng_state;
+    int turn = 0;
+    /** Size of the terminal that was used, the user interface depends on it */
+    int width = 0;
+    int height = 0;
+};
+
+/** Records the next session to @p path, the world is copied to `<path>.world` */
+void record_to( const std::string &path );
+/** Called after a save was loaded; writes the header if a recording was requested */
+void begin_recording( const std::string &world, const std::string &save );
+/** Closes the recording once the session that was recorded ends */
+void end_recording();
+
+/** Reads the recording at @p path for @ref game::run_replay, returns false on errors */
+bool load( const std::string &path );
+/** Header of the loaded recording */
+const header &loaded_header();
+/** Whether recorded events are being fed to the game */
+bool playing();
+/** Starts feeding the loaded events, comparing the state every @p verify_interval turns */
+void start_playing( int verify_interval );
+/** Hands input back to the player */
+void stop_playing();
+
+/**
+ * While playing, sets @p evt and @p pressed_key (see @ref input_manager::get_previously_pressed_key)
+ * to the next recorded event and returns true. Returns false if no replay is running.
+ * @throws end_of_recording if all events were used up.
+ */
+bool next_input_event( input_event &evt, long &pressed_key );
+/** Writes the event to the recording if one is running */
+void record_input_event( const input_event &evt, long pressed_key );
+
+/** Called at the end of each turn to record or compare the game state */
+void end_turn();
+
+/** Number of recorded events that were replayed so far */
+int events_played();
+/** Number of turns whose state was compared and how many of those differed */
+int turns_verified();
+int turns_mismatched();
+
+/**
+ * Opens the screen for a replay. Curses builds draw to a terminal that is never shown and
+ * that has the size the recording was made with; other builds open the usual window.
+ */
+WINDOW *open_screen();
+
+} // namespace replay
+
+#endif
@@ -3,23 +3,113 @@
 #include "game_constants.h"
 #include <stdlib.h>
 #include <random>
-#include <chrono>
+
+#include <cstdio>
 
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+static uint64_t splitmix64( uint64_t &x )
+{
+    uint64_t z = ( x += 0x9E3779B97F4A7C15ull );
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+    return z ^ ( z >> 31 );
+}
+
+static inline uint32_t rotl( const uint32_t x, int k )
+{
+    return ( x << k ) | ( x >> ( 32 - k ) );
+}
+
+rng_engine::rng_engine( uint64_t seed, uint64_t stream )
+{
+    this->seed( seed, stream );
+}
+
+void rng_engine::seed( uint64_t seed, uint64_t stream )
+{
+    // Mixing the stream into the seed through splitmix64 gives unrelated states even for
+    // neighboring seeds and stream numbers (and never the all zero state in practice).
+    uint64_t x = seed;
+    x = splitmix64( x ) ^ stream;
+    const uint64_t a = splitmix64( x );
+    const uint64_t b = splitmix64( x );
+    state = {{ uint32_t( a ), uint32_t( a >> 32 ), uint32_t( b ), uint32_t( b >> 32 ) }};
+    if( state == std::array<uint32_t, 4> {{ 0, 0, 0, 0 }} ) {
+        state[0] = 1;
+    }
+}
+
+rng_engine::result_type rng_engine::operator()()
+{
+    const uint32_t result = rotl( state[1] * 5, 7 ) * 9;
+    const uint32_t t = state[1] << 9;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl( state[3], 11 );
+    return result;
+}
+
+rng_engine rng_engine::derive( uint64_t stream ) const
+{
+    const uint64_t current = ( uint64_t( state[0] ) | ( uint64_t( state[1] ) << 32 ) ) ^
+                             ( uint64_t( state[2] ) | ( uint64_t( state[3] ) << 32 ) ) * 31;
+    return rng_engine( current, stream );
+}
+
+std::string rng_engine::serialize() const
+{
+    char buffer[64];
+    snprintf( buffer, sizeof( buffer ), "%08x %08x %08x %08x",
+              unsigned( state[0] ), unsigned( state[1] ), unsigned( state[2] ), unsigned( state[3] ) );
+    return buffer;
+}
+
+bool rng_engine::deserialize( const std::string &data )
+{
+    unsigned int words[4];
+    if( sscanf( data.c_str(), "%8x %8x %8x %8x", &words[0], &words[1], &words[2], &words[3] ) != 4 ||
+        ( words[0] | words[1] | words[2] | words[3] ) == 0 ) {
+        return false;
+    }
+    for( int i = 0; i < 4; i++ ) {
+        state[i] = words[i];
+    }
+    return true;
+}
+
+rng_engine &rng_get_engine()
+{
+    static rng_engine engine;
+    return engine;
+}
+
+void rng_set_engine_seed( unsigned int seed )
+{
+    rng_get_engine().seed( seed );
+}
+
+unsigned int rng_bits()
+{
+    return rng_get_engine()();
+}
+
 long rng( long val1, long val2 )
 {
     long minVal = ( val1 < val2 ) ? val1 : val2;
     long maxVal = ( val1 < val2 ) ? val2 : val1;
-    return minVal + long( ( maxVal - minVal + 1 ) * double( rand() / double( RAND_MAX + 1.0 ) ) );
+    return minVal + long( ( maxVal - minVal + 1 ) * ( rng_bits() / ( double( rng_engine::max() ) + 1.0 ) ) );
 }
 
 double rng_float( double val1, double val2 )
 {
     double minVal = ( val1 < val2 ) ? val1 : val2;
     double maxVal = ( val1 < val2 ) ? val2 : val1;
-    return minVal + ( maxVal - minVal ) * double( rand() ) / double( RAND_MAX + 1.0 );
+    return minVal + ( maxVal - minVal ) * rng_bits() / ( double( rng_engine::max() ) + 1.0 );
 }
 
 bool one_in( int chance )
@@ -35,7 +125,7 @@ bool one_in_improved( double chance )
 
 bool x_in_y( double x, double y )
 {
-    return ( ( double )rand() / RAND_MAX ) <= ( ( double )x / y );
+    return ( double( rng_bits() ) / rng_engine::max() ) <= ( ( double )x / y );
 }
 
 int dice( int number, int sides )
@@ -80,8 +170,6 @@ int djb2_hash( const unsigned char *str )
 
 double rng_normal( double lo, double hi )
 {
-    static std::default_random_engine eng;
-
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -90,15 +178,13 @@ double rng_normal( double lo, double hi )
     if( range == 0.0 ) {
         return hi;
     }
-    double val = std::normal_distribution<double>( ( hi + lo ) / 2, range )( eng );
+    double val = std::normal_distribution<double>( ( hi + lo ) / 2, range )( rng_get_engine() );
     return std::max( std::min( val, hi ), lo );
 }
 
 double normal_roll( double mean, double stddev )
 {
-    static std::default_random_engine eng(
-        std::chrono::system_clock::now().time_since_epoch().count() );
-    return std::normal_distribution<double>( mean, stddev )( eng );
+    return std::normal_distribution<double>( mean, stddev )( rng_get_engine() );
 }
 
 double erfinv( double x )
@@ -3,7 +3,70 @@
 
 #include "compatibility.h"
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <string>
+
+/**
+ * Pseudo random number generator (xoshiro128**). It is fast, has a small state that
+ * can be saved and restored, and any number of independent streams can be derived
+ * from one seed, e.g. one per overmap or per submap, so results do not depend on what
+ * else has drawn numbers before.
+ * All the functions below draw from the global instance, see @ref rng_get_engine.
+ * It satisfies the standard UniformRandomBitGenerator requirements, so it can be used
+ * with the distributions from <random>.
+ */
+class rng_engine
+{
+    public:
+        typedef uint32_t result_type;
+
+        explicit rng_engine( uint64_t seed = 0, uint64_t stream = 0 );
+        /** Starts the sequence of the given seed and stream (again). */
+        void seed( uint64_t seed, uint64_t stream = 0 );
+        result_type operator()();
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT32_MAX;
+        }
+        /**
+         * A new generator whose sequence is independent of this one, derived from the
+         * current state and the stream number. This generator is not advanced.
+         */
+        rng_engine derive( uint64_t stream ) const;
+        /**
+         * Fills the range with numbers from [lo, hi] (like @ref rng does), for callers
+         * that need many numbers at once.
+         */
+        template<typename It>
+        void fill( It first, It last, long lo, long hi ) {
+            const double range = double( hi - lo + 1 ) / ( double( max() ) + 1.0 );
+            for( ; first != last; ++first ) {
+                *first = lo + long( range * ( *this )() );
+            }
+        }
+
+        std::string serialize() const;
+        /** @return Whether the data was a valid state. If not, the state stays unchanged. */
+        bool deserialize( const std::string &data );
+
+        bool operator==( const rng_engine &rhs ) const {
+            return state == rhs.state;
+        }
+
+    private:
+        std::array<uint32_t, 4> state;
+};
+
+/** The generator used by all the functions in this file. */
+rng_engine &rng_get_engine();
+/** Restarts the global generator with the given seed. */
+void rng_set_engine_seed( unsigned int seed );
+/** Uniformly distributed bits from the global generator. */
+unsigned int rng_bits();
 
 long rng( long val1, long val2 );
 double rng_float( double val1, double val2 );
@@ -22,6 +22,7 @@
 #include "translations.h"
 #include "mongroup.h"
 #include "scent_map.h"
+#include "rng.h"
 
 #include <map>
 #include <set>
@@ -102,6 +103,7 @@ void game::serialize(std::ostream & fout) {
 
         json.member( "player", u );
         Messages::serialize( json );
+        json.member( "rng_state", rng_get_engine().serialize() );
 
         json.end_object();
 }
@@ -112,7 +114,8 @@ std::string scent_map::serialize() const
     int rle_lastval = -1;
     int rle_count = 0;
     for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
+        for( auto &stored_val : elem ) {
+            const int val = pending_decay > 0 ? std::max( 0, stored_val - pending_decay ) : stored_val;
             if( val == rle_lastval ) {
                 rle_count++;
             } else {
@@ -244,6 +247,13 @@ void game::unserialize(std::istream & fin)
         data.read("player", u);
         Messages::deserialize( data );
 
+        // Continue the random sequence where it was when saving (loading the map above
+        // might have drawn from it). Older saves go on with the current state.
+        if( data.has_string( "rng_state" ) &&
+            !rng_get_engine().deserialize( data.get_string( "rng_state" ) ) ) {
+            debugmsg( "Invalid random number generator state in save" );
+        }
+
     } catch( const JsonError &jsonerr ) {
         debugmsg("Bad save json\n%s", jsonerr.c_str() );
         return;
@@ -264,6 +274,8 @@ void scent_map::deserialize( const std::string &data )
             val = stmp;
         }
     }
+    pending_decay = 0;
+    recalc_dirty_area();
 }
 
 ///// weather
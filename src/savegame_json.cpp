@@ -314,6 +314,7 @@ void Character::load(JsonObject &data)
             my_mutations.erase( it++ );
         }
     }
+    rebuild_trait_bits();
 
     data.read( "my_bionics", my_bionics );
 
@@ -2139,12 +2140,10 @@ void Creature::store( JsonOut &jsout ) const
 
     // Because JSON requires string keys we need to convert our int keys
     std::unordered_map<std::string, std::unordered_map<std::string, effect>> tmp_map;
-    for (auto maps : effects) {
-        for (auto i : maps.second) {
-            std::ostringstream convert;
-            convert << i.first;
-            tmp_map[maps.first.str()][convert.str()] = i.second;
-        }
+    for( const effect &e : effects ) {
+        std::ostringstream convert;
+        convert << e.get_bp();
+        tmp_map[e.get_id().str()][convert.str()] = e;
     }
     jsout.member( "effects", tmp_map );
 
@@ -2205,8 +2204,9 @@ void Creature::load( JsonObject &jsin )
                     }
                     const body_part bp = static_cast<body_part>( key_num );
                     effect &e = i.second;
+                    e.set_bp( bp );
 
-                    effects[id][bp] = e;
+                    effects.set( e );
                     on_effect_int_change( id, e.get_intensity(), bp );
                 }
             }
@@ -4,6 +4,7 @@
 #include "map.h"
 #include "output.h"
 #include "game.h"
+#include "profiler.h"
 
 #include <cassert>
 #include <cmath>
@@ -40,20 +41,66 @@ nc_color sev( const size_t level )
     return level < colors.size() ? colors[level] : c_dkgray;
 }
 
+static constexpr int SCENT_MAP_SIZE_X = SEEX * MAPSIZE;
+static constexpr int SCENT_MAP_SIZE_Y = SEEY * MAPSIZE;
+
+scent_map::scent_map( const game &g ) : gm( g )
+{
+    reset();
+}
+
 void scent_map::reset()
 {
     for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = 0;
-        }
+        elem.fill( 0 );
     }
+    dirty_min = point( SCENT_MAP_SIZE_X, SCENT_MAP_SIZE_Y );
+    dirty_max = point( -1, -1 );
+    pending_decay = 0;
 }
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
+    pending_decay++;
+}
+
+void scent_map::apply_decay( const int minx, const int miny, const int maxx, const int maxy )
+{
+    if( pending_decay == 0 ) {
+        return;
+    }
+    for( int x = dirty_min.x; x <= dirty_max.x; ++x ) {
+        auto &scent_col = grscent[x];
+        const bool col_inside = x >= minx && x <= maxx;
+        for( int y = dirty_min.y; y <= dirty_max.y; ++y ) {
+            if( col_inside && y >= miny && y <= maxy ) {
+                // Skip the part that the caller handles
+                y = maxy;
+                continue;
+            }
+            scent_col[y] = std::max( 0, scent_col[y] - pending_decay );
+        }
+    }
+    pending_decay = 0;
+}
+
+void scent_map::add_to_dirty_area( const int x, const int y )
+{
+    dirty_min.x = std::min( dirty_min.x, x );
+    dirty_min.y = std::min( dirty_min.y, y );
+    dirty_max.x = std::max( dirty_max.x, x );
+    dirty_max.y = std::max( dirty_max.y, y );
+}
+
+void scent_map::recalc_dirty_area()
+{
+    dirty_min = point( SCENT_MAP_SIZE_X, SCENT_MAP_SIZE_Y );
+    dirty_max = point( -1, -1 );
+    for( int x = 0; x < SCENT_MAP_SIZE_X; ++x ) {
+        for( int y = 0; y < SCENT_MAP_SIZE_Y; ++y ) {
+            if( grscent[x][y] != 0 ) {
+                add_to_dirty_area( x, y );
+            }
         }
     }
 }
@@ -73,26 +120,36 @@ void scent_map::draw( WINDOW *const win, const int div, const tripoint &center )
 
 static bool in_bounds( int x, int y )
 {
-    return x >= 0 && x < SEEX * MAPSIZE && y >= 0 && y < SEEY * MAPSIZE;
+    return x >= 0 && x < SCENT_MAP_SIZE_X && y >= 0 && y < SCENT_MAP_SIZE_Y;
 }
 
 void scent_map::shift( const int sm_shift_x, const int sm_shift_y )
 {
+    apply_decay( 0, 0, -1, -1 );
     scent_array<int> new_scent;
-    for( size_t x = 0; x < SEEX * MAPSIZE; ++x ) {
-        for( size_t y = 0; y < SEEY * MAPSIZE; ++y ) {
+    for( size_t x = 0; x < SCENT_MAP_SIZE_X; ++x ) {
+        for( size_t y = 0; y < SCENT_MAP_SIZE_Y; ++y ) {
             new_scent[x][y] = in_bounds( x + sm_shift_x, y + sm_shift_y ) ?
                               grscent[ x + sm_shift_x ][ y + sm_shift_y ] :
                               0;
         }
     }
     grscent = new_scent;
+
+    dirty_min.x = std::max( dirty_min.x - sm_shift_x, 0 );
+    dirty_min.y = std::max( dirty_min.y - sm_shift_y, 0 );
+    dirty_max.x = std::min( dirty_max.x - sm_shift_x, SCENT_MAP_SIZE_X - 1 );
+    dirty_max.y = std::min( dirty_max.y - sm_shift_y, SCENT_MAP_SIZE_Y - 1 );
+    if( dirty_min.x > dirty_max.x || dirty_min.y > dirty_max.y ) {
+        dirty_min = point( SCENT_MAP_SIZE_X, SCENT_MAP_SIZE_Y );
+        dirty_max = point( -1, -1 );
+    }
 }
 
 int scent_map::get( const tripoint &p ) const
 {
-    if( inbounds( p ) && grscent[p.x][p.y] > 0 ) {
-        return grscent[p.x][p.y] - std::abs( gm.get_levz() - p.z );
+    if( inbounds( p ) && grscent[p.x][p.y] - pending_decay > 0 ) {
+        return grscent[p.x][p.y] - pending_decay - std::abs( gm.get_levz() - p.z );
     }
     return 0;
 }
@@ -100,7 +157,11 @@ int scent_map::get( const tripoint &p ) const
 void scent_map::set( const tripoint &p, int value )
 {
     if( inbounds( p ) ) {
-        grscent[p.x][p.y] = value;
+        // Stored values still have the pending decay subtracted from them
+        grscent[p.x][p.y] = value > 0 ? value + pending_decay : value;
+        if( value != 0 ) {
+            add_to_dirty_area( p.x, p.y );
+        }
     }
 }
 
@@ -116,101 +177,115 @@ bool scent_map::inbounds( const tripoint &p ) const
 
 void scent_map::update( const tripoint &center, map &m )
 {
+    profiler::scoped_timer timer( profiler::PROF_SCENT );
     // Stop updating scent after X turns of the player not moving.
     // Once wind is added, need to reset this on wind shifts as well.
     if( center != player_last_position ) {
         player_last_position = center;
         player_last_moved = calendar::turn;
     } else if( player_last_moved + 1000 < calendar::turn ) {
+        apply_decay( 0, 0, -1, -1 );
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [SEEX * MAPSIZE]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
-
-    // these are for caching flag lookups
-    scent_array<bool> blocks_scent; // currently only TFLAG_WALL blocks scent
-    scent_array<bool> reduces_scent;
-
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    // The square around the center that gets diffused, clipped to the cells that have or can
+    // receive scent this turn. Cells outside of the dirty area and their neighbours have no
+    // scent, so diffusion would leave them at 0 anyway.
+    const int minx = std::max( center.x - SCENT_RADIUS, dirty_min.x - 1 );
+    const int maxx = std::min( center.x + SCENT_RADIUS, dirty_max.x + 1 );
+    const int miny = std::max( center.y - SCENT_RADIUS, dirty_min.y - 1 );
+    const int maxy = std::min( center.y + SCENT_RADIUS, dirty_max.y + 1 );
+    if( minx > maxx || miny > maxy ) {
+        apply_decay( 0, 0, -1, -1 );
+        return;
+    }
 
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
     const int diffusivity = 100;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, scentmap_minx - 1, scentmap_miny - 1,
-                      scentmap_maxx + 1, scentmap_maxy + 1 );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // SEEX*MAPSIZE, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
+    // The diffusion reads the 8 neighbours of each cell, so the blocker flags, the weights and
+    // the sums in the y direction are needed for a border of one cell around the square.
+    m.scent_blockers( blocks_scent, reduces_scent, minx - 1, miny - 1, maxx + 1, maxy + 1 );
+
+    // Decay everything outside of the square now, the square itself is decayed below.
+    const int decay = pending_decay;
+    apply_decay( minx - 1, miny - 1, maxx + 1, maxy + 1 );
+    pending_decay = 0;
+
+    // Sum neighbors in the y direction. This way, each square gets called 3 times instead of 9
+    // times. Walls don't take part in the diffusion, only 20% of scent can diffuse on
+    // REDUCE_SCENT squares. All arrays are indexed [x][y], so the inner loops run over
+    // contiguous memory without branches and can be vectorized by the compiler.
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        auto &scent_col = grscent[x];
+        auto &weight_col = weight[x];
+        const auto &blocks_col = blocks_scent[x];
+        const auto &reduces_col = reduces_scent[x];
+        for( int y = miny - 1; y <= maxy + 1; ++y ) {
+            if( decay > 0 ) {
+                scent_col[y] = std::max( 0, scent_col[y] - decay );
             }
+            weight_col[y] = blocks_col[y] ? 0 : reduces_col[y] ? 2 : 10;
+        }
+        auto &sum_col = sum_3_scent_y[x];
+        auto &used_col = squares_used_y[x];
+        for( int y = miny; y <= maxy; ++y ) {
+            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+            sum_col[y] = weight_col[y - 1] * scent_col[y - 1] + weight_col[y] * scent_col[y] +
+                         weight_col[y + 1] * scent_col[y + 1];
+            used_col[y] = weight_col[y - 1] + weight_col[y] + weight_col[y + 1];
         }
     }
 
-    // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            auto &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                int squares_used = squares_used_y[y][x - 1]
-                                   + squares_used_y[y][x]
-                                   + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                int temp_scent;
-                // take the old scent and subtract what diffuses out
-                temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring walls and reduce_scent squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent
-                scent_here = 0;
+    // Rest of the scent map. The sums above were taken before any cell changed, so the new
+    // values can be written in place.
+    point new_min( SCENT_MAP_SIZE_X, SCENT_MAP_SIZE_Y );
+    point new_max( -1, -1 );
+    for( int x = minx; x <= maxx; ++x ) {
+        auto &scent_col = grscent[x];
+        const auto &blocks_col = blocks_scent[x];
+        const auto &reduces_col = reduces_scent[x];
+        const auto &sum_prev = sum_3_scent_y[x - 1];
+        const auto &sum_here = sum_3_scent_y[x];
+        const auto &sum_next = sum_3_scent_y[x + 1];
+        const auto &used_prev = squares_used_y[x - 1];
+        const auto &used_here = squares_used_y[x];
+        const auto &used_next = squares_used_y[x + 1];
+        for( int y = miny; y <= maxy; ++y ) {
+            const int scent_here = scent_col[y];
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = used_prev[y] + used_here[y] + used_next[y];
+            //less air movement for REDUCE_SCENT square
+            const int this_diffusivity = reduces_col[y] ? diffusivity / 5 : diffusivity;
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring walls and reduce_scent squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // add what diffuses in from the neighbours, summed in the x direction here
+            const int new_scent = ( temp_scent + this_diffusivity *
+                                    ( sum_prev[y] + sum_here[y] + sum_next[y] ) ) / ( 1000 * 10 );
+            // cells that block scent have none
+            scent_col[y] = blocks_col[y] ? 0 : new_scent;
+        }
+        for( int y = miny; y <= maxy; ++y ) {
+            if( scent_col[y] != 0 ) {
+                new_min.x = std::min( new_min.x, x );
+                new_min.y = std::min( new_min.y, y );
+                new_max.x = std::max( new_max.x, x );
+                new_max.y = std::max( new_max.y, y );
             }
         }
     }
+
+    // Scent outside of the square (the player moved away from it) is left as it was.
+    if( dirty_min.x < minx || dirty_min.y < miny || dirty_max.x > maxx || dirty_max.y > maxy ) {
+        new_min.x = std::min( new_min.x, dirty_min.x );
+        new_min.y = std::min( new_min.y, dirty_min.y );
+        new_max.x = std::max( new_max.x, dirty_max.x );
+        new_max.y = std::max( new_max.y, dirty_max.y );
+    }
+    dirty_min = new_min;
+    dirty_max = new_max;
 }
@@ -20,18 +20,45 @@ class scent_map
         tripoint player_last_position = tripoint_min;
         int player_last_moved = -1;
 
+        /**
+         * Bounding box of all cells with non-zero scent, empty if min > max.
+         * Cells outside of it are known to be 0 and are skipped by @ref update.
+         */
+        point dirty_min;
+        point dirty_max;
+        /** Decay requested by @ref decay that hasn't been subtracted from grscent yet */
+        int pending_decay = 0;
+
+        /** Scratch buffers of @ref update, kept here to avoid putting them on the stack */
+        scent_array<bool> blocks_scent;
+        scent_array<bool> reduces_scent;
+        scent_array<int> weight;
+        scent_array<int> sum_3_scent_y;
+        scent_array<int> squares_used_y;
+
         const game &gm;
 
+        /** Subtracts the pending decay from the cells in the dirty area outside of the given box */
+        void apply_decay( int minx, int miny, int maxx, int maxy );
+        void add_to_dirty_area( int x, int y );
+        void recalc_dirty_area();
+
     public:
-        scent_map( const game &g ) : gm( g ) { };
+        scent_map( const game &g );
 
         void deserialize( const std::string &data );
         std::string serialize() const;
 
         void draw( WINDOW *w, int div, const tripoint &center ) const;
 
+        /**
+         * Diffuses the scent in a square around center. Only the part of it that overlaps
+         * the dirty area (grown by one tile) is processed, so an empty scent map costs next
+         * to nothing.
+         */
         void update( const tripoint &center, map &m );
         void reset();
+        /** Lowers all scent values by one. This is applied lazily by the next @ref update. */
         void decay();
         void shift( int sm_shift_x, int sm_shift_y );
 
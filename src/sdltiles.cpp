@@ -227,6 +227,8 @@ static std::set<std::string> bitmap_fonts;
 
 static std::vector<curseline> oversized_framebuffer;
 static std::vector<curseline> terminal_framebuffer;
+// Content of framebuffer cells that have to be drawn again
+static const cursecell unused_cell( 0, cursecell::INVALID );
 static WINDOW *winBuffer; //tracking last drawn window to fix the framebuffer
 static int fontScaleBuffer; //tracking zoom levels to fix framebuffer w/tiles
 extern WINDOW *w_hit_animation; //this window overlays w_terrain which can be oversized
@@ -352,12 +354,12 @@ bool WinCreate()
     // Initialize framebuffer caches
     terminal_framebuffer.resize(TERMINAL_HEIGHT);
     for (int i = 0; i < TERMINAL_HEIGHT; i++) {
-        terminal_framebuffer[i].chars.assign(TERMINAL_WIDTH, cursecell(""));
+        terminal_framebuffer[i].chars.assign(TERMINAL_WIDTH, unused_cell);
     }
 
     oversized_framebuffer.resize(TERMINAL_HEIGHT);
     for (int i = 0; i < TERMINAL_HEIGHT; i++) {
-        oversized_framebuffer[i].chars.assign(TERMINAL_WIDTH, cursecell(""));
+        oversized_framebuffer[i].chars.assign(TERMINAL_WIDTH, unused_cell);
     }
 
     const Uint32 wformat = SDL_GetWindowPixelFormat(window);
@@ -740,14 +742,14 @@ void Font::draw_ascii_lines(unsigned char line_id, int drawx, int drawy, int FG)
 void invalidate_framebuffer( std::vector<curseline> &framebuffer, int x, int y, int width, int height )
 {
     for( int j = 0, fby = y; j < height; j++, fby++ ) {
-        std::fill_n( framebuffer[fby].chars.begin() + x, width, cursecell( "" ) );
+        std::fill_n( framebuffer[fby].chars.begin() + x, width, unused_cell );
     }
 }
 
 void invalidate_framebuffer( std::vector<curseline> &framebuffer )
 {
     for( unsigned int i = 0; i < framebuffer.size(); i++ ) {
-        std::fill_n( framebuffer[i].chars.begin(), framebuffer[i].chars.size(), cursecell( "" ) );
+        std::fill_n( framebuffer[i].chars.begin(), framebuffer[i].chars.size(), unused_cell );
     }
 }
 
@@ -764,11 +766,11 @@ void reinitialize_framebuffer()
     const int new_width = std::max( TERMX, std::max( OVERMAP_WINDOW_WIDTH, TERRAIN_WINDOW_WIDTH ) );
     oversized_framebuffer.resize( new_height );
     for( int i = 0; i < new_height; i++ ) {
-        oversized_framebuffer[i].chars.assign( new_width, cursecell( "" ) );
+        oversized_framebuffer[i].chars.assign( new_width, unused_cell );
     }
     terminal_framebuffer.resize( new_height );
     for( int i = 0; i < new_height; i++ ) {
-        terminal_framebuffer[i].chars.assign( new_width, cursecell( "" ) );
+        terminal_framebuffer[i].chars.assign( new_width, unused_cell );
     }
 }
 
@@ -845,6 +847,15 @@ void curses_drawwindow(WINDOW *win)
             TERRAIN_WINDOW_TERM_WIDTH * font->fontwidth,
             TERRAIN_WINDOW_TERM_HEIGHT * font->fontheight);
 
+        if( debug_mode ) {
+            // Frame time of the map view in the top left corner
+            const std::string frame_time = string_format( "%.1f ms", tilecontext->get_frame_time_ms() );
+            for( size_t i = 0; i < frame_time.size(); i++ ) {
+                font->OutputChar( frame_time.substr( i, 1 ), ( win->x + i ) * fontwidth,
+                                  win->y * fontheight, COLOR_WHITE );
+            }
+        }
+
         invalidate_framebuffer(terminal_framebuffer, win->x, win->y, TERRAIN_WINDOW_TERM_WIDTH, TERRAIN_WINDOW_TERM_HEIGHT);
 
         update = true;
@@ -995,25 +1006,22 @@ bool Font::draw_window( WINDOW *win, int offsetx, int offsety )
             }
             oldcell = cell;
 
-            if( cell.ch.empty() ) {
+            if( cell.is_continuation() ) {
                 continue; // second cell of a multi-cell character
             }
-            const char *utf8str = cell.ch.c_str();
-            int len = cell.ch.length();
-            const int codepoint = UTF8_getch( &utf8str, &len );
             const int FG = cell.FG;
             const int BG = cell.BG;
-            if( codepoint != UNKNOWN_UNICODE ) {
-                const int cw = utf8_width( cell.ch );
+            if( !cell.is_line_drawing() ) {
+                const int cw = mk_wcwidth( cell.ch );
                 if( cw < 1 ) {
-                    // utf8_width() may return a negative width
+                    // mk_wcwidth() may return a negative width
                     continue;
                 }
                 FillRectDIB( drawx, drawy, fontwidth * cw, fontheight, BG );
-                OutputChar( cell.ch, drawx, drawy, FG );
+                OutputChar( cell.to_string(), drawx, drawy, FG );
             } else {
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
-                draw_ascii_lines( static_cast<unsigned char>( cell.ch[0] ), drawx, drawy, FG );
+                draw_ascii_lines( static_cast<unsigned char>( cell.ch ), drawx, drawy, FG );
             }
 
         }
@@ -2205,7 +2213,7 @@ void play_music(std::string playlist) {
         playlist_indexes.push_back( i );
     }
     if( list.shuffle ) {
-        std::random_shuffle( playlist_indexes.begin(), playlist_indexes.end() );
+        std::shuffle( playlist_indexes.begin(), playlist_indexes.end(), rng_get_engine() );
     }
 
     current_playlist = playlist;
@@ -17,9 +17,11 @@
 #include "player.h"
 #include "path_info.h"
 #include "options.h"
+#include "turn_arena.h"
 #include "time.h"
 #include "mapdata.h"
 #include "itype.h"
+#include "profiler.h"
 #include <chrono>
 #include <algorithm>
 #include <cmath>
@@ -96,8 +98,8 @@ void sounds::add_footstep( const tripoint &p, int volume, int, monster * )
         std::make_pair( p, sound_event {volume, "", false, true, "", ""} ) );
 }
 
-template <typename C>
-static void vector_quick_remove( std::vector<C> &source, int index )
+template <typename C, typename A>
+static void vector_quick_remove( std::vector<C, A> &source, int index )
 {
     if( source.size() != 1 ) {
         // Swap the target and the last element of the vector.
@@ -107,13 +109,14 @@ static void vector_quick_remove( std::vector<C> &source, int index )
     source.pop_back();
 }
 
-static std::vector<centroid> cluster_sounds( std::vector<std::pair<tripoint, int>> recent_sounds )
+static arena_vector<centroid> cluster_sounds( const std::vector<std::pair<tripoint, int>> &sounds )
 {
+    arena_vector<std::pair<tripoint, int>> recent_sounds( sounds.begin(), sounds.end() );
     // If there are too many monsters and too many noise sources (which can be monsters, go figure),
     // applying sound events to monsters can dominate processing time for the whole game,
     // so we cluster sounds and apply the centroids of the sounds to the monster AI
     // to fight the combanatorial explosion.
-    std::vector<centroid> sound_clusters;
+    arena_vector<centroid> sound_clusters;
     const int num_seed_clusters = std::max( std::min( recent_sounds.size(), ( size_t ) 10 ),
                                             ( size_t ) log( recent_sounds.size() ) );
     const size_t stopping_point = recent_sounds.size() - num_seed_clusters;
@@ -187,7 +190,8 @@ int get_signal_for_hordes( const centroid &centr )
 
 void sounds::process_sounds()
 {
-    std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
+    profiler::scoped_timer timer( profiler::PROF_SOUNDS );
+    arena_vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = weather_data( g->weather ).sound_attn;
     for( const auto &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
@@ -399,7 +399,7 @@ void start_location::burn( const tripoint &omtstart,
             }
         }
     }
-    random_shuffle( valid.begin(), valid.end() );
+    std::shuffle( valid.begin(), valid.end(), rng_get_engine() );
     for( size_t i = 0; i < std::min( count, valid.size() ); i++ ) {
         m.add_field( valid[i], fd_fire, 3, 0 );
     }
@@ -4,16 +4,16 @@
 #include "vehicle.h"
 
 #include <memory>
+#include <algorithm>
 
-submap::submap()
+submap::submap() : trp( tr_null )
 {
     constexpr size_t elements = SEEX * SEEY;
 
     std::uninitialized_fill_n( &ter[0][0], elements, t_null );
     std::uninitialized_fill_n( &frn[0][0], elements, f_null );
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
-    std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
-    std::uninitialized_fill_n( &rad[0][0], elements, 0 );
+    std::uninitialized_fill_n( &item_slots[0][0], elements, 0 );
 
     is_uniform = false;
 }
@@ -31,17 +31,67 @@ void submap::delete_vehicles()
     vehicles.clear();
 }
 
+static_assert( SEEX * SEEY < 256, "item_slots can't index the item lists of all squares" );
+
+std::list<item> &submap::get_items( const int x, const int y )
+{
+    dirty = true;
+    if( item_slots[x][y] == 0 ) {
+        item_lists.push_back( item_tile{ point( x, y ), std::unique_ptr<std::list<item>>( new std::list<item>() ) } );
+        item_slots[x][y] = item_lists.size();
+    }
+    return *item_lists[item_slots[x][y] - 1].items;
+}
+
+const std::list<item> &submap::get_items( const int x, const int y ) const
+{
+    if( item_slots[x][y] == 0 ) {
+        static const std::list<item> no_items;
+        return no_items;
+    }
+    return *item_lists[item_slots[x][y] - 1].items;
+}
+
+void submap::compact_items()
+{
+    item_lists.erase( std::remove_if( item_lists.begin(), item_lists.end(),
+    []( const item_tile & tile ) {
+        return tile.items->empty();
+    } ), item_lists.end() );
+    std::uninitialized_fill_n( &item_slots[0][0], SEEX * SEEY, 0 );
+    for( size_t i = 0; i < item_lists.size(); i++ ) {
+        item_slots[item_lists[i].pos.x][item_lists[i].pos.y] = i + 1;
+    }
+}
+
+void submap::compact_layers()
+{
+    fld.compact( []( const field & f ) {
+        return f.fieldCount() == 0;
+    } );
+    trp.compact( []( const trap_id & t ) {
+        return t == tr_null;
+    } );
+    rad.compact( []( const int r ) {
+        return r == 0;
+    } );
+    cosmetics.compact( []( const std::map<std::string, std::string> &c ) {
+        return c.empty();
+    } );
+}
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 
 bool submap::has_graffiti( int x, int y ) const
 {
-    return cosmetics[x][y].count( COSMETICS_GRAFFITI ) > 0;
+    return cosmetics.get( x, y ).count( COSMETICS_GRAFFITI ) > 0;
 }
 
 const std::string &submap::get_graffiti( int x, int y ) const
 {
-    const auto it = cosmetics[x][y].find( COSMETICS_GRAFFITI );
-    if( it == cosmetics[x][y].end() ) {
+    const auto &cosm = cosmetics.get( x, y );
+    const auto it = cosm.find( COSMETICS_GRAFFITI );
+    if( it == cosm.end() ) {
         static const std::string empty_string;
         return empty_string;
     }
@@ -51,11 +101,15 @@ const std::string &submap::get_graffiti( int x, int y ) const
 void submap::set_graffiti( int x, int y, const std::string &new_graffiti )
 {
     is_uniform = false;
-    cosmetics[x][y][COSMETICS_GRAFFITI] = new_graffiti;
+    dirty = true;
+    cosmetics.get_mutable( x, y )[COSMETICS_GRAFFITI] = new_graffiti;
 }
 
 void submap::delete_graffiti( int x, int y )
 {
     is_uniform = false;
-    cosmetics[x][y].erase( COSMETICS_GRAFFITI );
+    dirty = true;
+    if( cosmetics.allocated() ) {
+        cosmetics.get_mutable( x, y ).erase( COSMETICS_GRAFFITI );
+    }
 }
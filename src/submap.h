@@ -15,6 +15,9 @@
 #include <list>
 #include <map>
 #include <string>
+#include <memory>
+#include <array>
+#include <algorithm>
 
 class map;
 class vehicle;
@@ -44,14 +47,74 @@ struct spawn_point {
              mission_id (MIS), friendly (F), name (N) {}
 };
 
+/**
+ * Per square data of a submap that most submaps don't have, like fields or traps.
+ * The values are only allocated once one is modified, until then every square has
+ * the default value.
+ */
+template<typename T>
+class sparse_layer
+{
+    public:
+        sparse_layer( const T &def = T() ) : default_value( def ) { }
+
+        /** Whether the values have been allocated, if not, all squares have the default value */
+        bool allocated() const {
+            return values != nullptr;
+        }
+        /** The value of the square */
+        const T &get( const int x, const int y ) const {
+            return values ? ( *values )[x][y] : default_value;
+        }
+        /** The value of the square for modification, allocates the values if needed */
+        T &get_mutable( const int x, const int y ) {
+            if( !values ) {
+                values.reset( new layer_array() );
+                for( auto &column : *values ) {
+                    column.fill( default_value );
+                }
+            }
+            return ( *values )[x][y];
+        }
+        /** Sets the value of the square, setting the default value doesn't allocate anything */
+        void set( const int x, const int y, const T &value ) {
+            if( values || !( value == default_value ) ) {
+                get_mutable( x, y ) = value;
+            }
+        }
+        /** Frees the values if all of them are default values, according to the predicate */
+        template<typename Predicate>
+        void compact( Predicate is_default ) {
+            if( !values ) {
+                return;
+            }
+            for( auto &column : *values ) {
+                if( !std::all_of( column.begin(), column.end(), is_default ) ) {
+                    return;
+                }
+            }
+            values.reset();
+        }
+        void swap( sparse_layer &other ) {
+            std::swap( default_value, other.default_value );
+            values.swap( other.values );
+        }
+
+    private:
+        using layer_array = std::array<std::array<T, SEEY>, SEEX>;
+        T default_value;
+        std::unique_ptr<layer_array> values;
+};
+
 struct submap {
     trap_id get_trap( const int x, const int y ) const {
-        return trp[x][y];
+        return trp.get( x, y );
     }
 
     void set_trap( const int x, const int y, trap_id trap ) {
         is_uniform = false;
-        trp[x][y] = trap;
+        dirty = true;
+        trp.set( x, y, trap );
     }
 
     furn_id get_furn( const int x, const int y ) const {
@@ -60,6 +123,7 @@ struct submap {
 
     void set_furn( const int x, const int y, furn_id furn ) {
         is_uniform = false;
+        dirty = true;
         frn[x][y] = furn;
     }
 
@@ -69,20 +133,23 @@ struct submap {
 
     void set_ter( const int x, const int y, ter_id terr ) {
         is_uniform = false;
+        dirty = true;
         ter[x][y] = terr;
     }
 
     int get_radiation( const int x, const int y ) const {
-        return rad[x][y];
+        return rad.get( x, y );
     }
 
     void set_radiation( const int x, const int y, const int radiation ) {
         is_uniform = false;
-        rad[x][y] = radiation;
+        dirty = true;
+        rad.set( x, y, radiation );
     }
 
     void update_lum_add( item const &i, int const x, int const y ) {
         is_uniform = false;
+        dirty = true;
         if (i.is_emissive() && lum[x][y] < 255) {
             lum[x][y]++;
         }
@@ -90,6 +157,7 @@ struct submap {
 
     void update_lum_rem( item const &i, int const x, int const y ) {
         is_uniform = false;
+        dirty = true;
         if (!i.is_emissive()) {
             return;
         } else if (lum[x][y] && lum[x][y] < 255) {
@@ -100,7 +168,7 @@ struct submap {
         // Have to scan through all items to be sure removing i will actally lower
         // the count below 255.
         int count = 0;
-        for (auto const &it : itm[x][y]) {
+        for (auto const &it : get_items( x, y )) {
             if (it.is_emissive()) {
                 count++;
             }
@@ -111,6 +179,36 @@ struct submap {
         }
     }
 
+    bool has_items( const int x, const int y ) const {
+        return item_slots[x][y] != 0 && !item_lists[item_slots[x][y] - 1].items->empty();
+    }
+
+    /**
+     * The items on the square. Its list is created when needed. Lists that became empty
+     * stay until @ref compact_items is called, so references to them don't dangle.
+     * The submap is considered modified, the items may be changed through the list.
+     */
+    std::list<item> &get_items( int x, int y );
+    /** The items on the square, an empty list if there are none */
+    const std::list<item> &get_items( int x, int y ) const;
+
+    /** Item list of a square, only for the squares that have one, see @ref get_item_tiles */
+    struct item_tile {
+        point pos;
+        std::unique_ptr<std::list<item>> items;
+    };
+    /**
+     * The squares that have an item list (which may be empty), to visit all items
+     * without looking at every square.
+     */
+    const std::vector<item_tile> &get_item_tiles() const {
+        return item_lists;
+    }
+    /** Frees the lists of the squares that have no items anymore */
+    void compact_items();
+    /** Frees the layers (@ref fld, @ref trp, ...) that only hold default values */
+    void compact_layers();
+
     bool has_graffiti( int x, int y ) const;
     const std::string &get_graffiti( int x, int y ) const;
     void set_graffiti( int x, int y, const std::string &new_graffiti );
@@ -121,7 +219,7 @@ struct submap {
     // Its effect is meant to be cosmetic and atmospheric only.
     bool has_signage( const int x, const int y) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            return cosmetics[x][y].find("SIGNAGE") != cosmetics[x][y].end();
+            return cosmetics.get( x, y ).count( "SIGNAGE" ) > 0;
         }
 
         return false;
@@ -129,8 +227,9 @@ struct submap {
     // Dependent on furniture + cosmetics.
     const std::string get_signage( const int x, const int y ) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            auto iter = cosmetics[x][y].find("SIGNAGE");
-            if( iter != cosmetics[x][y].end() ) {
+            const auto &cosm = cosmetics.get( x, y );
+            auto iter = cosm.find("SIGNAGE");
+            if( iter != cosm.end() ) {
                 return iter->second;
             }
         }
@@ -140,28 +239,42 @@ struct submap {
     // Can be used anytime (prevents code from needing to place sign first.)
     void set_signage( const int x, const int y, std::string s) {
         is_uniform = false;
-        cosmetics[x][y]["SIGNAGE"] = s;
+        dirty = true;
+        cosmetics.get_mutable( x, y )["SIGNAGE"] = s;
     }
     // Can be used anytime (prevents code from needing to place sign first.)
     void delete_signage( const int x, const int y) {
         is_uniform = false;
-        cosmetics[x][y].erase("SIGNAGE");
+        dirty = true;
+        if( cosmetics.allocated() ) {
+            cosmetics.get_mutable( x, y ).erase("SIGNAGE");
+        }
     }
 
     // TODO: make trp private once the horrible hack known as editmap is resolved
     ter_id          ter[SEEX][SEEY];  // Terrain on each square
     furn_id         frn[SEEX][SEEY];  // Furniture on each square
     std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
-    std::list<item> itm[SEEX][SEEY];  // Items on each square
-    field           fld[SEEX][SEEY];  // Field on each square
-    trap_id         trp[SEEX][SEEY];  // Trap on each square
-    int             rad[SEEX][SEEY];  // Irradiation of each square
+    /**
+     * Items on each square: one plus the index of the square's list in @ref item_lists,
+     * or 0 if it has none. Most squares never hold an item, this saves having a list
+     * for each of them.
+     */
+    std::uint8_t    item_slots[SEEX][SEEY];
+    std::vector<item_tile> item_lists;
+    // The following are only allocated for submaps that have any of them.
+    sparse_layer<field>   fld;  // Field on each square
+    sparse_layer<trap_id> trp;  // Trap on each square
+    sparse_layer<int>     rad;  // Irradiation of each square
 
     // If is_uniform is true, this submap is a solid block of terrain
     // Uniform submaps aren't saved/loaded, because regenerating them is faster
     bool is_uniform;
+    // If dirty is false, the submap hasn't changed since it has been loaded or saved,
+    // saving skips it. The functions that modify the submap set it.
+    bool dirty = true;
 
-    std::map<std::string, std::string> cosmetics[SEEX][SEEY]; // Textual "visuals" for each square.
+    sparse_layer<std::map<std::string, std::string>> cosmetics; // Textual "visuals" for each square.
 
     active_item_cache active_items;
 
@@ -232,17 +345,22 @@ public:
 
     const field &get_field() const
     {
-        return sm->fld[x][y];
+        return sm->fld.get( x, y );
     }
 
     field_entry* find_field( const field_id field_to_find )
     {
-        return sm->fld[x][y].findField( field_to_find );
+        if( !sm->fld.allocated() ) {
+            return nullptr;
+        }
+        sm->dirty = true;
+        return sm->fld.get_mutable( x, y ).findField( field_to_find );
     }
 
     bool add_field( const field_id field_to_add, const int new_density, const int new_age )
     {
-        const bool ret = sm->fld[x][y].addField( field_to_add, new_density, new_age );
+        sm->dirty = true;
+        const bool ret = sm->fld.get_mutable( x, y ).addField( field_to_add, new_density, new_age );
         if( ret ) {
             sm->field_count++;
         }
@@ -278,12 +396,12 @@ public:
     // For map::draw_maptile
     size_t get_item_count() const
     {
-        return sm->itm[x][y].size();
+        return sm->get_items( x, y ).size();
     }
 
     const item &get_uppermost_item() const
     {
-        return sm->itm[x][y].back();
+        return sm->get_items( x, y ).back();
     }
 };
 
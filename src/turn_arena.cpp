@@ -0,0 +1,120 @@
+#include "turn_arena.h"
+
+#include "debug.h"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace turn_arena
+{
+
+/** Size of the first block, every further block is twice as large as the one before */
+static constexpr size_t first_block_size = 256 * 1024;
+/** The arena doesn't grow beyond this, everything else goes to the heap */
+static constexpr size_t max_capacity = 64 * 1024 * 1024;
+static constexpr size_t alignment = alignof( std::max_align_t );
+
+struct block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+};
+
+static std::vector<block> blocks;
+/** The block allocations are currently cut from and the start of its free space */
+static size_t current = 0;
+static size_t top = 0;
+static size_t total_capacity = 0;
+/** Allocations from the blocks that have not been given back yet */
+static long live = 0;
+static arena_stats stats;
+
+static bool in_arena( const char *ptr )
+{
+    return std::any_of( blocks.begin(), blocks.end(), [ptr]( const block & b ) {
+        return ptr >= b.data.get() && ptr < b.data.get() + b.size;
+    } );
+}
+
+static size_t aligned_size( size_t bytes )
+{
+    return std::max( alignment, ( bytes + alignment - 1 ) / alignment * alignment );
+}
+
+void *allocate( size_t bytes )
+{
+    bytes = aligned_size( bytes );
+    stats.turn_allocations++;
+    stats.turn_bytes += bytes;
+
+    while( current < blocks.size() && top + bytes > blocks[current].size ) {
+        current++;
+        top = 0;
+    }
+    if( current == blocks.size() ) {
+        const size_t size = std::max( bytes, blocks.empty() ? first_block_size : blocks.back().size * 2 );
+        if( total_capacity + size > max_capacity ) {
+            stats.heap_allocations++;
+            return ::operator new( bytes );
+        }
+        blocks.push_back( block{ std::unique_ptr<char[]>( new char[size] ), size } );
+        total_capacity += size;
+    }
+
+    char *const ptr = blocks[current].data.get() + top;
+    top += bytes;
+    live++;
+    return ptr;
+}
+
+void deallocate( void *ptr, size_t bytes )
+{
+    char *const p = static_cast<char *>( ptr );
+    if( !in_arena( p ) ) {
+        ::operator delete( ptr );
+        return;
+    }
+    bytes = aligned_size( bytes );
+    // The most recent allocation can be handed out again right away
+    if( current < blocks.size() && p + bytes == blocks[current].data.get() + top ) {
+        top -= bytes;
+    }
+    live--;
+    if( live == 0 ) {
+        current = 0;
+        top = 0;
+    }
+}
+
+void end_turn()
+{
+    stats.turns++;
+    stats.allocations += stats.turn_allocations;
+    stats.max_turn_allocations = std::max( stats.max_turn_allocations, stats.turn_allocations );
+    stats.max_turn_bytes = std::max( stats.max_turn_bytes, stats.turn_bytes );
+    stats.turn_allocations = 0;
+    stats.turn_bytes = 0;
+
+    static bool reported = false;
+    if( live != 0 && !reported ) {
+        reported = true;
+        debugmsg( "%ld allocations from the turn arena are still in use at the end of the turn", live );
+    }
+}
+
+void reset_stats()
+{
+    stats = arena_stats();
+}
+
+const arena_stats &get_stats()
+{
+    return stats;
+}
+
+size_t capacity()
+{
+    return total_capacity;
+}
+
+} // namespace turn_arena
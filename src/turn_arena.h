@@ -0,0 +1,81 @@
+#ifndef TURN_ARENA_H
+#define TURN_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Memory for the short-lived containers of a turn or a frame.
+ *
+ * Allocations are cut from large blocks by bumping a pointer and giving them back costs
+ * nothing. As soon as nothing allocated from the arena is alive anymore, it starts over at
+ * the beginning of its first block, so the blocks are reused by every turn and every frame.
+ * Containers using @ref arena_allocator must not be kept beyond the turn they were created
+ * in; @ref turn_arena::end_turn complains about any that are. Main thread only.
+ */
+namespace turn_arena
+{
+
+void *allocate( size_t bytes );
+void deallocate( void *ptr, size_t bytes );
+
+struct arena_stats {
+    /** Allocations and bytes during the turn in progress */
+    long turn_allocations = 0;
+    size_t turn_bytes = 0;
+
+    /** Totals over all finished turns */
+    long turns = 0;
+    long allocations = 0;
+    long max_turn_allocations = 0;
+    size_t max_turn_bytes = 0;
+    /** Allocations that went to the heap because the arena was full */
+    long heap_allocations = 0;
+};
+
+/** Called once at the end of every turn, folds the turn into the totals */
+void end_turn();
+/** Discards the totals */
+void reset_stats();
+const arena_stats &get_stats();
+/** Bytes held by the blocks of the arena */
+size_t capacity();
+
+} // namespace turn_arena
+
+/** Allocator for standard containers that takes its memory from @ref turn_arena */
+template<typename T>
+class arena_allocator
+{
+    public:
+        using value_type = T;
+
+        arena_allocator() = default;
+        template<typename U>
+        arena_allocator( const arena_allocator<U> & ) {
+        }
+
+        T *allocate( size_t n ) {
+            return static_cast<T *>( turn_arena::allocate( n * sizeof( T ) ) );
+        }
+        void deallocate( T *ptr, size_t n ) {
+            turn_arena::deallocate( ptr, n * sizeof( T ) );
+        }
+};
+
+template<typename T, typename U>
+bool operator==( const arena_allocator<T> &, const arena_allocator<U> & )
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=( const arena_allocator<T> &, const arena_allocator<U> & )
+{
+    return false;
+}
+
+template<typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+#endif
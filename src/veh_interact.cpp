@@ -541,7 +541,7 @@ bool veh_interact::can_install_part() {
     int dif_steering = 0;
     if (sel_vpart_info->has_flag("STEERABLE")) {
         std::set<int> axles;
-        for (auto &p : veh->steering) {
+        for (auto &p : veh->parts_with_flag( VPFLAG_STEERING )) {
             if (!veh->part_flag(p, "TRACKED")) {
                 // tracked parts don't contribute to axle complexity
                 axles.insert(veh->parts[p].mount.x);
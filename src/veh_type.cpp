@@ -72,7 +72,11 @@ static const std::unordered_map<std::string, vpart_bitflags> vpart_bitflag_map =
     { "SOLAR_PANEL", VPFLAG_SOLAR_PANEL },
     { "VPFLAG_TRACK", VPFLAG_TRACK },
     { "RECHARGE", VPFLAG_RECHARGE },
-    { "VISION", VPFLAG_EXTENDS_VISION }
+    { "VISION", VPFLAG_EXTENDS_VISION },
+    { "REACTOR", VPFLAG_REACTOR },
+    { "FUNNEL", VPFLAG_FUNNEL },
+    { "UNMOUNT_ON_MOVE", VPFLAG_UNMOUNT_ON_MOVE },
+    { "SECURITY", VPFLAG_SECURITY }
 };
 
 static std::map<vpart_id, vpart_info> vpart_info_all;
@@ -247,7 +251,10 @@ void vpart_info::finalize()
         debugmsg( "JSON contains circular dependency: discarded %i vehicle parts", deferred.size() );
     }
 
+    size_t index = 0;
     for( auto& e : vpart_info_all ) {
+        e.second.index = index++;
+
         // if part name specified ensure it is translated
         // otherwise the name of the base item will be used
         if( !e.second.name_.empty() ) {
@@ -264,6 +271,16 @@ void vpart_info::finalize()
                 e.second.bitflags.set( b->second );
             }            
         }
+        // These two are not set by a single json flag
+        if( item::type_is_defined( e.second.item ) && item::find_type( e.second.item )->engine ) {
+            e.second.bitflags.set( VPFLAG_ENGINE );
+        }
+        // TRACKED contributes to steering effectiveness but
+        //  (a) doesn't count as a steering axle for install difficulty
+        //  (b) still contributes to drag for the center of steering calc
+        if( e.second.has_flag( "STEERABLE" ) || e.second.has_flag( "TRACKED" ) ) {
+            e.second.bitflags.set( VPFLAG_STEERING );
+        }
 
         e.second.power = hp_to_watt( e.second.power );
 
@@ -66,6 +66,11 @@ enum vpart_bitflags : int {
     VPFLAG_TRACK,
     VPFLAG_RECHARGE,
     VPFLAG_EXTENDS_VISION,
+    VPFLAG_REACTOR,
+    VPFLAG_FUNNEL,
+    VPFLAG_UNMOUNT_ON_MOVE,
+    VPFLAG_SECURITY,
+    VPFLAG_STEERING,
 
     NUM_VPFLAGS
 };
@@ -200,6 +205,8 @@ class vpart_info
 
         int z_order;        // z-ordering, inferred from location, cached here
         int list_order;     // Display order in vehicle interact display
+        /** Position in @ref all, for tables indexed by part type */
+        size_t index = 0;
 
         bool has_flag( const std::string &flag ) const {
             return flags.count( flag ) != 0;
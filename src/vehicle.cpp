@@ -31,6 +31,7 @@
 #include "map_iterator.h"
 #include "vehicle_selector.h"
 #include "cata_utility.h"
+#include "profiler.h"
 
 #include <sstream>
 #include <stdlib.h>
@@ -40,6 +41,7 @@
 #include <array>
 #include <numeric>
 #include <algorithm>
+#include <climits>
 
 /*
  * Speed up all those if ( blarg == "structure" ) statements that are used everywhere;
@@ -62,6 +64,12 @@ static const fault_id fault_starter( "fault_engine_starter" );
 static const fault_id fault_filter_air( "fault_engine_filter_air" );
 static const fault_id fault_filter_fuel( "fault_engine_filter_fuel" );
 
+// Whether the rectangles given by their corners have a point in common
+static bool boxes_overlap( const point &min1, const point &max1, const point &min2, const point &max2 )
+{
+    return min1.x <= max2.x && min2.x <= max1.x && min1.y <= max2.y && min2.y <= max1.y;
+}
+
 const skill_id skill_mechanics( "mechanics" );
 
 const efftype_id effect_stunned( "stunned" );
@@ -642,7 +650,7 @@ bool vehicle::select_engine() {
     tmenu.addentry(-1, true, 'q', _("Finish"));
 
     tmenu.query();
-    if( tmenu.ret >= 0 && tmenu.ret < int( engines.size() ) ) {
+    if( tmenu.ret >= 0 && tmenu.ret < int( parts_with_flag( VPFLAG_ENGINE ).size() ) ) {
         for( auto &e : parts ) {
             if( e.is_engine() ) {
                 e.enabled = false;
@@ -655,7 +663,7 @@ bool vehicle::select_engine() {
 }
 
 void vehicle::toggle_specific_engine(int e,bool on) {
-    toggle_specific_part( engines[e], on );
+    toggle_specific_part( parts_with_flag( VPFLAG_ENGINE )[e], on );
 }
 void vehicle::toggle_specific_part(int p,bool on) {
     parts[p].enabled = on;
@@ -667,7 +675,7 @@ bool vehicle::is_engine_type_on(int e, const itype_id &ft) const
 
 bool vehicle::has_engine_type(const itype_id &ft, bool const enabled) const
 {
-    for( size_t e = 0; e < engines.size(); ++e ) {
+    for( size_t e = 0; e < parts_with_flag( VPFLAG_ENGINE ).size(); ++e ) {
         if( is_engine_type(e, ft) && (!enabled || is_engine_on(e)) ) {
             return true;
         }
@@ -676,7 +684,7 @@ bool vehicle::has_engine_type(const itype_id &ft, bool const enabled) const
 }
 bool vehicle::has_engine_type_not(const itype_id &ft, bool const enabled) const
 {
-    for( size_t e = 0; e < engines.size(); ++e ) {
+    for( size_t e = 0; e < parts_with_flag( VPFLAG_ENGINE ).size(); ++e ) {
         if( !is_engine_type(e, ft) && (!enabled || is_engine_on(e)) ) {
             return true;
         }
@@ -685,12 +693,13 @@ bool vehicle::has_engine_type_not(const itype_id &ft, bool const enabled) const
 }
 
 bool vehicle::is_engine_type(const int e, const itype_id  &ft) const {
-    return part_info(engines[e]).fuel_type == ft;
+    return part_info(parts_with_flag( VPFLAG_ENGINE )[e]).fuel_type == ft;
 }
 
 bool vehicle::is_engine_on(int const e) const
 {
-    return !parts[ engines[ e ] ].is_broken() && is_part_on( engines[ e ] );
+    const int p = parts_with_flag( VPFLAG_ENGINE )[ e ];
+    return !parts[ p ].is_broken() && is_part_on( p );
 }
 
 bool vehicle::is_part_on(int const p) const
@@ -700,11 +709,12 @@ bool vehicle::is_part_on(int const p) const
 
 bool vehicle::is_alternator_on(int const a) const
 {
-    auto alt = parts[ alternators [ a ] ];
+    auto alt = parts[ parts_with_flag( VPFLAG_ALTERNATOR ) [ a ] ];
     if( alt.is_broken() ) {
         return false;
     }
 
+    const auto &engines = parts_with_flag( VPFLAG_ENGINE );
     return std::any_of( engines.begin(), engines.end(), [this,&alt]( int idx ) {
         auto& eng = parts [ idx ];
         return eng.enabled && eng.mount == alt.mount && !eng.faults().count( fault_belt );
@@ -713,14 +723,12 @@ bool vehicle::is_alternator_on(int const a) const
 
 bool vehicle::has_security_working() const
 {
-    bool found_security = false;
-    for (size_t s = 0; s < speciality.size(); s++){
-        if( part_flag( speciality[ s ], "SECURITY" ) && !parts[ speciality[ s ] ].is_broken() ) {
-            found_security = true;
-            break;
+    for( const int p : parts_with_flag( VPFLAG_SECURITY ) ) {
+        if( !parts[ p ].is_broken() ) {
+            return true;
         }
     }
-    return found_security;
+    return false;
 }
 
 bool vehicle::interact_vehicle_locked()
@@ -761,9 +769,8 @@ void vehicle::smash_security_system(){
     //get security and controls location
     int s = -1;
     int c = -1;
-    for (size_t d = 0; d < speciality.size(); d++){
-        int p = speciality[d];
-        if( part_flag( p, "SECURITY" ) && !parts[ p ].is_broken() ) {
+    for( const int p : parts_with_flag( VPFLAG_SECURITY ) ) {
+        if( !parts[ p ].is_broken() ) {
             s = p;
             c = part_with_feature(s, "CONTROLS");
             break;
@@ -1096,8 +1103,9 @@ bool vehicle::start_engine( const int e )
 {
     if( !is_engine_on( e ) ) { return false; }
 
-    const vpart_info &einfo = part_info( engines[e] );
-    const vehicle_part &eng = parts[ engines[ e ] ];
+    const int p = parts_with_flag( VPFLAG_ENGINE )[e];
+    const vpart_info &einfo = part_info( p );
+    const vehicle_part &eng = parts[ p ];
 
     if( !fuel_left( einfo.fuel_type ) ) {
         if( einfo.fuel_type == fuel_type_muscle ) {
@@ -1111,7 +1119,7 @@ bool vehicle::start_engine( const int e )
 
     auto mv = eng.base.engine_start_time( g->temperature );
     if( mv > 0 ) {
-        const tripoint pos = global_part_pos3( engines[e] );
+        const tripoint pos = global_part_pos3( p );
         sounds::ambient_sound( pos, mv / 10, "" );
     }
 
@@ -1142,6 +1150,7 @@ bool vehicle::start_engine( const int e )
 
 void vehicle::start_engines( const bool take_control )
 {
+    const auto &engines = parts_with_flag( VPFLAG_ENGINE );
     bool has_engine = std::any_of( engines.begin(), engines.end(), [&]( int idx ) {
         return !parts[ idx ].is_broken() && parts[ idx ].enabled;
     } );
@@ -1178,8 +1187,9 @@ void vehicle::start_engines( const bool take_control )
 
 void vehicle::backfire( const int e ) const
 {
-    const int power = watt_to_hp( part_power( engines[e], true ) );
-    const tripoint pos = global_part_pos3( engines[e] );
+    const int p = parts_with_flag( VPFLAG_ENGINE )[e];
+    const int power = watt_to_hp( part_power( p, true ) );
+    const tripoint pos = global_part_pos3( p );
     //~ backfire sound
     sounds::ambient_sound( pos, 40 + (power / 30), _( "BANG!" ) );
 }
@@ -1838,6 +1848,7 @@ bool vehicle::remove_part (int p)
     }
 
     // Update current engine configuration if needed
+    const auto &engines = parts_with_flag( VPFLAG_ENGINE );
     if( parts[p].is_engine() && !engines.empty() ){
         bool any_engine_on = false;
 
@@ -1978,6 +1989,10 @@ int vehicle::part_with_feature (int part, vpart_bitflags const flag, bool unbrok
     if (part_flag(part, flag)) {
         return part;
     }
+    // Most tiles don't have the feature at all
+    if( part >= 0 && part < int( mount_flags.size() ) && !mount_flags[ part ][ flag ] ) {
+        return -1;
+    }
     const auto it = relative_parts.find( parts[part].mount );
     if ( it != relative_parts.end() ) {
         const std::vector<int> & parts_here = it->second;
@@ -2022,6 +2037,16 @@ bool vehicle::has_part( const std::string &flag, bool enabled ) const
     }
 }
 
+bool vehicle::has_part( vpart_bitflags flag, bool enabled ) const
+{
+    for( const int p : flagged_parts[ flag ] ) {
+        if( !parts[ p ].is_broken() && ( !enabled || parts[ p ].enabled ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool vehicle::has_part( const tripoint &pos, const std::string &flag, bool enabled ) const
 {
     if( enabled ) {
@@ -2210,16 +2235,23 @@ std::vector<int> vehicle::all_parts_with_feature(const std::string& feature, boo
 
 std::vector<int> vehicle::all_parts_with_feature(vpart_bitflags feature, bool const unbroken) const
 {
+    if( !unbroken ) {
+        return flagged_parts[ feature ];
+    }
     std::vector<int> parts_found;
-    for( size_t part_index = 0; part_index < parts.size(); ++part_index ) {
-        if(part_info(part_index).has_flag(feature) &&
-                ( !unbroken || !parts[ part_index ].is_broken() ) ) {
-            parts_found.push_back(part_index);
+    for( const int part_index : flagged_parts[ feature ] ) {
+        if( !parts[ part_index ].is_broken() ) {
+            parts_found.push_back( part_index );
         }
     }
     return parts_found;
 }
 
+const std::vector<int> &vehicle::parts_with_flag( vpart_bitflags flag ) const
+{
+    return flagged_parts[ flag ];
+}
+
 /**
  * Returns all parts in the vehicle that exist in the given location slot. If
  * the empty string is passed in, returns all parts with no slot.
@@ -2637,12 +2669,20 @@ void vehicle::precalc_mounts (int idir, int dir, const point &pivot)
 {
     if (idir < 0 || idir > 1)
         idir = 0;
+    point &min = precalc_min[idir];
+    point &max = precalc_max[idir];
+    min = point( INT_MAX, INT_MAX );
+    max = point( INT_MIN, INT_MIN );
     for (auto &p : parts)
     {
         if (p.removed) {
             continue;
         }
         coord_translate (dir, pivot, p.mount, p.precalc[idir]);
+        min.x = std::min( min.x, p.precalc[idir].x );
+        min.y = std::min( min.y, p.precalc[idir].y );
+        max.x = std::max( max.x, p.precalc[idir].x );
+        max.y = std::max( max.y, p.precalc[idir].y );
     }
     pivot_anchor[idir] = pivot;
     pivot_rotation[idir] = dir;
@@ -2853,6 +2893,7 @@ int vehicle::total_power(bool const fueled) const
     int pwr = 0;
     int cnt = 0;
 
+    const auto &engines = parts_with_flag( VPFLAG_ENGINE );
     for (size_t e = 0; e < engines.size(); e++) {
         int p = engines[e];
         if (is_engine_on(e) && (fuel_left (part_info(p).fuel_type) || !fueled)) {
@@ -2861,6 +2902,7 @@ int vehicle::total_power(bool const fueled) const
         }
     }
 
+    const auto &alternators = parts_with_flag( VPFLAG_ALTERNATOR );
     for (size_t a = 0; a < alternators.size();a++){
         int p = alternators[a];
         if (is_alternator_on(a)) {
@@ -3010,6 +3052,7 @@ void vehicle::noise_and_smoke( double load )
 
     bool bad_filter = false;
 
+    const auto &engines = parts_with_flag( VPFLAG_ENGINE );
     for( size_t e = 0; e < engines.size(); e++ ) {
         int p = engines[e];
         if( is_engine_on(e) &&
@@ -3070,7 +3113,7 @@ void vehicle::noise_and_smoke( double load )
 float vehicle::wheel_area( bool boat ) const
 {
     float total_area = 0.0f;
-    const auto &wheel_indices = boat ? floating : wheelcache;
+    const auto &wheel_indices = parts_with_flag( boat ? VPFLAG_FLOATS : VPFLAG_WHEEL );
     for( auto &wheel_index : wheel_indices ) {
         total_area += parts[ wheel_index ].base.wheel_area();
     }
@@ -3144,7 +3187,7 @@ float vehicle::k_traction( float wheel_traction_area ) const
         return 0.0f;
     }
 
-    const float mass_penalty = ( 1.0f - wheel_traction_area / wheel_area( !floating.empty() ) ) * total_mass();
+    const float mass_penalty = ( 1.0f - wheel_traction_area / wheel_area( !parts_with_flag( VPFLAG_FLOATS ).empty() ) ) * total_mass();
 
     float traction = std::min( 1.0f, wheel_traction_area / mass_penalty );
     add_msg( m_debug, "%s has traction %.2f", name.c_str(), traction );
@@ -3186,7 +3229,7 @@ bool vehicle::balanced_wheel_config( bool boat ) const
     int ymax = INT_MIN;
     // find the bounding box of the wheels
     // TODO: find convex hull instead
-    const auto &indices = boat ? floating : wheelcache;
+    const auto &indices = parts_with_flag( boat ? VPFLAG_FLOATS : VPFLAG_WHEEL );
     for( auto &w : indices ) {
         const auto &pt = parts[ w ].mount;
         xmin = std::min( xmin, pt.x );
@@ -3209,12 +3252,12 @@ bool vehicle::valid_wheel_config( bool boat ) const
 
 float vehicle::steering_effectiveness() const
 {
-    if (!floating.empty()) {
+    if (!parts_with_flag( VPFLAG_FLOATS ).empty()) {
         // I'M ON A BOAT
         return 1.0;
     }
 
-    if (steering.empty()) {
+    if (parts_with_flag( VPFLAG_STEERING ).empty()) {
         return -1.0; // No steering installed
     }
 
@@ -3222,7 +3265,7 @@ float vehicle::steering_effectiveness() const
     // TODO: return something less than 1.0 if the steering isn't so good
     // (unbalanced, long wheelbase, back-heavy vehicle with front wheel steering,
     // etc)
-    for (int p : steering) {
+    for (int p : parts_with_flag( VPFLAG_STEERING )) {
         if( !parts[ p ].is_broken() ) {
             return 1.0;
         }
@@ -3287,6 +3330,7 @@ void vehicle::power_parts()
     // Gas engines require epower to run for ignition system, ECU, etc.
     int engine_epower = 0;
     if( engine_on ) {
+        const auto &engines = parts_with_flag( VPFLAG_ENGINE );
         for( size_t e = 0; e < engines.size(); ++e ) {
             // Electric engines consume power when actually used, not passively
             if( is_engine_on( e ) && !is_engine_type(e, fuel_type_battery) ) {
@@ -3302,6 +3346,7 @@ void vehicle::power_parts()
         // If the engine is on, the alternators are working.
         int alternators_epower = 0;
         int alternators_power = 0;
+        const auto &alternators = parts_with_flag( VPFLAG_ALTERNATOR );
         for( size_t p = 0; p < alternators.size(); ++p ) {
             if(is_alternator_on(p)) {
                 alternators_epower += part_info(alternators[p]).epower;
@@ -3315,11 +3360,11 @@ void vehicle::power_parts()
     }
 
     int epower_capacity_left = power_to_epower(fuel_capacity(fuel_type_battery) - fuel_left(fuel_type_battery));
-    if( has_part( "REACTOR", true ) && epower_capacity_left - epower > 0 ) {
+    if( has_part( VPFLAG_REACTOR, true ) && epower_capacity_left - epower > 0 ) {
         // Still not enough surplus epower to fully charge battery
         // Produce additional epower from any reactors
         bool reactor_working = false;
-        for( auto &elem : reactors ) {
+        for( auto &elem : parts_with_flag( VPFLAG_REACTOR ) ) {
             if( !parts[ elem ].is_broken() && parts[elem].ammo_remaining() > 0 ) {
                 // Efficiency: one unit of fuel is this many units of battery
                 // Note: One battery is roughtly 373 units of epower
@@ -3456,7 +3501,7 @@ int vehicle::traverse_vehicle_graph(Vehicle *start_veh, int amount, Func action)
 
         g->u.add_msg_if_player(m_debug, "Traversing graph with %d power", amount);
 
-        for(auto &p : current_veh->loose_parts) {
+        for(auto &p : current_veh->parts_with_flag( VPFLAG_UNMOUNT_ON_MOVE )) {
             if(!current_veh->part_info(p).has_flag("POWER_TRANSFER")) {
                 continue; // ignore loose parts that aren't power transfer cables
             }
@@ -3854,9 +3899,9 @@ void vehicle::thrust( int thd ) {
     }
 
     // No need to change velocity if there are no wheels
-    if( !valid_wheel_config( !floating.empty() ) && velocity == 0 ) {
+    if( !valid_wheel_config( !parts_with_flag( VPFLAG_FLOATS ).empty() ) && velocity == 0 ) {
         if( player_in_control( g->u ) ) {
-            if( floating.empty() ) {
+            if( parts_with_flag( VPFLAG_FLOATS ).empty() ) {
                 add_msg(_("The %s doesn't have enough wheels to move!"), name.c_str());
             } else {
                 add_msg(_("The %s is too leaky!"), name.c_str());
@@ -4026,6 +4071,7 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
                          const tripoint &dp,
                          bool just_detect, bool bash_floor )
 {
+    profiler::scoped_timer timer( profiler::PROF_VEH_COLLISION );
 
     /*
      * Big TODO:
@@ -4064,13 +4110,48 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
 
     const int velocity_before = coll_velocity;
     const int sign_before = sgn( velocity_before );
+
+    // Broadphase: only the area the vehicle moves into can contain anything it hits.
+    // Other vehicles and characters outside of it don't need to be looked up per part.
+    const tripoint origin = global_pos3() + dp;
+    const point area_min = point( origin.x, origin.y ) + precalc_min[1];
+    const point area_max = point( origin.x, origin.y ) + precalc_max[1];
+    std::vector<std::pair<point, point>> other_vehicle_areas;
+    if( !bash_floor && origin.z >= -OVERMAP_DEPTH && origin.z <= OVERMAP_HEIGHT ) {
+        for( const vehicle *other : g->m.get_cache_ref( origin.z ).vehicle_list ) {
+            if( other == this ) {
+                continue;
+            }
+            const tripoint other_pos = other->global_pos3();
+            const point other_min = point( other_pos.x, other_pos.y ) + other->precalc_min[0];
+            const point other_max = point( other_pos.x, other_pos.y ) + other->precalc_max[0];
+            if( boxes_overlap( area_min, area_max, other_min, other_max ) ) {
+                other_vehicle_areas.emplace_back( other_min, other_max );
+            }
+        }
+    }
+    const auto in_area = [&area_min, &area_max]( const tripoint &pos ) {
+        const point pos2( pos.x, pos.y );
+        return boxes_overlap( area_min, area_max, pos2, pos2 );
+    };
+    bool characters_in_area = in_area( g->u.pos() );
+    for( size_t i = 0; i < g->active_npc.size() && !characters_in_area; i++ ) {
+        characters_in_area = in_area( g->active_npc[i]->pos() );
+    }
+
     std::vector<int> structural_indices = all_parts_at_location(part_location_structure);
     for( size_t i = 0; i < structural_indices.size(); i++ ) {
         const int p = structural_indices[i];
         // Coords of where part will go due to movement (dx/dy/dz)
         //  and turning (precalc[1])
-        const tripoint dsp = global_pos3() + dp + parts[p].precalc[1];
-        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor );
+        const tripoint dsp = origin + parts[p].precalc[1];
+        const point dsp2( dsp.x, dsp.y );
+        const bool check_vehicles = std::any_of( other_vehicle_areas.begin(), other_vehicle_areas.end(),
+        [&dsp2]( const std::pair<point, point> &area ) {
+            return boxes_overlap( area.first, area.second, dsp2, dsp2 );
+        } );
+        veh_collision coll = part_collision( p, dsp, just_detect, bash_floor,
+                                             check_vehicles, characters_in_area );
         if( coll.type == veh_coll_nothing ) {
             continue;
         }
@@ -4120,13 +4201,20 @@ void terrain_collision_data( const tripoint &p, bool bash_floor,
 }
 
 veh_collision vehicle::part_collision( int part, const tripoint &p,
-                                       bool just_detect, bool bash_floor )
+                                       bool just_detect, bool bash_floor,
+                                       bool check_vehicles, bool check_characters )
 {
     // Vertical collisions need to be handled differently
     // All collisions have to be either fully vertical or fully horizontal for now
     const bool vert_coll = bash_floor || p.z != smz;
     const bool pl_ctrl = player_in_control( g->u );
-    Creature *critter = g->critter_at( p, true );
+    Creature *critter = nullptr;
+    if( check_characters ) {
+        critter = g->critter_at( p, true );
+    } else {
+        const int mondex = g->mon_at( p, true );
+        critter = mondex >= 0 ? &g->zombie( mondex ) : nullptr;
+    }
     player *ph = dynamic_cast<player*>( critter );
 
     Creature *driver = pl_ctrl ? &g->u : nullptr;
@@ -4138,7 +4226,7 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
     }
 
     int target_part = -1;
-    vehicle *oveh = g->m.veh_at( p, target_part );
+    vehicle *oveh = check_vehicles ? g->m.veh_at( p, target_part ) : nullptr;
     // Disable veh/critter collisions when bashing floor
     // TODO: More elegant code
     const bool is_veh_collision = !bash_floor && oveh != nullptr && oveh != this;
@@ -4769,7 +4857,7 @@ void vehicle::place_spawn_items()
 void vehicle::gain_moves()
 {
     if( velocity != 0 || falling ) {
-        if( loose_parts.size() > 0 ) {
+        if( parts_with_flag( VPFLAG_UNMOUNT_ON_MOVE ).size() > 0 ) {
             shed_loose_parts();
         }
         of_turn = 1 + of_turn_carry;
@@ -4811,17 +4899,10 @@ void vehicle::gain_moves()
  */
 void vehicle::refresh()
 {
-    alternators.clear();
-    engines.clear();
-    reactors.clear();
-    solar_panels.clear();
-    funnels.clear();
+    for( auto &indices : flagged_parts ) {
+        indices.clear();
+    }
     relative_parts.clear();
-    loose_parts.clear();
-    wheelcache.clear();
-    steering.clear();
-    speciality.clear();
-    floating.clear();
     tracking_epower = 0;
     alternator_load = 0;
     camera_epower = 0;
@@ -4834,6 +4915,7 @@ void vehicle::refresh()
         }
     } svpv = { this };
     std::vector<int>::iterator vii;
+    std::map<point, std::bitset<NUM_VPFLAGS>> tile_flags;
 
     // Main loop over all vehicle parts.
     for( size_t p = 0; p < parts.size(); p++ ) {
@@ -4841,42 +4923,16 @@ void vehicle::refresh()
         if( parts[p].removed ) {
             continue;
         }
-        if( vpi.has_flag(VPFLAG_ALTERNATOR) ) {
-            alternators.push_back( p );
-        }
-        if( parts[p].is_engine() ) {
-            engines.push_back( p );
-        }
-        if( vpi.has_flag("REACTOR") ) {
-            reactors.push_back( p );
-        }
-        if( vpi.has_flag(VPFLAG_SOLAR_PANEL) ) {
-            solar_panels.push_back( p );
-        }
-        if( vpi.has_flag("FUNNEL") ) {
-            funnels.push_back( p );
-        }
-        if( vpi.has_flag("UNMOUNT_ON_MOVE") ) {
-            loose_parts.push_back(p);
-        }
-        if( vpi.has_flag( VPFLAG_WHEEL ) ) {
-            wheelcache.push_back( p );
-        }
-        if (vpi.has_flag("STEERABLE") || vpi.has_flag("TRACKED")) {
-            // TRACKED contributes to steering effectiveness but
-            //  (a) doesn't count as a steering axle for install difficulty
-            //  (b) still contributes to drag for the center of steering calc
-            steering.push_back(p);
-        }
-        if (vpi.has_flag("SECURITY")){
-            speciality.push_back(p);
+        auto &flags_here = tile_flags[parts[p].mount];
+        for( size_t f = 0; f < NUM_VPFLAGS; f++ ) {
+            if( vpi.has_flag( static_cast<vpart_bitflags>( f ) ) ) {
+                flagged_parts[f].push_back( p );
+                flags_here.set( f );
+            }
         }
         if( vpi.has_flag( "CAMERA" ) ) {
             camera_epower += vpi.epower;
         }
-        if( vpi.has_flag( VPFLAG_FLOATS ) ) {
-            floating.push_back( p );
-        }
         if( parts[ p ].enabled ) {
             if( vpi.has_flag( "PLOW" ) ) {
                 extra_drag += vpi.power;
@@ -4895,6 +4951,13 @@ void vehicle::refresh()
         relative_parts[pt].insert( vii, p );
     }
 
+    // Removed parts get the flags of the tile they were on
+    mount_flags.resize( parts.size() );
+    for( size_t p = 0; p < parts.size(); p++ ) {
+        const auto iter = tile_flags.find( parts[p].mount );
+        mount_flags[p] = iter != tile_flags.end() ? iter->second : std::bitset<NUM_VPFLAGS>();
+    }
+
     // NB: using the _old_ pivot point, don't recalc here, we only do that when moving!
     precalc_mounts( 0, pivot_rotation[0], pivot_anchor[0] );
     check_environmental_effects = true;
@@ -4914,7 +4977,7 @@ void vehicle::refresh_pivot() const {
     // Const method, but messes with mutable fields
     pivot_dirty = false;
 
-    if( wheelcache.empty() || !valid_wheel_config( false ) ) {
+    if( parts_with_flag( VPFLAG_WHEEL ).empty() || !valid_wheel_config( false ) ) {
         // No usable wheels, use CoM (dragging)
         pivot_cache = local_center_of_mass();
         return;
@@ -4969,7 +5032,7 @@ void vehicle::refresh_pivot() const {
     float xc_numerator = 0, xc_denominator = 0;
     float yc_numerator = 0, yc_denominator = 0;
 
-    for (int p : wheelcache) {
+    for (int p : parts_with_flag( VPFLAG_WHEEL )) {
         const auto &wheel = parts[p];
 
         // @todo: load on tyre?
@@ -5015,8 +5078,7 @@ void vehicle::remove_remote_part(int part_num) {
         auto pos = global_pos3() + parts[part_num].precalc[0];
         tripoint local_abs = g->m.getabs( pos );
 
-        for( size_t j = 0; j < veh->loose_parts.size(); j++) {
-            int remote_partnum = veh->loose_parts[j];
+        for( const int remote_partnum : veh->parts_with_flag( VPFLAG_UNMOUNT_ON_MOVE ) ) {
             auto remote_part = &veh->parts[remote_partnum];
 
             if( veh->part_flag(remote_partnum, "POWER_TRANSFER") && remote_part->target.first == local_abs) {
@@ -5030,8 +5092,8 @@ void vehicle::remove_remote_part(int part_num) {
 void vehicle::shed_loose_parts() {
     // remove_part rebuilds the loose_parts vector, when all of those parts have been removed,
     // it will stay empty.
-    while( !loose_parts.empty() ) {
-        int const elem = loose_parts.front();
+    while( !parts_with_flag( VPFLAG_UNMOUNT_ON_MOVE ).empty() ) {
+        int const elem = parts_with_flag( VPFLAG_UNMOUNT_ON_MOVE ).front();
         if( part_flag( elem, "POWER_TRANSFER" ) ) {
             remove_remote_part( elem );
         }
@@ -5735,7 +5797,7 @@ void vehicle::update_time( const calendar &update_to )
 
     // Weather stuff, only for z-levels >= 0
     // TODO: Have it wash cars from blood?
-    if( funnels.empty() && solar_panels.empty() ) {
+    if( parts_with_flag( VPFLAG_FUNNEL ).empty() && parts_with_flag( VPFLAG_SOLAR_PANEL ).empty() ) {
         return;
     }
 
@@ -5743,7 +5805,7 @@ void vehicle::update_time( const calendar &update_to )
     const tripoint veh_loc = real_global_pos3();
     auto accum_weather = sum_conditions( update_from, update_to, veh_loc );
 
-    for( int idx : funnels ) {
+    for( int idx : parts_with_flag( VPFLAG_FUNNEL ) ) {
         const auto &pt = parts[idx];
 
         // we need an unbroken funnel mounted on the exterior of the vehicle
@@ -5769,9 +5831,9 @@ void vehicle::update_time( const calendar &update_to )
         }
     }
 
-    if( !solar_panels.empty() ) {
+    if( !parts_with_flag( VPFLAG_SOLAR_PANEL ).empty() ) {
         int epower = 0;
-        for( int part : solar_panels ) {
+        for( int part : parts_with_flag( VPFLAG_SOLAR_PANEL ) ) {
             if( parts[ part ].is_broken() ) {
                 continue;
             }
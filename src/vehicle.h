@@ -12,9 +12,11 @@
 #include "active_item_cache.h"
 #include "string_id.h"
 #include "units.h"
+#include "veh_type.h"
 
 #include <vector>
 #include <array>
+#include <bitset>
 #include <map>
 #include <list>
 #include <string>
@@ -24,7 +26,6 @@ class map;
 class player;
 class vehicle;
 class vpart_info;
-enum vpart_bitflags : int;
 using vpart_id = string_id<vpart_info>;
 struct vehicle_prototype;
 using vproto_id = string_id<vehicle_prototype>;
@@ -633,6 +634,7 @@ public:
      *  @param enabled if set part must also be enabled to be considered
      */
     bool has_part( const std::string &flag, bool enabled = false ) const;
+    bool has_part( vpart_bitflags flag, bool enabled = false ) const;
 
     /**
      *  Check if vehicle has at least one unbroken part with @ref flag
@@ -687,6 +689,11 @@ public:
     // returns indices of all parts in the vehicle with the given flag
     std::vector<int> all_parts_with_feature(const std::string &feature, bool unbroken = true) const;
     std::vector<int> all_parts_with_feature(vpart_bitflags f, bool unbroken = true) const;
+    /**
+     * Indices of all parts with the flag, broken ones included, in ascending order.
+     * The list is rebuilt by @ref refresh whenever parts are installed or removed.
+     */
+    const std::vector<int> &parts_with_flag( vpart_bitflags flag ) const;
 
     // returns indices of all parts in the given location slot
     std::vector<int> all_parts_at_location(const std::string &location) const;
@@ -964,8 +971,11 @@ public:
 
     // Handle given part collision with vehicle, monster/NPC/player or terrain obstacle
     // Returns collision, which has type, impulse, part, & target.
+    // check_vehicles and check_characters can be false if it's known that there are no other
+    // vehicles or no NPCs and player at p, monsters are always checked.
     veh_collision part_collision( int part, const tripoint &p,
-                                  bool just_detect, bool bash_floor );
+                                  bool just_detect, bool bash_floor,
+                                  bool check_vehicles = true, bool check_characters = true );
 
     // Process the trap beneath
     void handle_trap( const tripoint &p, int part );
@@ -1157,16 +1167,6 @@ public:
     int removed_part_count;            // Subtract from parts.size() to get the real part count.
     std::map<point, std::vector<int> > relative_parts;    // parts_at_relative(x,y) is used alot (to put it mildly)
     std::set<label> labels;            // stores labels
-    std::vector<int> alternators;      // List of alternator indices
-    std::vector<int> engines;          // List of engine indices
-    std::vector<int> reactors;         // List of reactor indices
-    std::vector<int> solar_panels;     // List of solar panel indices
-    std::vector<int> funnels;          // List of funnel indices
-    std::vector<int> loose_parts;      // List of UNMOUNT_ON_MOVE parts
-    std::vector<int> wheelcache;       // List of wheels
-    std::vector<int> steering;         // List of STEERABLE parts
-    std::vector<int> speciality;       // List of parts that will not be on a vehicle very often, or which only one will be present
-    std::vector<int> floating;         // List of parts that provide buoyancy to boats
     std::set<std::string> tags;        // Properties of the vehicle
 
     active_item_cache active_items;
@@ -1216,6 +1216,9 @@ public:
 
     std::array<point, 2> pivot_anchor; // points used for rotation of mount precalc values
     std::array<int, 2> pivot_rotation = {{ 0, 0 }}; // rotation used for mount precalc values
+    // bounding box of the precalc values of all parts, min > max if there are none
+    std::array<point, 2> precalc_min = {{ point( 0, 0 ), point( 0, 0 ) }};
+    std::array<point, 2> precalc_max = {{ point( -1, -1 ), point( -1, -1 ) }};
 
     int last_turn = 0;      // amount of last turning (for calculate skidding due to handbrake)
     float of_turn;      // goes from ~1 to ~0 while proceeding every turn
@@ -1265,6 +1268,11 @@ private:
     mutable int mass_cache;
     mutable point mass_center_precalc;
     mutable point mass_center_no_precalc;
+
+    // Indices of the parts with each vpart_bitflags value, see parts_with_flag
+    std::array<std::vector<int>, NUM_VPFLAGS> flagged_parts;
+    // All vpart_bitflags of the parts on the same tile as each part, rebuilt by refresh
+    std::vector<std::bitset<NUM_VPFLAGS>> mount_flags;
 };
 
 #endif
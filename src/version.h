@@ -0,0 +1 @@
+#define VERSION "18d5d67-dirty"
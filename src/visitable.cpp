@@ -288,8 +288,9 @@ VisitResponse visitable<T>::visit_items(
 template <typename T>
 VisitResponse visitable<T>::visit_items( const std::function<VisitResponse( const item * )> &func ) const
 {
-    return const_cast<visitable<T> *>( this )->visit_items(
-               static_cast<const std::function<VisitResponse( item * )>&>( func ) );
+    return visit_items( [&func]( const item * it, const item * ) {
+        return func( it );
+    } );
 }
 
 template <typename T>
@@ -339,12 +340,10 @@ VisitResponse visitable<item>::visit_items(
     return visit_internal( func, it );
 }
 
-template <>
-VisitResponse visitable<inventory>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
+static VisitResponse visit_stacks( const std::function<VisitResponse( item *, item * )> &func,
+                                   invstack &stacks )
 {
-    auto inv = static_cast<inventory *>( this );
-    for( auto &stack : inv->items ) {
+    for( auto &stack : stacks ) {
         for( auto &it : stack ) {
             if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
                 return VisitResponse::ABORT;
@@ -354,6 +353,26 @@ VisitResponse visitable<inventory>::visit_items(
     return VisitResponse::NEXT;
 }
 
+template <>
+VisitResponse visitable<inventory>::visit_items(
+    const std::function<VisitResponse( item *, item * )> &func )
+{
+    auto inv = static_cast<inventory *>( this );
+    // The visitor may change the items, which can't be tracked.
+    inv->invalidate_aggregates();
+    return visit_stacks( func, inv->items );
+}
+
+template <>
+VisitResponse visitable<inventory>::visit_items(
+    const std::function<VisitResponse( const item *, const item * )> &func ) const
+{
+    // Same as the generic version, but keeps the cached weight and volume of the inventory.
+    auto inv = const_cast<inventory *>( static_cast<const inventory *>( this ) );
+    return visit_stacks( static_cast<const std::function<VisitResponse( item *, item * )>&>( func ),
+                         inv->items );
+}
+
 template <>
 VisitResponse visitable<Character>::visit_items(
     const std::function<VisitResponse( item *, item * )> &func )
@@ -374,6 +393,28 @@ VisitResponse visitable<Character>::visit_items(
     return ch->inv.visit_items( func );
 }
 
+template <>
+VisitResponse visitable<Character>::visit_items(
+    const std::function<VisitResponse( const item *, const item * )> &func ) const
+{
+    auto ch = static_cast<const Character *>( this );
+    const auto &mutable_func = static_cast<const std::function<VisitResponse( item *, item * )>&>
+                               ( func );
+
+    if( !ch->weapon.is_null() &&
+        visit_internal( mutable_func, const_cast<item *>( &ch->weapon ) ) == VisitResponse::ABORT ) {
+        return VisitResponse::ABORT;
+    }
+
+    for( auto &e : ch->worn ) {
+        if( visit_internal( mutable_func, const_cast<item *>( &e ) ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+    }
+
+    return ch->inv.visit_items( func );
+}
+
 template <>
 VisitResponse visitable<map_cursor>::visit_items(
     const std::function<VisitResponse( item *, item * )> &func )
@@ -493,6 +534,7 @@ std::list<item> visitable<inventory>::remove_items_with( const
         for( auto istack_iter = istack.begin(); istack_iter != istack.end() && count > 0; ) {
             if( filter( *istack_iter ) ) {
                 count--;
+                inv->count_in_aggregates( *istack_iter, -1 );
                 res.splice( res.end(), istack, istack_iter++ );
                 // The non-first items of a stack may have different invlets, the code
                 // in inventory only ever checks the invlet of the first item. This
@@ -503,7 +545,12 @@ std::list<item> visitable<inventory>::remove_items_with( const
                 }
 
             } else {
+                const int old_count = count;
                 remove_internal( filter, *istack_iter, count, res );
+                if( count != old_count ) {
+                    // Something was taken out of the item.
+                    inv->invalidate_aggregates();
+                }
                 ++istack_iter;
             }
         }
@@ -583,7 +630,8 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
     int x, y;
     submap *sub = g->m.get_submap_at( *cur, x, y );
 
-    for( auto iter = sub->itm[ x ][ y ].begin(); iter != sub->itm[ x ][ y ].end(); ) {
+    auto &items = sub->get_items( x, y );
+    for( auto iter = items.begin(); iter != items.end(); ) {
         if( filter( *iter ) ) {
             // check for presence in the active items cache
             if( sub->active_items.has( iter, point( x, y ) ) ) {
@@ -594,7 +642,7 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
             sub->update_lum_rem( *iter, x, y );
 
             // finally remove the item
-            res.splice( res.end(), sub->itm[ x ][ y ], iter++ );
+            res.splice( res.end(), items, iter++ );
 
             if( --count == 0 ) {
                 return res;
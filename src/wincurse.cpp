@@ -316,7 +316,7 @@ inline void FillRectDIB(int x, int y, int width, int height, unsigned char color
 void curses_drawwindow(WINDOW *win)
 {
     int i,j,drawx,drawy;
-    wchar_t tmp;
+    uint32_t tmp;
     RECT update = {win->x * fontwidth, -1,
                    (win->x + win->width) * fontwidth, -1};
 
@@ -333,7 +333,7 @@ void curses_drawwindow(WINDOW *win)
 
             for (i=0; i<win->width; i++){
                 const cursecell &cell = win->line[j].chars[i];
-                if( cell.ch.empty() ) {
+                if( cell.is_continuation() ) {
                     continue; // second cell of a multi-cell character
                 }
                 drawx=((win->x+i)*fontwidth);
@@ -342,14 +342,12 @@ void curses_drawwindow(WINDOW *win)
                     // Outside of the display area, would not render anyway
                     continue;
                 }
-                const char* utf8str = cell.ch.c_str();
-                int len = cell.ch.length();
-                tmp = UTF8_getch(&utf8str, &len);
+                tmp = cell.ch;
                 int FG = cell.FG;
                 int BG = cell.BG;
                 FillRectDIB(drawx,drawy,fontwidth,fontheight,BG);
 
-                if (tmp != UNKNOWN_UNICODE) {
+                if( !cell.is_line_drawing() ) {
 
                     int color = RGB(windowsPalette[FG].rgbRed,windowsPalette[FG].rgbGreen,windowsPalette[FG].rgbBlue);
                     SetTextColor(backbuffer,color);
@@ -360,11 +358,11 @@ void curses_drawwindow(WINDOW *win)
                         i += cw - 1;
                     }
                     if (tmp) {
-                        const std::wstring utf16 = widen(cell.ch);
+                        const std::wstring utf16 = widen(cell.to_string());
                         ExtTextOutW( backbuffer, drawx, drawy, 0, NULL, utf16.c_str(), utf16.length(), NULL );
                     }
                 } else {
-                    switch ((unsigned char)win->line[j].chars[i].ch[0]) {
+                    switch ((unsigned char)cell.ch) {
                     case LINE_OXOX_C://box bottom/top side (horizontal line)
                         HorzLineDIB(drawx,drawy+halfheight,drawx+fontwidth,1,FG);
                         break;
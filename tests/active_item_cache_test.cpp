@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include "active_item_cache.h"
+#include "calendar.h"
+
+#include <algorithm>
+#include <list>
+
+namespace
+{
+
+int count_of( const arena_vector<item_reference> &refs, std::list<item>::iterator it )
+{
+    return std::count_if( refs.begin(), refs.end(), [&]( const item_reference & ref ) {
+        return ref.item_iterator == it;
+    } );
+}
+
+} // namespace
+
+TEST_CASE( "active_item_cache_wakes_items_up_when_due" )
+{
+    calendar::turn = 1000;
+    std::list<item> items;
+    const auto cig = items.insert( items.end(), item( "cig_lit", calendar::turn ) );
+    const auto apple = items.insert( items.end(), item( "apple", calendar::turn ) );
+    REQUIRE( cig->needs_continuous_processing() );
+    REQUIRE_FALSE( apple->needs_continuous_processing() );
+    const int speed = apple->processing_speed();
+
+    active_item_cache cache;
+    CHECK( cache.empty() );
+    cache.add( cig, point( 1, 2 ) );
+    cache.add( apple, point( 3, 4 ) );
+    CHECK_FALSE( cache.empty() );
+    CHECK( cache.has( cig, point( 1, 2 ) ) );
+    CHECK( cache.has( apple, point( 3, 4 ) ) );
+
+    // The continuous item shows up every turn, the scheduled one once per period.
+    int first_wakeup = -1;
+    for( int turn = 1001; turn <= 1000 + speed; turn++ ) {
+        calendar::turn = turn;
+        const auto refs = cache.get( turn );
+        CHECK( count_of( refs, cig ) == 1 );
+        if( count_of( refs, apple ) != 0 ) {
+            CHECK( first_wakeup == -1 );
+            first_wakeup = turn;
+            // Processing removes the item and adds it back, which schedules the next wake-up.
+            cache.remove( apple, point( 3, 4 ) );
+            cache.add( apple, point( 3, 4 ) );
+        }
+    }
+    REQUIRE( first_wakeup != -1 );
+
+    for( int turn = 1001 + speed; turn <= first_wakeup + speed; turn++ ) {
+        calendar::turn = turn;
+        CHECK( count_of( cache.get( turn ), apple ) == ( turn == first_wakeup + speed ? 1 : 0 ) );
+    }
+
+    SECTION( "an item that is not processed when due is returned again" ) {
+        const int turn = first_wakeup + speed + 1;
+        calendar::turn = turn;
+        CHECK( count_of( cache.get( turn ), apple ) == 1 );
+    }
+
+    SECTION( "a cache that has not been processed for a long time" ) {
+        cache.remove( apple, point( 3, 4 ) );
+        cache.add( apple, point( 3, 4 ) );
+        const int turn = first_wakeup + 100 * speed;
+        calendar::turn = turn;
+        CHECK( count_of( cache.get( turn ), apple ) == 1 );
+        cache.remove( apple, point( 3, 4 ) );
+        cache.add( apple, point( 3, 4 ) );
+        CHECK( count_of( cache.get( turn + 1 ), apple ) == 0 );
+    }
+
+    SECTION( "removed items are not returned" ) {
+        cache.remove( apple, point( 3, 4 ) );
+        cache.remove( cig, point( 1, 2 ) );
+        CHECK( cache.empty() );
+        CHECK_FALSE( cache.has( apple, point( 3, 4 ) ) );
+        for( int turn = first_wakeup + speed + 1; turn <= first_wakeup + 3 * speed; turn++ ) {
+            REQUIRE( cache.get( turn ).empty() );
+        }
+    }
+}
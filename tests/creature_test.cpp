@@ -3,6 +3,7 @@
 #include "creature.h"
 #include "monster.h"
 #include "mtype.h"
+#include "rng.h"
 
 float expected_weights_base[][12] = {{20, 0,   0,   0, 15, 15, 0, 0, 25, 25, 0, 0},
                                 {33.33, 2.33, 0.33, 0, 20, 20, 0, 0, 12, 12, 0, 0},
@@ -42,7 +43,7 @@ TEST_CASE("Check distribution of attacks to body parts for same sized opponents.
     monster defender;
     defender.type = &smallmon;
 
-    srand(time(NULL));
+    rng_set_engine_seed( time( NULL ) );
 
     calculate_bodypart_distribution(attacker, defender, 0, expected_weights_base[1]);
     calculate_bodypart_distribution(attacker, defender, 1, expected_weights_base[1]);
@@ -59,7 +60,7 @@ TEST_CASE("Check distribution of attacks to body parts for smaller attacker.") {
     monster defender;
     defender.type = &medmon;
 
-    srand(time(NULL));
+    rng_set_engine_seed( time( NULL ) );
 
     calculate_bodypart_distribution(attacker, defender, 0, expected_weights_base[0]);
     calculate_bodypart_distribution(attacker, defender, 1, expected_weights_base[0]);
@@ -76,7 +77,7 @@ TEST_CASE("Check distribution of attacks to body parts for larger attacker.") {
     monster defender;
     defender.type = &smallmon;
 
-    srand(time(NULL));
+    rng_set_engine_seed( time( NULL ) );
 
     calculate_bodypart_distribution(attacker, defender, 0, expected_weights_base[2]);
     calculate_bodypart_distribution(attacker, defender, 1, expected_weights_base[2]);
@@ -0,0 +1,78 @@
+#include "catch/catch.hpp"
+
+#include "effect.h"
+#include "bodypart.h"
+
+TEST_CASE( "effect_list" )
+{
+    static const efftype_id effect_bite( "bite" );
+    static const efftype_id effect_bleed( "bleed" );
+    static const efftype_id effect_downed( "downed" );
+
+    effect_list effects;
+    CHECK( effects.empty() );
+    CHECK_FALSE( effects.has( effect_bite ) );
+    CHECK( effects.find( effect_bite, bp_arm_l ) == nullptr );
+
+    effects.set( effect( &effect_bite.obj(), 100, bp_arm_l, false, 1, 0 ) );
+    effects.set( effect( &effect_bite.obj(), 200, bp_leg_r, false, 1, 0 ) );
+    effects.set( effect( &effect_downed.obj(), 3, num_bp, false, 1, 0 ) );
+
+    GIVEN( "effects on several body parts" ) {
+        CHECK( effects.size() == 3 );
+        CHECK( effects.has( effect_bite ) );
+        CHECK( effects.has( effect_downed ) );
+        CHECK_FALSE( effects.has( effect_bleed ) );
+        REQUIRE( effects.find( effect_bite, bp_leg_r ) != nullptr );
+        CHECK( effects.find( effect_bite, bp_leg_r )->get_duration() == 200 );
+        CHECK( effects.find( effect_bite, bp_arm_r ) == nullptr );
+        CHECK( effects.find( effect_downed, num_bp ) != nullptr );
+    }
+
+    GIVEN( "an effect that is set again" ) {
+        effects.set( effect( &effect_bite.obj(), 50, bp_arm_l, false, 1, 0 ) );
+        CHECK( effects.size() == 3 );
+        CHECK( effects.find( effect_bite, bp_arm_l )->get_duration() == 50 );
+    }
+
+    GIVEN( "removing a single body part" ) {
+        CHECK( effects.erase( effect_bite, bp_arm_l ) );
+        CHECK_FALSE( effects.erase( effect_bite, bp_arm_l ) );
+        CHECK( effects.has( effect_bite ) );
+        CHECK( effects.find( effect_bite, bp_arm_l ) == nullptr );
+    }
+
+    GIVEN( "removing all body parts" ) {
+        CHECK( effects.erase( effect_bite ) );
+        CHECK_FALSE( effects.has( effect_bite ) );
+        CHECK( effects.has( effect_downed ) );
+        CHECK( effects.size() == 1 );
+    }
+
+    GIVEN( "a copy" ) {
+        effect_list copy = effects;
+        copy.erase( effect_downed );
+        CHECK( effects.has( effect_downed ) );
+        CHECK_FALSE( copy.has( effect_downed ) );
+        CHECK( copy.size() == 2 );
+    }
+
+    GIVEN( "effects changed while iterating" ) {
+        int visited = 0;
+        effects.for_each_safe( [&]( effect & e ) {
+            visited++;
+            if( visited == 1 ) {
+                const efftype_id id = e.get_id();
+                const body_part bp = e.get_bp();
+                // Removes this effect and the ones not visited yet, e must stay usable.
+                effects.clear();
+                effects.set( effect( &effect_bleed.obj(), 10, bp_torso, false, 1, 0 ) );
+                CHECK( e.get_id() == id );
+                CHECK( e.get_bp() == bp );
+            }
+        } );
+        CHECK( visited == 1 );
+        CHECK( effects.size() == 1 );
+        CHECK( effects.has( effect_bleed ) );
+    }
+}
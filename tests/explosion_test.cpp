@@ -0,0 +1,104 @@
+#include "catch/catch.hpp"
+
+#include "creature_tracker.h"
+#include "explosion.h"
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "mtype.h"
+#include "player.h"
+#include "rng.h"
+
+#include <algorithm>
+#include <vector>
+
+static void clear_map()
+{
+    const int mapsize = g->m.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            g->m.set( x, y, t_grass, f_null );
+            g->m.i_clear( tripoint( x, y, 0 ) );
+        }
+    }
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+    // Keep the player out of the blast.
+    g->u.setpos( { 0, 0, -2 } );
+}
+
+static int spawn_zombie( const tripoint &pos )
+{
+    monster zombie( mtype_id( "mon_zombie" ), pos );
+    g->critter_tracker->add( zombie );
+    return g->num_zombies() - 1;
+}
+
+static bool was_hurt( int index )
+{
+    const monster &critter = g->zombie( index );
+    return critter.is_dead_state() || critter.get_hp() < critter.get_hp_max();
+}
+
+TEST_CASE( "explosions_reach_open_tiles_only" )
+{
+    clear_map();
+    const tripoint center( 60, 60, 0 );
+    const tripoint close_by = center + tripoint( 2, 0, 0 );
+    const tripoint far_away = center + tripoint( 0, 16, 0 );
+    // Too strong for the blast to break through.
+    const tripoint walled_in = center + tripoint( -2, -2, 0 );
+    for( int x = -1; x <= 1; x++ ) {
+        for( int y = -1; y <= 1; y++ ) {
+            if( x != 0 || y != 0 ) {
+                g->m.ter_set( walled_in + tripoint( x, y, 0 ), t_rock );
+            }
+        }
+    }
+    const int close_by_zombie = spawn_zombie( close_by );
+    const int far_away_zombie = spawn_zombie( far_away );
+    const int walled_in_zombie = spawn_zombie( walled_in );
+
+    explosion_data blast;
+    blast.power = 20;
+    REQUIRE( blast.expected_range( 1.0f / blast.power ) < 16 );
+    g->explosion( center, blast );
+
+    CHECK( was_hurt( close_by_zombie ) );
+    CHECK_FALSE( was_hurt( far_away_zombie ) );
+    CHECK_FALSE( was_hurt( walled_in_zombie ) );
+    CHECK( g->m.ter( walled_in + tripoint( 1, 1, 0 ) ) == t_rock );
+}
+
+TEST_CASE( "explosions_are_repeatable" )
+{
+    explosion_data blast;
+    blast.power = 200;
+    const tripoint center( 60, 60, 0 );
+    const auto blast_walls = [&]() {
+        clear_map();
+        for( int x = 40; x < 80; x += 3 ) {
+            g->m.ter_set( x, 57, t_wall );
+            g->m.ter_set( 63, x, t_wall );
+        }
+        g->explosion( center, blast );
+
+        std::vector<ter_id> result;
+        for( int x = 30; x < 90; x++ ) {
+            for( int y = 30; y < 90; y++ ) {
+                result.push_back( g->m.ter( x, y ) );
+            }
+        }
+        return result;
+    };
+
+    rng_set_engine_seed( 17 );
+    const std::vector<ter_id> first = blast_walls();
+    rng_set_engine_seed( 17 );
+    const std::vector<ter_id> second = blast_walls();
+    CHECK( first == second );
+    // Some walls were close enough to be destroyed.
+    CHECK( std::count( first.begin(), first.end(), t_wall ) < 27 );
+}
@@ -0,0 +1,61 @@
+#include "catch/catch.hpp"
+
+#include "inventory.h"
+#include "item.h"
+#include "visitable.h"
+
+static int sum_weight( const inventory &inv )
+{
+    int weight = 0;
+    for( const auto &stack : inv.const_slice() ) {
+        for( const auto &it : *stack ) {
+            weight += it.weight();
+        }
+    }
+    return weight;
+}
+
+TEST_CASE( "inventory_cached_weight_and_volume" )
+{
+    inventory inv;
+    CHECK( inv.weight() == 0 );
+    CHECK( inv.volume() == units::volume( 0 ) );
+
+    inv.add_item( item( "rock" ) );
+    inv.add_item( item( "rock" ) );
+    inv.add_item( item( "bottle_plastic" ) );
+    inv.add_item( item( "battery", 0, 50 ) );
+    // Merges the charges into the existing stack.
+    inv.add_item( item( "battery", 0, 25 ) );
+    CHECK( inv.verify_aggregates() );
+    CHECK( inv.weight() == sum_weight( inv ) );
+
+    SECTION( "removing items" ) {
+        inv.remove_items_with( []( const item & it ) {
+            return it.typeId() == "rock";
+        }, 1 );
+        CHECK( inv.amount_of( "rock" ) == 1 );
+        CHECK( inv.verify_aggregates() );
+        inv.reduce_stack( itype_id( "bottle_plastic" ), -1 );
+        CHECK( inv.verify_aggregates() );
+        CHECK( inv.weight() == sum_weight( inv ) );
+    }
+
+    SECTION( "changing an item" ) {
+        item &bottle = inv.item_by_type( "bottle_plastic" );
+        bottle.contents.push_back( item( "water", 0, 2 ) );
+        CHECK( inv.verify_aggregates() );
+        CHECK( inv.weight() == sum_weight( inv ) );
+    }
+
+    SECTION( "const access keeps the cache" ) {
+        const inventory &const_inv = inv;
+        const int weight = const_inv.weight();
+        CHECK( const_inv.amount_of( "rock" ) == 2 );
+        CHECK( const_inv.weight() == weight );
+        CHECK( const_inv.verify_aggregates() );
+    }
+
+    inv.clear();
+    CHECK( inv.weight() == 0 );
+}
@@ -0,0 +1,67 @@
+#include "catch/catch.hpp"
+
+#include "json.h"
+
+#include <sstream>
+#include <string>
+
+TEST_CASE( "json_object_members" )
+{
+    const std::string text =
+        R"({ "id": "thing", "name": "with \"quotes\"\n", "count": 12, "ratio": -1.5e1,)"
+        R"( "//": "one", "//": "two", "flags": [ "A", "B" ], "sub": { "x": true } })";
+    JsonIn jsin( text );
+    JsonObject jo = jsin.get_object();
+
+    CHECK( jo.size() == 7 );
+    CHECK( jo.get_string( "id" ) == "thing" );
+    CHECK( jo.get_string( "name" ) == "with \"quotes\"\n" );
+    CHECK( jo.get_int( "count" ) == 12 );
+    CHECK( jo.get_float( "ratio" ) == Approx( -15.0 ) );
+    CHECK( jo.get_string( "//" ) == "two" );
+    CHECK( jo.get_int( "missing", 3 ) == 3 );
+    CHECK_FALSE( jo.has_member( "missing" ) );
+    CHECK( jo.get_member_names().count( "name" ) == 1 );
+    CHECK( jo.get_tags( "flags" ).size() == 2 );
+    CHECK( jo.get_object( "sub" ).get_bool( "x" ) );
+    CHECK_THROWS_AS( jo.get_int( "missing" ), JsonError );
+}
+
+TEST_CASE( "json_errors" )
+{
+    const std::string duplicate = "{ \"a\": 1,\n  \"a\": 2 }";
+    JsonIn dup_in( duplicate );
+    CHECK_THROWS_AS( dup_in.get_object(), JsonError );
+
+    const std::string unclosed = "[ \"text ]";
+    JsonIn unclosed_in( unclosed );
+    unclosed_in.start_array();
+    CHECK_THROWS_AS( unclosed_in.get_string(), JsonError );
+
+    const std::string bad_separator = "{\n  \"a\": 1\n  \"b\": 2\n}";
+    JsonIn bad_in( bad_separator );
+    try {
+        bad_in.get_object();
+        FAIL( "missing separator not detected" );
+    } catch( const JsonError &err ) {
+        CHECK( std::string( err.what() ).find( "line 2" ) == 0 );
+    }
+}
+
+TEST_CASE( "json_stream_positions" )
+{
+    // Positions count from the start of the stream, even if it was partially read before.
+    std::istringstream stream( "# header\n{ \"a\": [ 1, 2 ] }, rest" );
+    std::string header;
+    std::getline( stream, header );
+    {
+        JsonIn jsin( stream );
+        CHECK( jsin.tell() == 9 );
+        JsonObject jo = jsin.get_object();
+        CHECK( jo.get_int_array( "a" ).size() == 2 );
+    }
+    // The stream continues where parsing ended.
+    std::string rest;
+    stream >> rest;
+    CHECK( rest == "rest" );
+}
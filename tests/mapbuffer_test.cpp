@@ -0,0 +1,98 @@
+#include "catch/catch.hpp"
+
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "submap.h"
+
+namespace
+{
+
+size_t buffered_submaps()
+{
+    size_t count = 0;
+    for( auto &elem : MAPBUFFER ) {
+        ( void )elem;
+        count++;
+    }
+    return count;
+}
+
+bool is_buffered( const tripoint &p )
+{
+    for( auto &elem : MAPBUFFER ) {
+        if( elem.first == p ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE( "mapbuffer_trim_saves_least_recently_used_quads" )
+{
+    // Quad aligned submap positions far outside of the reality bubble
+    const tripoint origin = omt_to_sm_copy( sm_to_omt_copy( g->m.get_abs_sub() ) );
+    const tripoint old_quad( origin.x + 40, origin.y, 0 );
+    const tripoint new_quad( origin.x + 60, origin.y, 0 );
+    const tripoint sign_pos( 3, 4, 0 );
+
+    calendar::turn = calendar::turn + 1;
+    tinymap tm;
+    tm.load( old_quad.x, old_quad.y, old_quad.z, false );
+    tm.set_graffiti( sign_pos, "kept on disk" );
+    const ter_id old_ter = tm.ter( sign_pos );
+
+    calendar::turn = calendar::turn + 1;
+    tm.load( new_quad.x, new_quad.y, new_quad.z, false );
+    REQUIRE( is_buffered( old_quad ) );
+    REQUIRE( is_buffered( new_quad ) );
+
+    const size_t before = buffered_submaps();
+    MAPBUFFER.trim( before - 1 );
+    CHECK( buffered_submaps() < before );
+    CHECK_FALSE( is_buffered( old_quad ) );
+    // The main map is never freed.
+    CHECK( is_buffered( g->m.get_abs_sub() ) );
+
+    // The freed quad is loaded again from disk.
+    const submap *const reloaded = MAPBUFFER.lookup_submap( old_quad );
+    REQUIRE( reloaded != nullptr );
+    CHECK( reloaded->get_graffiti( sign_pos.x, sign_pos.y ) == "kept on disk" );
+    CHECK( reloaded->get_ter( sign_pos.x, sign_pos.y ) == old_ter );
+
+    MAPBUFFER.trim( 0 );
+    CHECK( is_buffered( old_quad ) );
+}
+
+TEST_CASE( "mapbuffer_submaps_are_only_dirty_when_modified" )
+{
+    const tripoint origin = omt_to_sm_copy( sm_to_omt_copy( g->m.get_abs_sub() ) );
+    const tripoint quad( origin.x + 80, origin.y, 0 );
+    const tripoint pos( 5, 5, 0 );
+
+    tinymap tm;
+    tm.load( quad.x, quad.y, quad.z, false );
+    tm.set_graffiti( pos, "saved" );
+    CHECK( MAPBUFFER.lookup_submap( quad )->dirty );
+
+    // Saves and frees everything outside of the reality bubble.
+    MAPBUFFER.trim( 1 );
+    REQUIRE_FALSE( is_buffered( quad ) );
+
+    // Loading it again (without a map updating it for the time that passed) modifies nothing.
+    submap *const sm = MAPBUFFER.lookup_submap( quad );
+    REQUIRE( sm != nullptr );
+    CHECK_FALSE( sm->dirty );
+    CHECK( static_cast<const submap *>( sm )->get_graffiti( pos.x, pos.y ) == "saved" );
+    CHECK( static_cast<const submap *>( sm )->get_items( pos.x, pos.y ).empty() ==
+           !sm->has_items( pos.x, pos.y ) );
+    CHECK_FALSE( sm->dirty );
+
+    sm->set_ter( pos.x, pos.y, sm->get_ter( pos.x, pos.y ) == t_dirt ? t_grass : t_dirt );
+    CHECK( sm->dirty );
+}
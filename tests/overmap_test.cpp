@@ -1,6 +1,8 @@
 #include "catch/catch.hpp"
 
 #include "overmap.h"
+#include "overmapbuffer.h"
+#include "rng.h"
 
 TEST_CASE( "set_and_get_overmap_scents" ) {
     overmap test_overmap;
@@ -19,3 +21,66 @@ TEST_CASE( "set_and_get_overmap_scents" ) {
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).creation_turn == 50 );
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
+
+TEST_CASE( "overmap_generation_is_deterministic" ) {
+    overmap first( 100, 100 );
+    // Whatever the game did with the random numbers before must not matter.
+    for( int i = 0; i < 100; ++i ) {
+        rng_bits();
+    }
+    overmap second( 100, 100 );
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                REQUIRE( first.get_ter( x, y, z ) == second.get_ter( x, y, z ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "overmaps_are_prepared_near_the_edge" ) {
+    const tripoint near_west_edge( 200 * OMAPX + 2, 200 * OMAPY + OMAPY / 2, 0 );
+    REQUIRE_FALSE( overmap_buffer.has( 199, 200 ) );
+    CHECK( overmap_buffer.prepare_adjacent( near_west_edge, 8 ) );
+    CHECK( overmap_buffer.has( 199, 200 ) );
+    // Nothing else is needed there.
+    CHECK_FALSE( overmap_buffer.prepare_adjacent( near_west_edge, 8 ) );
+
+    const tripoint center( 300 * OMAPX + OMAPX / 2, 300 * OMAPY + OMAPY / 2, 0 );
+    CHECK_FALSE( overmap_buffer.prepare_adjacent( center, 8 ) );
+}
+
+TEST_CASE( "find_closest_uses_the_current_terrain" ) {
+    const tripoint origin( 400 * OMAPX + 2, 400 * OMAPY + OMAPY / 2, 0 );
+    // Clear a square that reaches into the overmap to the west.
+    for( int x = -10; x <= 10; ++x ) {
+        for( int y = -10; y <= 10; ++y ) {
+            overmap_buffer.ter( origin + tripoint( x, y, 0 ) ) = oter_id( "field" );
+        }
+    }
+    CHECK( overmap_buffer.find_closest( origin, "cabin", 10, false ) == overmap::invalid_tripoint );
+    CHECK( overmap_buffer.find_all( origin, "cabin", 10, false ).empty() );
+
+    // Changes after the previous search are found.
+    overmap_buffer.ter( origin + tripoint( -7, 2, 0 ) ) = oter_id( "cabin" );
+    overmap_buffer.ter( origin + tripoint( 4, -4, 0 ) ) = oter_id( "cabin" );
+    overmap_buffer.ter( origin + tripoint( 0, 9, 0 ) ) = oter_id( "cabin" );
+    CHECK( overmap_buffer.find_closest( origin, "cabin", 10, false ) == origin + tripoint( 4, -4, 0 ) );
+    CHECK( overmap_buffer.find_closest( origin, "cabin", 3, false ) == overmap::invalid_tripoint );
+
+    const std::vector<tripoint> nearest = overmap_buffer.find_closest( origin, "cabin", 10, false, 2 );
+    REQUIRE( nearest.size() == 2 );
+    CHECK( nearest[0] == origin + tripoint( 4, -4, 0 ) );
+    CHECK( nearest[1] == origin + tripoint( -7, 2, 0 ) );
+
+    const std::vector<tripoint> all = overmap_buffer.find_all( origin, "cabin", 10, false );
+    REQUIRE( all.size() == 3 );
+    CHECK( all[0] == origin + tripoint( -7, 2, 0 ) );
+    CHECK( overmap_buffer.find_all( origin, "cabin", 10, true ).empty() );
+
+    // Types match terrain that has them as prefix.
+    overmap_buffer.ter( origin + tripoint( 1, 1, 0 ) ) = oter_id( "cabin_strange" );
+    CHECK( overmap_buffer.find_closest( origin, "cabin", 10, false, 0 ).size() == 4 );
+    CHECK( overmap_buffer.find_closest( origin, "cabin_strange", 10, false ) == origin + tripoint( 1, 1, 0 ) );
+}
@@ -132,3 +132,31 @@ TEST_CASE("Player body temperatures converge on expected values.", "[!mayfail]")
         test_temperature_spread( &dummy, {{ -115, -87, -54, -6, 36, 64, 80 }} );
     }
 }
+
+TEST_CASE( "player_trait_bits" )
+{
+    static const trait_id trait_FLEET( "FLEET" );
+    static const trait_id trait_LIGHTEATER( "LIGHTEATER" );
+
+    player dummy;
+    CHECK_FALSE( dummy.has_trait( trait_FLEET ) );
+
+    dummy.set_mutation( "FLEET" );
+    CHECK( dummy.has_trait( "FLEET" ) );
+    CHECK( dummy.has_trait( trait_FLEET ) );
+    CHECK_FALSE( dummy.has_base_trait( trait_FLEET ) );
+    CHECK_FALSE( dummy.has_trait( trait_LIGHTEATER ) );
+
+    dummy.toggle_trait( "LIGHTEATER" );
+    CHECK( dummy.has_trait( trait_LIGHTEATER ) );
+    CHECK( dummy.has_base_trait( "LIGHTEATER" ) );
+
+    const player copy = dummy;
+    dummy.unset_mutation( "FLEET" );
+    CHECK_FALSE( dummy.has_trait( trait_FLEET ) );
+    CHECK( copy.has_trait( trait_FLEET ) );
+
+    dummy.empty_traits();
+    CHECK_FALSE( dummy.has_trait( trait_LIGHTEATER ) );
+    CHECK_FALSE( dummy.has_base_trait( trait_LIGHTEATER ) );
+}
@@ -0,0 +1,51 @@
+#include "catch/catch.hpp"
+
+#include "filesystem.h"
+#include "input.h"
+#include "replay.h"
+
+#include <fstream>
+#include <string>
+
+TEST_CASE( "replay_reads_recorded_events" )
+{
+    const std::string path = "replay_test_recording";
+    {
+        std::ofstream fout( path.c_str(), std::ios::binary );
+        fout << R"({"world":"Test","save":"VGVzdA==","rng_state":"00000001 00000002 00000003 00000004",)"
+             << R"("turn":100,"width":80,"height":24})" << "\n"
+             << R"({"event":[2,104,0,0,[104],[],"h"]})" << "\n"
+             << R"({"turn":101,"state":"1 2 0 3 00000001 00000002 00000003 00000004"})" << "\n"
+             << R"({"event":[4,0,12,5,[1],[],""]})" << "\n";
+    }
+    REQUIRE( replay::load( path ) );
+    remove_file( path );
+
+    const replay::header &hdr = replay::loaded_header();
+    CHECK( hdr.world == "Test" );
+    CHECK( hdr.save == "VGVzdA==" );
+    CHECK( hdr.turn == 100 );
+    CHECK( hdr.width == 80 );
+    CHECK( hdr.height == 24 );
+
+    input_event evt;
+    long pressed_key = 0;
+    REQUIRE_FALSE( replay::next_input_event( evt, pressed_key ) );
+
+    replay::start_playing( 1 );
+    REQUIRE( replay::playing() );
+    REQUIRE( replay::next_input_event( evt, pressed_key ) );
+    CHECK( evt == input_event( 'h', CATA_INPUT_KEYBOARD ) );
+    CHECK( evt.text == "h" );
+    CHECK( pressed_key == 'h' );
+
+    REQUIRE( replay::next_input_event( evt, pressed_key ) );
+    CHECK( evt == input_event( MOUSE_BUTTON_LEFT, CATA_INPUT_MOUSE ) );
+    CHECK( evt.mouse_x == 12 );
+    CHECK( evt.mouse_y == 5 );
+    CHECK( replay::events_played() == 2 );
+
+    CHECK_THROWS_AS( replay::next_input_event( evt, pressed_key ), replay::end_of_recording );
+    replay::stop_playing();
+    CHECK_FALSE( replay::playing() );
+}
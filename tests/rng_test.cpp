@@ -0,0 +1,79 @@
+#include "catch/catch.hpp"
+
+#include "rng.h"
+
+#include <vector>
+
+TEST_CASE( "rng_engine_sequences" )
+{
+    rng_engine first( 42 );
+    rng_engine second( 42 );
+    for( int i = 0; i < 100; ++i ) {
+        REQUIRE( first() == second() );
+    }
+
+    // Other streams of the same seed are unrelated.
+    rng_engine other_stream( 42, 1 );
+    int equal = 0;
+    for( int i = 0; i < 100; ++i ) {
+        equal += first() == other_stream() ? 1 : 0;
+    }
+    CHECK( equal < 5 );
+
+    // Deriving a stream does not advance the generator.
+    const rng_engine before = first;
+    rng_engine derived = first.derive( 7 );
+    CHECK( first == before );
+    CHECK( first.derive( 7 ) == derived );
+    CHECK_FALSE( first.derive( 8 ) == derived );
+
+    first.seed( 42 );
+    second.seed( 42 );
+    CHECK( first == second );
+}
+
+TEST_CASE( "rng_engine_state_is_saved" )
+{
+    rng_engine engine( 1234 );
+    engine();
+    const std::string saved = engine.serialize();
+    std::vector<unsigned int> expected;
+    for( int i = 0; i < 10; ++i ) {
+        expected.push_back( engine() );
+    }
+
+    rng_engine restored;
+    REQUIRE( restored.deserialize( saved ) );
+    for( const unsigned int value : expected ) {
+        CHECK( restored() == value );
+    }
+
+    CHECK_FALSE( restored.deserialize( "not a state" ) );
+    CHECK_FALSE( restored.deserialize( "00000000 00000000 00000000 00000000" ) );
+}
+
+TEST_CASE( "rng_ranges" )
+{
+    rng_set_engine_seed( 5 );
+    std::vector<int> counts( 6 );
+    for( int i = 0; i < 6000; ++i ) {
+        const long value = rng( -2, 3 );
+        REQUIRE( value >= -2 );
+        REQUIRE( value <= 3 );
+        counts[value + 2]++;
+        const double real = rng_float( 1.5, 2.5 );
+        REQUIRE( real >= 1.5 );
+        REQUIRE( real < 2.5 );
+    }
+    for( const int count : counts ) {
+        CHECK( count > 800 );
+        CHECK( count < 1200 );
+    }
+
+    std::vector<long> filled( 1000, -1 );
+    rng_get_engine().fill( filled.begin(), filled.end(), 10, 12 );
+    for( const long value : filled ) {
+        REQUIRE( value >= 10 );
+        REQUIRE( value <= 12 );
+    }
+}
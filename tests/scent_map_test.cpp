@@ -0,0 +1,101 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "scent_map.h"
+
+#include <array>
+
+namespace
+{
+
+using full_scent_array = std::array<std::array<int, SEEY *MAPSIZE>, SEEX *MAPSIZE>;
+
+class test_scent_map : public scent_map
+{
+    public:
+        test_scent_map() : scent_map( *g ) {}
+
+        const full_scent_array &values() const {
+            return grscent;
+        }
+};
+
+// The diffusion over the whole square around the center that scent_map::update did before it
+// learned to skip empty areas.
+void reference_update( full_scent_array &grscent, const tripoint &center, map &m )
+{
+    const int radius = 40;
+    const int diffusivity = 100;
+    full_scent_array sum_3_scent_y;
+    full_scent_array squares_used_y;
+    std::array<std::array<bool, SEEY *MAPSIZE>, SEEX *MAPSIZE> blocks_scent;
+    std::array<std::array<bool, SEEY *MAPSIZE>, SEEX *MAPSIZE> reduces_scent;
+
+    const int minx = center.x - radius;
+    const int maxx = center.x + radius;
+    const int miny = center.y - radius;
+    const int maxy = center.y + radius;
+    m.scent_blockers( blocks_scent, reduces_scent, minx - 1, miny - 1, maxx + 1, maxy + 1 );
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    const int weight = reduces_scent[x][i] ? 2 : 10;
+                    sum_3_scent_y[y][x] += weight * grscent[x][i];
+                    squares_used_y[y][x] += weight;
+                }
+            }
+        }
+    }
+    for( int x = minx; x <= maxx; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            int &scent_here = grscent[x][y];
+            if( blocks_scent[x][y] ) {
+                scent_here = 0;
+                continue;
+            }
+            const int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] +
+                                     squares_used_y[y][x + 1];
+            const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            scent_here = ( temp_scent + this_diffusivity * ( sum_3_scent_y[y][x - 1] +
+                           sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1] ) ) / ( 1000 * 10 );
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE( "scent_map_diffusion_matches_full_update" )
+{
+    test_scent_map scent;
+    full_scent_array expected;
+    for( auto &col : expected ) {
+        col.fill( 0 );
+    }
+
+    const tripoint start( SEEX * MAPSIZE / 2, SEEY * MAPSIZE / 2, g->get_levz() );
+    for( int turn = 0; turn < 60; turn++ ) {
+        // Wander around, and sometimes far enough to leave scent outside of the updated square.
+        const tripoint pos = start + tripoint( ( turn % 7 ) * ( turn < 30 ? 1 : -2 ), turn % 5 - 2, 0 );
+        scent.set( pos, 500 );
+        expected[pos.x][pos.y] = 500;
+        if( turn % 10 == 3 ) {
+            scent.decay();
+            scent.decay();
+            for( auto &col : expected ) {
+                for( auto &val : col ) {
+                    val = std::max( 0, val - 2 );
+                }
+            }
+            CHECK( scent.get( pos ) == 498 );
+        }
+        scent.update( pos, g->m );
+        reference_update( expected, pos, g->m );
+        REQUIRE( scent.values() == expected );
+    }
+}
@@ -0,0 +1,61 @@
+#include "catch/catch.hpp"
+
+#include "submap.h"
+#include "trap.h"
+
+TEST_CASE( "submap_item_lists" )
+{
+    submap sm;
+    CHECK_FALSE( sm.has_items( 3, 4 ) );
+    CHECK( static_cast<const submap &>( sm ).get_items( 3, 4 ).empty() );
+    CHECK( sm.get_item_tiles().empty() );
+
+    sm.get_items( 3, 4 ).push_back( item( "rock" ) );
+    sm.get_items( 5, 6 ).push_back( item( "rock" ) );
+    sm.get_items( 5, 6 ).push_back( item( "apple" ) );
+    CHECK( sm.has_items( 3, 4 ) );
+    CHECK( sm.get_items( 5, 6 ).size() == 2 );
+    CHECK( sm.get_item_tiles().size() == 2 );
+
+    // Emptied lists stay until compacted, so references to them remain valid.
+    const item *apple = &sm.get_items( 5, 6 ).back();
+    std::list<item> &emptied = sm.get_items( 3, 4 );
+    emptied.clear();
+    CHECK_FALSE( sm.has_items( 3, 4 ) );
+    CHECK( &sm.get_items( 3, 4 ) == &emptied );
+
+    sm.compact_items();
+    CHECK( sm.get_item_tiles().size() == 1 );
+    CHECK( sm.get_item_tiles().front().pos == point( 5, 6 ) );
+    CHECK( &sm.get_items( 5, 6 ).back() == apple );
+    CHECK_FALSE( sm.has_items( 3, 4 ) );
+}
+
+TEST_CASE( "submap_sparse_layers" )
+{
+    submap sm;
+    CHECK_FALSE( sm.fld.allocated() );
+    CHECK( sm.get_trap( 1, 2 ) == tr_null );
+    CHECK( sm.get_radiation( 1, 2 ) == 0 );
+    CHECK( sm.get_graffiti( 1, 2 ).empty() );
+    CHECK( sm.fld.get( 1, 2 ).fieldCount() == 0 );
+
+    // Setting default values doesn't allocate anything.
+    sm.set_radiation( 1, 2, 0 );
+    sm.delete_graffiti( 1, 2 );
+    CHECK_FALSE( sm.rad.allocated() );
+    CHECK_FALSE( sm.cosmetics.allocated() );
+
+    sm.set_radiation( 1, 2, 5 );
+    sm.set_graffiti( 3, 4, "hello" );
+    CHECK( sm.get_radiation( 1, 2 ) == 5 );
+    CHECK( sm.get_radiation( 2, 1 ) == 0 );
+    CHECK( sm.get_graffiti( 3, 4 ) == "hello" );
+    CHECK_FALSE( sm.has_graffiti( 4, 3 ) );
+
+    sm.set_radiation( 1, 2, 0 );
+    sm.compact_layers();
+    CHECK_FALSE( sm.rad.allocated() );
+    CHECK( sm.cosmetics.allocated() );
+    CHECK( sm.get_graffiti( 3, 4 ) == "hello" );
+}
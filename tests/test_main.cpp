@@ -8,6 +8,7 @@
 #include "morale.h"
 #include "path_info.h"
 #include "player.h"
+#include "rng.h"
 #include "worldfactory.h"
 #include "debug.h"
 #include "mod_manager.h"
@@ -144,6 +145,10 @@ int main( int argc, const char *argv[] )
         return EXIT_FAILURE;
     }
 
+    // The game's random numbers follow Catch's --rng-seed, so a failing run can be repeated.
+    const unsigned int seed = session.configData().rngSeed;
+    rng_set_engine_seed( seed != 0 ? seed : 5 );
+
     result = session.run();
 
     auto world_name = world_generator->active_world->world_name;
@@ -0,0 +1,46 @@
+#include "catch/catch.hpp"
+
+#include "turn_arena.h"
+
+#include <algorithm>
+#include <numeric>
+
+TEST_CASE( "turn_arena_reuses_memory_once_everything_is_freed" )
+{
+    const int *first_data = nullptr;
+    {
+        arena_vector<int> numbers( 100 );
+        std::iota( numbers.begin(), numbers.end(), 0 );
+        arena_vector<arena_vector<int>> nested( 3, numbers );
+        first_data = numbers.data();
+        for( const auto &copy : nested ) {
+            CHECK( copy == numbers );
+            CHECK( copy.data() != numbers.data() );
+        }
+        numbers.resize( 10000 );
+        CHECK( numbers[99] == 99 );
+    }
+    arena_vector<int> again( 100 );
+    CHECK( again.data() == first_data );
+}
+
+TEST_CASE( "turn_arena_counts_allocations_per_turn" )
+{
+    turn_arena::end_turn();
+    turn_arena::reset_stats();
+    {
+        arena_vector<char> small( 10 );
+        // Too large for the arena, served by the heap
+        arena_vector<char> huge( 65 * 1024 * 1024, 'x' );
+        CHECK( std::count( huge.begin(), huge.end(), 'x' ) == long( huge.size() ) );
+    }
+    CHECK( turn_arena::get_stats().turn_allocations == 2 );
+    turn_arena::end_turn();
+
+    const turn_arena::arena_stats &stats = turn_arena::get_stats();
+    CHECK( stats.turns == 1 );
+    CHECK( stats.allocations == 2 );
+    CHECK( stats.max_turn_allocations == 2 );
+    CHECK( stats.heap_allocations == 1 );
+    CHECK( stats.turn_allocations == 0 );
+}
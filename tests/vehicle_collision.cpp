@@ -0,0 +1,96 @@
+#include "catch/catch.hpp"
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "mtype.h"
+#include "player.h"
+#include "vehicle.h"
+#include "veh_type.h"
+
+#include <vector>
+
+static void clear_vehicles_and_monsters()
+{
+    for( auto &v : g->m.get_vehicles() ) {
+        g->m.destroy_vehicle( v.v );
+    }
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+    g->u.setpos( { 0, 0, 0 } );
+}
+
+/** Collisions of the vehicle when moved one tile east without turning, like map::move_vehicle */
+static std::vector<veh_collision> collisions_moving_east( vehicle &veh )
+{
+    veh.precalc_mounts( 1, veh.face.dir(), veh.pivot_point() );
+    const point pivot = veh.pivot_displacement();
+    std::vector<veh_collision> colls;
+    veh.collision( colls, tripoint( 1 - pivot.x, -pivot.y, 0 ), true );
+    return colls;
+}
+
+TEST_CASE( "vehicle_collision_candidates", "[vehicle]" )
+{
+    clear_vehicles_and_monsters();
+    const tripoint start( 60, 60, 0 );
+    for( const tripoint &p : g->m.points_in_radius( start, 15 ) ) {
+        g->m.set( p, t_pavement, f_null );
+    }
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), start, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    const tripoint pos = veh->global_pos3();
+    const int length = veh->precalc_max[0].x - veh->precalc_min[0].x + 1;
+
+    SECTION( "nothing in the way" ) {
+        CHECK( collisions_moving_east( *veh ).empty() );
+    }
+
+    SECTION( "vehicle in front" ) {
+        vehicle *other = g->m.add_vehicle( vproto_id( "car" ), pos + tripoint( length, 0, 0 ), 0, 0, 0,
+                                           false );
+        REQUIRE( other != nullptr );
+        const auto colls = collisions_moving_east( *veh );
+        REQUIRE( colls.size() == 1 );
+        CHECK( colls[0].type == veh_coll_veh );
+        CHECK( colls[0].target == other );
+    }
+
+    SECTION( "vehicle behind" ) {
+        REQUIRE( g->m.add_vehicle( vproto_id( "car" ), pos - tripoint( length, 0, 0 ), 0, 0, 0,
+                                   false ) != nullptr );
+        CHECK( collisions_moving_east( *veh ).empty() );
+    }
+
+    SECTION( "creatures in front" ) {
+        // The front of the vehicle and a tile it moves into
+        int front = -1;
+        for( size_t i = 0; i < veh->parts.size(); i++ ) {
+            if( veh->parts[i].precalc[0].x == veh->precalc_max[0].x ) {
+                front = i;
+            }
+        }
+        REQUIRE( front >= 0 );
+        const tripoint ahead = pos + veh->parts[front].precalc[0] + tripoint( 1, 0, 0 );
+
+        monster zombie( mtype_id( "mon_zombie" ), ahead );
+        REQUIRE( g->critter_tracker->add( zombie ) );
+        auto colls = collisions_moving_east( *veh );
+        REQUIRE( colls.size() == 1 );
+        CHECK( colls[0].type == veh_coll_body );
+        CHECK( colls[0].target == &g->zombie( 0 ) );
+
+        g->remove_zombie( 0 );
+        g->u.setpos( ahead );
+        colls = collisions_moving_east( *veh );
+        REQUIRE( colls.size() == 1 );
+        CHECK( colls[0].type == veh_coll_body );
+        CHECK( colls[0].target == &g->u );
+    }
+
+    clear_vehicles_and_monsters();
+}
@@ -0,0 +1,83 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "vehicle.h"
+#include "veh_type.h"
+
+#include <vector>
+
+/** The parts with the flag found by looking at every part */
+static std::vector<int> scan_parts_with_flag( const vehicle &veh, vpart_bitflags flag )
+{
+    std::vector<int> res;
+    for( size_t p = 0; p < veh.parts.size(); p++ ) {
+        if( !veh.parts[p].removed && veh.part_info( p ).has_flag( flag ) ) {
+            res.push_back( p );
+        }
+    }
+    return res;
+}
+
+static void check_flag_index( const vehicle &veh )
+{
+    for( int f = 0; f < NUM_VPFLAGS; f++ ) {
+        const vpart_bitflags flag = static_cast<vpart_bitflags>( f );
+        INFO( "flag " << f );
+        CHECK( veh.parts_with_flag( flag ) == scan_parts_with_flag( veh, flag ) );
+
+        for( size_t p = 0; p < veh.parts.size(); p++ ) {
+            int expected = -1;
+            for( const int other : veh.parts_at_relative( veh.parts[p].mount.x, veh.parts[p].mount.y ) ) {
+                if( veh.part_flag( other, flag ) && !veh.parts[other].is_broken() ) {
+                    expected = other;
+                    break;
+                }
+            }
+            if( veh.part_flag( p, flag ) ) {
+                expected = p;
+            }
+            CHECK( veh.part_with_feature( p, flag ) == expected );
+        }
+    }
+}
+
+TEST_CASE( "vehicle_part_flag_index", "[vehicle]" )
+{
+    for( int x = 0; x <= 100; ++x ) {
+        for( int y = 0; y <= 100; ++y ) {
+            g->m.ter_set( x, y, ter_id( "t_grass" ) );
+            g->m.furn_set( x, y, furn_id( "f_null" ) );
+        }
+    }
+    vehicle &veh = *g->m.add_vehicle( vproto_id( "car" ), 50, 50, 270, 0, 0 );
+    REQUIRE_FALSE( veh.parts_with_flag( VPFLAG_ENGINE ).empty() );
+    REQUIRE_FALSE( veh.parts_with_flag( VPFLAG_WHEEL ).empty() );
+    REQUIRE_FALSE( veh.parts_with_flag( VPFLAG_STEERING ).empty() );
+    for( const int p : veh.parts_with_flag( VPFLAG_ENGINE ) ) {
+        CHECK( veh.parts[p].is_engine() );
+    }
+
+    SECTION( "new vehicle" ) {
+        check_flag_index( veh );
+    }
+
+    SECTION( "parts removed" ) {
+        veh.remove_part( veh.parts_with_flag( VPFLAG_WHEEL ).front() );
+        veh.remove_part( veh.parts_with_flag( VPFLAG_OPENABLE ).back() );
+        check_flag_index( veh );
+
+        veh.part_removal_cleanup();
+        check_flag_index( veh );
+    }
+
+    SECTION( "parts broken" ) {
+        const int door = veh.parts_with_flag( VPFLAG_OPENABLE ).front();
+        veh.set_hp( veh.parts[door], 0 );
+        REQUIRE( veh.parts[door].is_broken() );
+        CHECK( veh.parts_with_flag( VPFLAG_OPENABLE ).front() == door );
+        check_flag_index( veh );
+    }
+
+    g->m.destroy_vehicle( &veh );
+}